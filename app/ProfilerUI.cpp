@@ -10,63 +10,321 @@
  * This file contains the implementation of ProfilerUI methods, responsible for:
  *  - Storing frame history
  *  - Aggregating zone statistics
- *  - Rendering a simple ASCII-based profiler view in the terminal
+ *  - Rendering a simple ASCII-based profiler view in the terminal from a
+ *    background reporter thread, one buffered write per refresh
+ *  - Replaying frames from a memory-mapped '.chrono' capture
  *
  * This implementation only exists when compiled with '-DPROFILER'.
  * Otherwise, the header provides a zero-overhead stub implementation.
  */
 
 // ===== Required includes ========================================================== //
+// <algorithm>     - std::max / std::copy for the name column and the history arena   //
+// <chrono>        - Reporter wake-up period and refresh throttling                   //
+// <cstdio>        - std::fwrite of the finished report                               //
 // <mutex>         - Ensures thread-safety when UI reads profiling data               //
 // <iomanip>       - Provides formatting helpers like std::setw and std::setprecision //
 // <iostream>      - Required to print profiler results to terminal                   //
+// <memory>        - std::make_unique for the replay capture                          //
 // <string>        - For converting zone names to std::string                         //
-// <vector>        - Storage container for per-frame event history                    //
+// <thread>        - Reporter thread and its sleep between queue drains               //
+// <vector>        - Event arena and frame slots of the rolling history               //
 // ================================================================================== //
 
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
 #include <mutex>
 #include <iomanip>
 #include <iostream>
+#include <memory>
 #include <string>
+#include <thread>
 #include <vector>
 
+namespace {
+
+/// How often the reporter thread drains the snapshot queue.
+constexpr std::chrono::milliseconds kReporterPollInterval(5);
+
+/**
+ * @brief Recognize the allocation counters reported for a zone.
+ *
+ * @param name  Counter name
+ * @param zone  Receives the zone name for "alloc.count/<zone>" or "alloc.bytes/<zone>"
+ * @param bytes Receives true for the bytes counter
+ * @return False for any other counter
+ */
+bool parseAllocationCounter(std::string_view name, std::string_view& zone, bool& bytes) {
+    bytes = name.starts_with(ChronoProfiler::kAllocBytesPrefix);
+    if (!bytes && !name.starts_with(ChronoProfiler::kAllocCountPrefix))
+        return false;
+    zone = name.substr(bytes ? ChronoProfiler::kAllocBytesPrefix.size()
+                             : ChronoProfiler::kAllocCountPrefix.size());
+    return true;
+}
+
+} // namespace
+
+/**
+ * @brief Construct an empty zone table
+ *
+ * @param windowFrames Sliding-window length for each zone's percentiles
+ */
+ZoneStatsTable::ZoneStatsTable(uint64_t windowFrames)
+    : buckets(64, Bucket{0, kEmpty}), bucketBits(6), windowFrames(windowFrames) {}
+
+/**
+ * @brief Look up a zone by name ID, inserting it if new
+ *
+ * @param nameId Interned zone name
+ * @return The zone's statistics
+ */
+ZoneStats& ZoneStatsTable::at(uint16_t nameId) {
+    const size_t mask = buckets.size() - 1;
+    for (size_t slot = slotFor(nameId, bucketBits);; slot = (slot + 1) & mask) {
+        Bucket& bucket = buckets[slot];
+        if (bucket.index == kEmpty) {
+            // First sighting of this zone
+            if ((entries.size() + 1) * 2 > buckets.size()) {
+                grow();
+                return at(nameId);
+            }
+            bucket = {nameId, static_cast<uint32_t>(entries.size())};
+            entries.push_back({nameId, ZoneStats(windowFrames)});
+            return entries.back().stats;
+        }
+        if (bucket.key == nameId)
+            return entries[bucket.index].stats;
+    }
+}
+
+/**
+ * @brief Double the probe table and reinsert every key
+ */
+void ZoneStatsTable::grow() {
+    ++bucketBits;
+    buckets.assign(size_t{1} << bucketBits, Bucket{0, kEmpty});
+
+    const size_t mask = buckets.size() - 1;
+    for (uint32_t i = 0; i < entries.size(); ++i) {
+        size_t slot = slotFor(entries[i].nameId, bucketBits);
+        while (buckets[slot].index != kEmpty)
+            slot = (slot + 1) & mask;
+        buckets[slot] = {entries[i].nameId, i};
+    }
+}
+
+/**
+ * @brief Construct a frame history with preallocated storage
+ *
+ * @param maxFrames   Number of frame slots (at least 1)
+ * @param arenaEvents Number of events in the shared arena (at least 1)
+ */
+FrameHistory::FrameHistory(size_t maxFrames, size_t arenaEvents)
+    : arena(std::max<size_t>(arenaEvents, 1)),
+      slots(std::max<size_t>(maxFrames, 1)) {}
+
+/**
+ * @brief Copy a frame into the arena, evicting old frames to make room
+ *
+ * @param events Events of the completed frame
+ */
+void FrameHistory::push(std::span<const ChronoProfiler::Event> events) {
+    const uint64_t capacity = arena.size();
+    const uint64_t n = events.size();
+
+    if (n > capacity) {
+        // Rare: one frame outgrew the whole arena. Grow and start over.
+        arena.resize(n);
+        count = 0;
+        writePos = 0;
+        return push(events);
+    }
+
+    // Keep the frame contiguous: skip to the next wrap if it would straddle the end
+    uint64_t start = writePos;
+    if (start % capacity + n > capacity)
+        start += capacity - start % capacity;
+
+    // Evict until the frame fits behind the oldest one and a slot is free
+    while (count > 0 &&
+           (count == slots.size() || start + n - slots[oldest].start > capacity)) {
+        oldest = (oldest + 1) % slots.size();
+        --count;
+    }
+
+    std::copy(events.begin(), events.end(), arena.begin() + start % capacity);
+    slots[(oldest + count) % slots.size()] = {start, static_cast<uint32_t>(n)};
+    ++count;
+    writePos = start + n;
+}
+
 /**
- * @brief Construct a new ProfilerUI object
+ * @brief View one retained frame
  *
- * Allocates storage for the rolling frame history used in UI rendering.
+ * @param age 0 = newest frame
+ * @return Span over the frame's events in the arena
+ */
+std::span<const ChronoProfiler::Event> FrameHistory::recent(size_t age) const {
+    const Slot& slot = slots[(oldest + count - 1 - age) % slots.size()];
+    return {arena.data() + slot.start % arena.size(), slot.count};
+}
+
+/**
+ * @brief Construct a snapshot queue with preallocated slots
  *
- * @param historySize Maximum number of frames to store in rolling history
- *                    (older frames automatically pop off the front)
+ * @param slotCount      Number of frames that can be queued (at least 1)
+ * @param eventsPerFrame Events reserved in every slot
  */
-ProfilerUI::ProfilerUI(size_t historySize)
-    : maxHistory(historySize), totalFrames(0) {
-    frameHistory.reserve(historySize);
+FrameSnapshotQueue::FrameSnapshotQueue(size_t slotCount, size_t eventsPerFrame)
+    : slots(std::max<size_t>(slotCount, 1)) {
+    for (auto& slot : slots)
+        slot.events.reserve(eventsPerFrame);
 }
 
 /**
- * @brief Update the profiler UI with the latest frame events
+ * @brief Copy a frame into the next free slot and publish it
+ *
+ * @param events      Events of the completed frame
+ * @param threadNames Thread names of the completed frame
+ * @return False if every slot is still waiting for the consumer
+ */
+bool FrameSnapshotQueue::push(std::span<const ChronoProfiler::Event> events,
+                              std::span<const ChronoProfiler::ThreadName> threadNames) {
+    const size_t h = head.load(std::memory_order_relaxed);
+    if (h - tail.load(std::memory_order_acquire) == slots.size())
+        return false; // Full: the reporter is behind
+
+    Slot& slot = slots[h % slots.size()];
+    slot.events.assign(events.begin(), events.end());
+    slot.threadNames.assign(threadNames.begin(), threadNames.end());
+    head.store(h + 1, std::memory_order_release); // Publish the copied events
+    return true;
+}
+
+/**
+ * @brief Construct a new ProfilerUI object and start its reporter thread
+ *
+ * Allocates storage for the rolling frame history used in UI rendering and
+ * for the snapshot queue feeding the reporter thread.
+ *
+ * @param historySize     Maximum number of frames to store in rolling history
+ *                        (older frames are overwritten in place)
+ * @param eventsPerFrame  Average events per frame the arena is sized for
+ * @param refreshInterval Minimum time between two terminal refreshes
+ *
+ * The sliding-window percentiles cover the same number of frames as the
+ * history.
+ */
+ProfilerUI::ProfilerUI(size_t historySize, size_t eventsPerFrame,
+                       std::chrono::milliseconds refreshInterval)
+    : frameHistory(historySize, historySize * eventsPerFrame),
+      statsWindowFrames(std::max<size_t>(historySize, 1)),
+      aggregatedStats(statsWindowFrames),
+      snapshots(kSnapshotQueueFrames, eventsPerFrame),
+      refreshInterval(refreshInterval), totalFrames(0),
+      reporter(&ProfilerUI::reporterLoop, this) {}
+
+/**
+ * @brief Stop the reporter thread
+ *
+ * Frames already queued are folded in and a pending refresh is printed
+ * before the thread exits.
+ */
+ProfilerUI::~ProfilerUI() {
+    stopReporter.store(true, std::memory_order_release);
+    reporter.join();
+}
+
+/**
+ * @brief Queue the latest frame events for the reporter thread
  *
  * This function should be called **once per frame**, immediately after
- * 'ChronoProfiler::endFrame()'. It:
- *  - Retrieves merged event data for the most recent frame
- *  - Stores a copy into rolling history
- *  - Manages max history size
- *  - Updates aggregated statistics for zone durations
+ * 'ChronoProfiler::endFrame()'. It only copies the merged events into the
+ * snapshot queue; history, statistics and output are handled by the
+ * reporter thread.
  */
 void ProfilerUI::update() {
-    std::lock_guard<std::mutex> lock(uiMutex);  ///< Ensure thread safety
+    if (!snapshots.push(ChronoProfiler::getEvents(), ChronoProfiler::getThreadNames()))
+        droppedSnapshots.fetch_add(1, std::memory_order_relaxed);
+}
+
+/**
+ * @brief Request a terminal refresh
+ *
+ * Never blocks: the reporter thread prints the newest frame at its next
+ * refresh slot. See formatReport() for the layout.
+ */
+void ProfilerUI::render() {
+    refreshRequested.store(true, std::memory_order_release);
+}
+
+/**
+ * @brief Reporter thread: drain snapshots and print throttled refreshes
+ */
+void ProfilerUI::reporterLoop() {
+    using Clock = std::chrono::steady_clock;
+    Clock::time_point lastRefresh = Clock::now() - refreshInterval;
 
-    const auto& events = ChronoProfiler::getEvents(); ///< Profiler provides merged events
+    for (;;) {
+        // Read the stop flag first so the final drain sees every pushed frame
+        const bool stopping = stopReporter.load(std::memory_order_acquire);
 
-    frameHistory.push_back(events);
+        {
+            std::lock_guard<std::mutex> lock(uiMutex);
+            snapshots.drain([this](std::span<const ChronoProfiler::Event> events,
+                                   std::span<const ChronoProfiler::ThreadName> threadNames) {
+                ingest(events, threadNames);
+            });
 
-    if (frameHistory.size() > maxHistory) {
-        frameHistory.erase(frameHistory.begin()); ///< Drop oldest frame
+            const Clock::time_point now = Clock::now();
+            if ((stopping || now - lastRefresh >= refreshInterval) &&
+                refreshRequested.exchange(false, std::memory_order_acq_rel)) {
+                formatReport();
+                writeReport();
+                lastRefresh = now;
+            }
+        }
+
+        if (stopping)
+            return;
+        std::this_thread::sleep_for(kReporterPollInterval);
     }
+}
 
-    // Aggregate stats per named profiling zone
-    for (const auto& e : events) {
-        aggregatedStats[std::string(e.name)].add(e.durationMs);
+/**
+ * @brief Fold one frame into the history and the zone statistics
+ *
+ * @param events      Merged events of one frame
+ * @param threadNames Names of the frame's threads when it was merged
+ */
+void ProfilerUI::ingest(std::span<const ChronoProfiler::Event> events,
+                        std::span<const ChronoProfiler::ThreadName> threadNames) {
+    frameHistory.push(events); ///< Copy into the preallocated arena
+    latestThreadNames.assign(threadNames.begin(), threadNames.end());
+
+    // Aggregate stats per named profiling zone (keyed by ID: no string copies)
+    ChronoProfiler::computeSelfTicks(events, selfTicks);
+    for (size_t i = 0; i < events.size(); ++i) {
+        const auto& e = events[i];
+        if (e.isValue()) {
+            // Counter samples are shown per frame; only allocations are aggregated
+            std::string_view zone;
+            bool bytes = false;
+            if ((e.flags & ChronoProfiler::Event::kFlagCounter) &&
+                parseAllocationCounter(ChronoProfiler::getString(e.nameId), zone, bytes)) {
+                AllocationStats& allocs = allocationStats[zone];
+                const uint64_t value = static_cast<uint64_t>(e.value());
+                if (bytes)
+                    allocs.addBytes(value);
+                else
+                    allocs.addCount(value);
+            }
+            continue;
+        }
+        aggregatedStats.at(e.nameId)
+            .add(e.durationMs(), ChronoProfiler::ticksToMs(selfTicks[i]), totalFrames);
     }
 
     // increment total frames
@@ -74,36 +332,69 @@ void ProfilerUI::update() {
 }
 
 /**
- * @brief Render profiler result summary and latest frame visualization
+ * @brief Format profiler result summary and latest frame visualization
  *
  * Produces terminal output such as:
  *
  * '''
  * === Frame 140 ===
- * updateScene        ████████████ 1.52 ms [MainThread]
- * drawFrame          ████████████████████████ 3.40 ms [RenderThread]
+ * drawFrame()          ██████████████████████████ 3.40 ms (self 1.88 ms) [MainThread]
+ *   updateScene        ███████████████ 1.52 ms (self 1.52 ms) [MainThread]
+ * -- GPU --
+ * GPU Frame            ████████ 0.81 ms (self 0.12 ms) [GPU]
+ *   Main Pass          ███████ 0.69 ms (self 0.69 ms) [GPU]
+ * -- Counters --
+ * vk.drawCalls         1
+ * vk.stagingBytes      0
  *
  * -- Aggregated Stats --
- * Zone                 Avg(ms)    Max(ms)    Count
- * updateScene          1.50       2.02        140
- * drawFrame            3.38       4.02        140
+ * Zone                Avg(ms)   Self(ms)  p50(ms)   p95(ms)   p99(ms)   StdDev    Max(ms)   Count
+ * drawFrame()         3.38      1.86      3.35      3.71      3.96      0.14      4.02      140
+ * updateScene         1.50      1.50      1.49      1.66      1.93      0.09      2.02      140
+ *
+ * -- Last 60 Frames --
+ * Zone                Avg(ms)   p50(ms)   p95(ms)   p99(ms)   StdDev    Max(ms)   Count
+ * drawFrame()         3.41      3.38      3.80      3.96      0.15      3.98      52
+ * updateScene         1.52      1.51      1.70      1.93      0.10      1.94      52
  * '''
  */
-void ProfilerUI::render() {
-    std::lock_guard<std::mutex> lock(uiMutex);  // Ensure UI rendering is thread-safe
-
+void ProfilerUI::formatReport() {
     size_t frameIndex = totalFrames; ///< Use absolute frame count
 
-    // Print current frame header
-    std::cout << "\r=== Frame " << frameIndex << " ===\n" << std::flush;
+    // Current frame header
+    report << "\r=== Frame " << frameIndex << " ===\n";
 
     // Render most recent frame's events (if available)
     if (!frameHistory.empty()) {
-        renderFrame(frameHistory.back(), frameIndex);
+        renderFrame(frameHistory.recent(0), frameIndex);
     }
 
     // Display aggregated timing statistics
     renderAggregatedStats();
+
+    // Display heap allocations per zone (allocation tracking only)
+    renderAllocationStats();
+
+    // Warn about incomplete timelines
+    renderOverflow();
+
+    const uint64_t dropped = droppedSnapshots.load(std::memory_order_relaxed);
+    if (dropped > 0)
+        report << "\n(" << dropped << " frames skipped: reporter queue full)\n";
+}
+
+/**
+ * @brief Write the formatted report to stdout with a single call
+ *
+ * Anything still buffered in std::cout is flushed first so interleaved
+ * messages from the application keep their order.
+ */
+void ProfilerUI::writeReport() {
+    const std::string_view text = report.view();
+    std::cout.flush();
+    std::fwrite(text.data(), 1, text.size(), stdout);
+    std::fflush(stdout);
+    report.str({}); // Clear; the next refresh formats into the same stream
 }
 
 /**
@@ -112,25 +403,140 @@ void ProfilerUI::render() {
  * @param events      Collection of profiling events for the frame
  * @param frameIndex  Absolute frame number (only used for labeling)
  */
-void ProfilerUI::renderFrame(const std::vector<ChronoProfiler::Event>& events,
+void ProfilerUI::renderFrame(std::span<const ChronoProfiler::Event> events,
                              size_t frameIndex) {
+    renderEvents(events, nullptr);
+}
 
-    // Loop through all events recorded for this frame
-    for (const auto& e : events) {
-        int barLength = static_cast<int>(e.durationMs * 10); ///< Scale duration into bar length
+/**
+ * @brief Render frame N of the open replay capture
+ *
+ * @param frameNumber Zero-based frame position in the capture
+ */
+void ProfilerUI::renderFrame(size_t frameNumber) {
+    std::lock_guard<std::mutex> lock(uiMutex);
 
-        // Print event name, left-aligned
-        std::cout << std::setw(20) << std::left << e.name << " ";
+    if (!replayReader) {
+        report << "No replay capture open\n";
+        writeReport();
+        return;
+    }
+
+    try {
+        if (!replayReader->readFrame(frameNumber, replayFrame)) {
+            report << "Replay frame " << frameNumber << " is past the end of the capture\n";
+            writeReport();
+            return;
+        }
+    } catch (const std::exception& e) {
+        std::cerr << "Replay frame " << frameNumber << ": " << e.what() << std::endl;
+        return;
+    }
+
+    // Position in the file and the profiler's own frame number (differ after drops)
+    report << "=== Replay Frame " << frameNumber
+           << " (captured #" << replayFrame.index << ") ===\n";
+    renderEvents(replayFrame.events, replayReader.get());
+    writeReport();
+}
+
+/**
+ * @brief Open a '.chrono' capture for replay
+ *
+ * @param path Capture file path
+ * @return True if the capture was mapped and its header is valid
+ */
+bool ProfilerUI::openReplay(const std::string& path) {
+    std::lock_guard<std::mutex> lock(uiMutex);
+
+    try {
+        auto file = std::make_unique<chronocap::MappedFile>(path);
+        auto reader = std::make_unique<chronocap::CaptureReader>(file->bytes());
+        replayReader = std::move(reader);
+        replayFile = std::move(file);
+    } catch (const std::exception& e) {
+        std::cerr << "ProfilerUI: cannot replay " << path << ": " << e.what() << std::endl;
+        return false;
+    }
+    return true;
+}
+
+/**
+ * @brief Count the frames of the open replay capture
+ *
+ * @return Number of complete frames, or 0 without a capture
+ */
+size_t ProfilerUI::replayFrameCount() {
+    std::lock_guard<std::mutex> lock(uiMutex);
+    return replayReader ? replayReader->frameCount() : 0;
+}
+
+/**
+ * @brief Print one ASCII bar per event
+ *
+ * @param events  Events of one frame (parents precede children)
+ * @param capture Replay capture for names and tick conversion, or nullptr to
+ *                use the live profiler's string table and clock
+ */
+void ProfilerUI::renderEvents(std::span<const ChronoProfiler::Event> events,
+                              const chronocap::CaptureReader* capture) {
+
+    ChronoProfiler::computeSelfTicks(events, selfTicks);
+
+    auto toMs = [capture](uint64_t ticks) {
+        return capture ? capture->ticksToMs(static_cast<int64_t>(ticks))
+                       : ChronoProfiler::ticksToMs(ticks);
+    };
+    bool countersHeader = false; ///< "-- Counters --" printed for this frame
+
+    // Loop through all events recorded for this frame (parents precede children)
+    for (size_t i = 0; i < events.size(); ++i) {
+        const auto& e = events[i];
+
+        // GPU zones follow the CPU threads; give them their own track header
+        if (e.threadId == ChronoProfiler::kGpuThreadId &&
+            (i == 0 || events[i - 1].threadId != ChronoProfiler::kGpuThreadId))
+            report << "-- GPU --\n";
+
+        // Counter and gauge samples come last: one value per line, no bar
+        if (e.isValue()) {
+            const std::string_view name = capture ? capture->getString(e.nameId)
+                                                  : ChronoProfiler::getString(e.nameId);
+            std::string_view zone;
+            bool bytes = false;
+            if (parseAllocationCounter(name, zone, bytes))
+                continue; // Shown in the allocation table instead
+            if (!countersHeader) {
+                report << "-- Counters --\n";
+                countersHeader = true;
+            }
+            report << std::setw(20) << std::left << name
+                   << " " << std::defaultfloat << std::setprecision(12) << e.value() << "\n";
+            continue;
+        }
+
+        const double durationMs = toMs(e.endTicks - e.startTicks);  ///< Convert ticks once
+        int barLength = static_cast<int>(durationMs * 10);          ///< Scale duration into bar length
+        int indent = static_cast<int>(e.depth) * 2;                 ///< Two spaces per nesting level
+
+        // Print event name indented by nesting depth, left-aligned
+        report << std::string(indent, ' ')
+                  << std::setw(std::max(20 - indent, 1)) << std::left
+                  << (capture ? capture->getString(e.nameId)
+                              : ChronoProfiler::getString(e.nameId)) << " ";
 
         // Draw simple ASCII bar visualization of duration
-        for (int i = 0; i < barLength; ++i)
-            std::cout << "█";
+        for (int b = 0; b < barLength; ++b)
+            report << "█";
 
-        // Print duration and thread name
-        std::cout << " "
+        // Print inclusive and self duration, then thread name
+        report << " "
                   << std::fixed << std::setprecision(2)
-                  << e.durationMs << " ms"
-                  << " [" << ChronoProfiler::getThreadName(e.threadId) << "]\n";
+                  << durationMs << " ms"
+                  << " (self " << toMs(selfTicks[i]) << " ms)"
+                  << " [" << (capture ? capture->getThreadName(e.threadId)
+                                      : ChronoProfiler::findThreadName(latestThreadNames,
+                                                                       e.threadId)) << "]\n";
     }
 }
 
@@ -139,26 +545,126 @@ void ProfilerUI::renderFrame(const std::vector<ChronoProfiler::Event>& events,
  *
  * Outputs a compact table displaying:
  *  - Zone name
- *  - Average duration
+ *  - Average inclusive duration
+ *  - Average exclusive (self) duration
+ *  - Inclusive p50 / p95 / p99 and standard deviation
  *  - Maximum duration
  *  - Count of occurrences
+ *
+ * followed by the same percentiles over the last N frames (N = history size),
+ * which is what frame-time budgets are usually checked against.
  */
 void ProfilerUI::renderAggregatedStats() {
-    std::cout << "\n-- Aggregated Stats --\n";
+    report << "\n-- Aggregated Stats --\n";
 
     // Print table header (column labels)
-    std::cout << std::setw(20) << "Zone"
+    report << std::setw(20) << "Zone"
               << std::setw(10) << "Avg(ms)"
+              << std::setw(10) << "Self(ms)"
+              << std::setw(10) << "p50(ms)"
+              << std::setw(10) << "p95(ms)"
+              << std::setw(10) << "p99(ms)"
+              << std::setw(10) << "StdDev"
               << std::setw(10) << "Max(ms)"
-              << std::setw(10) << "Count\n";
+              << std::setw(10) << "Count" << "\n";
 
     // Iterate over aggregated stats and print each profiling zone's data
-    for (const auto& [name, stats] : aggregatedStats) {
-        std::cout << std::setw(20) << name
+    for (const auto& [nameId, stats] : aggregatedStats) {
+        const LogHistogram& h = stats.histogram;
+        report << std::setw(20) << ChronoProfiler::getString(nameId)
                   << std::setw(10) << std::fixed << std::setprecision(2) << stats.avg()
+                  << std::setw(10) << stats.avgSelf()
+                  << std::setw(10) << h.quantile(0.50)
+                  << std::setw(10) << h.quantile(0.95)
+                  << std::setw(10) << h.quantile(0.99)
+                  << std::setw(10) << h.stddev()
                   << std::setw(10) << stats.maxMs
                   << std::setw(10) << stats.count << "\n";
     }
+
+    report << "\n-- Last " << statsWindowFrames << " Frames --\n";
+    report << std::setw(20) << "Zone"
+              << std::setw(10) << "Avg(ms)"
+              << std::setw(10) << "p50(ms)"
+              << std::setw(10) << "p95(ms)"
+              << std::setw(10) << "p99(ms)"
+              << std::setw(10) << "StdDev"
+              << std::setw(10) << "Max(ms)"
+              << std::setw(10) << "Count" << "\n";
+
+    for (auto& [nameId, stats] : aggregatedStats) {
+        const LogHistogram& h = stats.recent.window(totalFrames);
+        if (h.count() == 0)
+            continue; // Zone not seen in the window
+
+        report << std::setw(20) << ChronoProfiler::getString(nameId)
+                  << std::setw(10) << h.mean()
+                  << std::setw(10) << h.quantile(0.50)
+                  << std::setw(10) << h.quantile(0.95)
+                  << std::setw(10) << h.quantile(0.99)
+                  << std::setw(10) << h.stddev()
+                  << std::setw(10) << h.max()
+                  << std::setw(10) << h.count() << "\n";
+    }
+}
+
+/**
+ * @brief Render heap allocations charged to each zone
+ *
+ * Prints nothing unless allocation tracking reported at least one zone:
+ *
+ * '''
+ * -- Allocations --
+ * Zone                Allocs    Avg       Max       Bytes     AvgBytes
+ * drawFrame()         0         0.02      3         0         4.13
+ * updateScene         2         2.00      2         96        96.00
+ * '''
+ *
+ * 'Allocs' and 'Bytes' are the newest frame; averages are per frame.
+ */
+void ProfilerUI::renderAllocationStats() {
+    if (allocationStats.empty())
+        return;
+
+    report << "\n-- Allocations --\n";
+    report << std::setw(20) << "Zone"
+              << std::setw(10) << "Allocs"
+              << std::setw(10) << "Avg"
+              << std::setw(10) << "Max"
+              << std::setw(10) << "Bytes"
+              << std::setw(10) << "AvgBytes" << "\n";
+
+    for (const auto& [zone, allocs] : allocationStats) {
+        report << std::setw(20) << zone
+                  << std::setw(10) << allocs.lastCount
+                  << std::setw(10) << std::fixed << std::setprecision(2) << allocs.avgCount()
+                  << std::setw(10) << allocs.maxCount
+                  << std::setw(10) << allocs.lastBytes
+                  << std::setw(10) << allocs.avgBytes() << "\n";
+    }
+}
+
+/**
+ * @brief Render dropped event counters for threads whose ring overflowed
+ *
+ * Prints nothing when every thread kept all of its events.
+ */
+void ProfilerUI::renderOverflow() {
+    bool headerPrinted = false;
+
+    for (const auto& overflow : ChronoProfiler::getOverflowCounts()) {
+        if (overflow.dropped == 0)
+            continue;
+
+        if (!headerPrinted) {
+            report << "\n-- Dropped Events --\n";
+            headerPrinted = true;
+        }
+
+        report << std::setw(20) << std::left
+                  << ChronoProfiler::getThreadName(overflow.threadId)
+                  << std::setw(10) << overflow.dropped << "\n";
+    }
 }
 
 #endif // PROFILER
\ No newline at end of file
@@ -8,6 +8,9 @@
  *  - maintains a rolling history of frames,
  *  - prints a per-frame breakdown as ASCII bars,
  *  - accumulates aggregated statistics (avg/max/count) per zone,
+ *  - replays frames from a saved '.chrono' capture by frame number,
+ *  - does all aggregation, formatting and terminal output on a background
+ *    reporter thread, so the frame being measured never waits on I/O,
  *  - exposes a no-op implementation when the profiler is disabled so call
  *    sites can remain free of '#ifdef' guards.
  *
@@ -38,55 +41,330 @@
 // - Must be included so the UI can read the per-frame event list.
 #include <ChronoProfiler.hpp>
 
+// ChronoCapture.hpp
+// - Provides the memory-mapped capture reader used by the replay mode.
+#include <ChronoCapture.hpp>
+
+// LogHistogram.hpp
+// - Bounded-memory histograms behind the per-zone percentile columns.
+#include <LogHistogram.hpp>
+
 // Standard-library includes with comments explaining why they're needed.
 //
-// <vector>         : store rolling frame history (vector< vector<Event> >)
+// <vector>         : event arena and frame slots of the rolling history
+// <span>           : read-only views of frames stored in the arena
 // <string>         : keys for aggregatedStats and zone names
-// <unordered_map>  : mapping zone name -> ZoneStats for O(1) lookups
 // <mutex>          : protect update()/render() from multi-threaded access
 // <iostream>       : print ASCII UI to stdout/stderr
 // <iomanip>        : formatting width, precision for table columns
 // <cstdint>        : fixed-size integer aliases (uint32_t) used by events
+// <memory>         : owns the optional replay capture
+// <atomic>         : lock-free snapshot queue indices and reporter flags
+// <chrono>         : refresh interval of the reporter thread
+// <sstream>        : report buffer written to the terminal in one call
+// <thread>         : background reporter thread
+// <map>            : per-zone allocation stats, printed in name order
+// <string_view>    : allocation stats keyed by interned zone names
 #include <vector>         // rolling history container
+#include <span>           // frame views into the history arena
 #include <string>         // zone names, thread names
-#include <unordered_map>  // aggregate stats map
 #include <mutex>          // thread-safety for update/render
 #include <iostream>       // console output
 #include <iomanip>        // formatting numeric/column widths
 #include <cstdint>        // integer typedefs
+#include <memory>         // replay capture ownership
+#include <atomic>         // snapshot queue indices, reporter flags
+#include <chrono>         // refresh interval
+#include <sstream>        // buffered report text
+#include <thread>         // reporter thread
+#include <map>            // allocation stats by zone name
+#include <string_view>    // interned zone names
 
 /**
  * @struct ZoneStats
  * @brief Aggregated statistics for a given profiling zone.
  *
  * ZoneStats collects incremental statistics for a zone across multiple
- * frames. It is intentionally simple: it accumulates total time, tracks the
- * maximum observed sample, and counts samples so callers can compute averages.
+ * frames. It accumulates inclusive and exclusive (self) time, tracks the
+ * maximum observed sample, and counts samples so callers can compute
+ * averages. Inclusive durations also feed two log-bucketed histograms: one
+ * over all frames and one over a sliding window of recent frames, from which
+ * tail percentiles (p50/p95/p99) and the standard deviation are read.
+ *
+ * Memory per zone is fixed (a handful of ~2.4 KiB histograms) regardless of
+ * how many samples are recorded.
  *
  * @note All times are expressed in milliseconds.
  */
 struct ZoneStats {
-    double totalMs = 0.0; ///< Total accumulated duration (ms)
-    double maxMs   = 0.0; ///< Maximum single-sample duration (ms)
+    double totalMs = 0.0; ///< Total accumulated inclusive duration (ms)
+    double selfMs  = 0.0; ///< Total accumulated exclusive duration (ms)
+    double maxMs   = 0.0; ///< Maximum single-sample inclusive duration (ms)
     size_t count   = 0;   ///< Number of samples observed
 
+    LogHistogram histogram;   ///< All-time inclusive durations
+    WindowedHistogram recent; ///< Inclusive durations over the last N frames
+
+    /**
+     * @brief Create empty statistics.
+     * @param windowFrames Length of the sliding window in frames.
+     */
+    explicit ZoneStats(uint64_t windowFrames = 600) : recent(windowFrames) {}
+
     /**
      * @brief Add a single duration sample to the statistics.
-     * @param duration Duration of a zone sample in milliseconds.
+     * @param duration Inclusive duration of a zone sample in milliseconds.
+     * @param self Exclusive duration of the same sample in milliseconds.
+     * @param frame Absolute frame number the sample belongs to.
      *
-     * This method updates the running total, maximum, and increments the sample count.
+     * This method updates the running totals, maximum, histograms, and
+     * increments the sample count.
      */
-    void add(double duration) {
+    void add(double duration, double self, uint64_t frame) {
         totalMs += duration;
+        selfMs += self;
         if (duration > maxMs) maxMs = duration;
         ++count;
+        histogram.add(duration);
+        recent.add(duration, frame);
     }
 
     /**
-     * @brief Compute the arithmetic mean (average) duration.
+     * @brief Compute the arithmetic mean (average) inclusive duration.
      * @return Average duration in milliseconds (0.0 if count == 0).
      */
     double avg() const { return count ? totalMs / static_cast<double>(count) : 0.0; }
+
+    /**
+     * @brief Compute the average exclusive (self) duration.
+     * @return Average self time in milliseconds (0.0 if count == 0).
+     */
+    double avgSelf() const { return count ? selfMs / static_cast<double>(count) : 0.0; }
+};
+
+/**
+ * @struct AllocationStats
+ * @brief Heap allocations charged to one zone, accumulated over frames.
+ *
+ * Fed from the "alloc.count/<zone>" and "alloc.bytes/<zone>" counters that
+ * ChronoProfiler reports while allocation tracking is enabled (see
+ * ChronoProfiler::setAllocationTracking()). Once a zone has allocated, its
+ * counters report every frame, so averages are per frame.
+ */
+struct AllocationStats {
+    uint64_t lastCount = 0;  ///< Allocations in the newest frame
+    uint64_t lastBytes = 0;  ///< Bytes in the newest frame
+    uint64_t totalCount = 0; ///< Allocations over all frames
+    uint64_t totalBytes = 0; ///< Bytes over all frames
+    uint64_t maxCount = 0;   ///< Most allocations in a single frame
+    uint64_t frames = 0;     ///< Frames with a count sample
+
+    /** @brief Record a frame's allocation count. */
+    void addCount(uint64_t count) {
+        lastCount = count;
+        totalCount += count;
+        if (count > maxCount) maxCount = count;
+        ++frames;
+    }
+
+    /** @brief Record a frame's allocated bytes. */
+    void addBytes(uint64_t bytes) {
+        lastBytes = bytes;
+        totalBytes += bytes;
+    }
+
+    /** @brief Average allocations per frame. */
+    double avgCount() const { return frames ? static_cast<double>(totalCount) / static_cast<double>(frames) : 0.0; }
+
+    /** @brief Average bytes per frame. */
+    double avgBytes() const { return frames ? static_cast<double>(totalBytes) / static_cast<double>(frames) : 0.0; }
+};
+
+/**
+ * @class ZoneStatsTable
+ * @brief Flat open-addressing map from interned zone name ID to ZoneStats.
+ *
+ * Lookups hash the 16-bit ID (Fibonacci hashing) into a power-of-two array of
+ * small {key, index} buckets and probe linearly, so a hit touches one or two
+ * cache lines and never hashes or copies a string. The ZoneStats themselves
+ * live densely in insertion order, which is also the iteration order.
+ *
+ * The bucket array is kept at most half full and only grows when a zone is
+ * seen for the first time; aggregating a frame whose zones are all known
+ * performs no allocation.
+ */
+class ZoneStatsTable {
+public:
+    /** @brief One aggregated zone. */
+    struct Entry {
+        uint16_t nameId; ///< Interned zone name
+        ZoneStats stats; ///< Aggregated statistics
+    };
+
+    /**
+     * @brief Create an empty table.
+     * @param windowFrames Sliding-window length passed to every new ZoneStats.
+     */
+    explicit ZoneStatsTable(uint64_t windowFrames);
+
+    /**
+     * @brief Find the stats for a zone, inserting empty stats on first use.
+     * @param nameId Interned zone name.
+     * @return Reference valid until the next insertion.
+     */
+    ZoneStats& at(uint16_t nameId);
+
+    /** @brief Number of distinct zones. */
+    size_t size() const { return entries.size(); }
+
+    std::vector<Entry>::iterator begin() { return entries.begin(); }
+    std::vector<Entry>::iterator end() { return entries.end(); }
+    std::vector<Entry>::const_iterator begin() const { return entries.begin(); }
+    std::vector<Entry>::const_iterator end() const { return entries.end(); }
+
+private:
+    /** @brief Open-addressing slot; 'index == kEmpty' marks a free slot. */
+    struct Bucket {
+        uint16_t key;   ///< Zone name ID
+        uint32_t index; ///< Position in 'entries'
+    };
+
+    static constexpr uint32_t kEmpty = UINT32_MAX; ///< Free-slot marker
+
+    /** @brief Home slot of a key in a table of 2^bits buckets. */
+    static size_t slotFor(uint16_t key, unsigned bits) {
+        return static_cast<size_t>((key * 0x9E3779B1u) >> (32 - bits));
+    }
+
+    /** @brief Double the bucket array and reinsert all keys. */
+    void grow();
+
+    std::vector<Bucket> buckets;  ///< Power-of-two probe table
+    unsigned bucketBits;          ///< log2(buckets.size())
+    std::vector<Entry> entries;   ///< Dense stats in insertion order
+    uint64_t windowFrames;        ///< Window length for new ZoneStats
+};
+
+/**
+ * @class FrameHistory
+ * @brief Fixed-capacity ring of recent frames stored in one contiguous event arena.
+ *
+ * Every frame is copied into a preallocated arena of 'ChronoProfiler::Event'
+ * records and described by an (offset, length) slot in a second ring. Both
+ * rings are sized once, so pushing a frame in steady state is a single
+ * contiguous copy with no heap allocation, and dropping the oldest frame only
+ * advances an index.
+ *
+ * Positions in the arena are tracked as monotonically increasing virtual
+ * offsets; the physical offset is 'virtual % arena size'. A frame that would
+ * straddle the end of the arena is started at the next wrap boundary instead,
+ * so each frame stays contiguous and can be returned as a 'std::span'.
+ *
+ * The history holds at most 'maxFrames' frames, and fewer when the frames
+ * together exceed the arena (oldest frames are evicted first). A single frame
+ * larger than the whole arena grows the arena and clears the history; this is
+ * the only allocation after construction.
+ */
+class FrameHistory {
+public:
+    /**
+     * @brief Preallocate the frame slots and the event arena.
+     * @param maxFrames Maximum number of frames retained.
+     * @param arenaEvents Capacity of the shared event arena, in events.
+     */
+    FrameHistory(size_t maxFrames, size_t arenaEvents);
+
+    /**
+     * @brief Append a frame, evicting the oldest frames as needed.
+     * @param events Events of the completed frame.
+     */
+    void push(std::span<const ChronoProfiler::Event> events);
+
+    /** @brief Number of frames currently retained. */
+    size_t size() const { return count; }
+
+    /** @brief True if no frame has been retained yet. */
+    bool empty() const { return count == 0; }
+
+    /**
+     * @brief Access a retained frame.
+     * @param age 0 for the newest frame, size() - 1 for the oldest.
+     * @return View of the frame's events (valid until the next push()).
+     */
+    std::span<const ChronoProfiler::Event> recent(size_t age) const;
+
+private:
+    /** @brief Location of one frame in the arena. */
+    struct Slot {
+        uint64_t start; ///< Virtual arena offset of the first event
+        uint32_t count; ///< Number of events
+    };
+
+    std::vector<ChronoProfiler::Event> arena; ///< Contiguous event storage
+    std::vector<Slot> slots;                  ///< Frame ring ('maxFrames' entries)
+    size_t oldest = 0;                        ///< Slot index of the oldest frame
+    size_t count = 0;                         ///< Frames currently retained
+    uint64_t writePos = 0;                    ///< Virtual offset for the next frame
+};
+
+/**
+ * @class FrameSnapshotQueue
+ * @brief Bounded single-producer/single-consumer queue of frame snapshots.
+ *
+ * The frame thread copies a frame's events and thread names into the next
+ * free slot and publishes it with a release store; the reporter thread
+ * consumes slots in order and releases each one as soon as it has been
+ * processed. Neither side ever takes a lock, and a full queue makes push()
+ * fail instead of blocking.
+ *
+ * Every slot keeps its vectors (and capacity) for the lifetime of the queue,
+ * so once slots have grown to the largest frame, pushing does not allocate.
+ */
+class FrameSnapshotQueue {
+public:
+    /**
+     * @brief Preallocate the slots.
+     * @param slotCount Number of frames that can be queued (at least 1).
+     * @param eventsPerFrame Events reserved per slot.
+     */
+    FrameSnapshotQueue(size_t slotCount, size_t eventsPerFrame);
+
+    /**
+     * @brief Producer side: copy a frame into the queue.
+     * @param events Frame events to copy.
+     * @param threadNames Thread names of the frame to copy.
+     * @return False if the queue is full (the frame is not queued).
+     */
+    bool push(std::span<const ChronoProfiler::Event> events,
+              std::span<const ChronoProfiler::ThreadName> threadNames);
+
+    /**
+     * @brief Consumer side: hand every queued frame to fn, oldest first.
+     * @param fn Callable taking std::span<const ChronoProfiler::Event> and
+     *           std::span<const ChronoProfiler::ThreadName>.
+     */
+    template <typename Fn>
+    void drain(Fn&& fn) {
+        size_t t = tail.load(std::memory_order_relaxed);
+        const size_t h = head.load(std::memory_order_acquire);
+        for (; t != h; ++t) {
+            const Slot& slot = slots[t % slots.size()];
+            fn(std::span<const ChronoProfiler::Event>(slot.events),
+               std::span<const ChronoProfiler::ThreadName>(slot.threadNames));
+            tail.store(t + 1, std::memory_order_release); // Free the slot right away
+        }
+    }
+
+private:
+    /** @brief One queued frame. */
+    struct Slot {
+        std::vector<ChronoProfiler::Event> events;           ///< Merged events
+        std::vector<ChronoProfiler::ThreadName> threadNames; ///< Names at merge time
+    };
+
+    std::vector<Slot> slots; ///< Snapshot storage
+    alignas(64) std::atomic<size_t> head{0}; ///< Next slot to fill (producer)
+    alignas(64) std::atomic<size_t> tail{0}; ///< Next slot to read (consumer)
 };
 
 /**
@@ -102,19 +380,27 @@ struct ZoneStats {
  * @code
  * ProfilerUI profilerUI(60);          // keep last 60 frames
  * // in render loop, after ChronoProfiler::endFrame()
- * profilerUI.update();
- * profilerUI.render();
+ * profilerUI.update();                // copy the frame into the snapshot queue
+ * profilerUI.render();                // request a refresh (never blocks)
  * @endcode
  *
+ * @par Reporter thread
+ * The calling thread only copies the frame into a FrameSnapshotQueue and
+ * sets a flag. A reporter thread owned by the UI drains the queue into the
+ * history and statistics, and at most once per refresh interval formats the
+ * whole report into a memory buffer and writes it to stdout in a single call.
+ * Terminal speed therefore never shows up in the measured frame times. If the
+ * reporter falls behind, snapshots are dropped (and counted in the report)
+ * rather than stalling the frame.
+ *
  * @par Thread-safety
- * Methods 'update()' and 'render()' are internally synchronized with
- * a 'std::mutex' ('uiMutex') so they may be called from different
- * threads as long as the calls themselves follow the profiler lifecycle
- * (i.e. update() after endFrame()).
+ * 'update()' must be called from one thread at a time (it is the queue's
+ * single producer); 'render()' may be called from any thread. The replay
+ * methods share 'uiMutex' with the reporter thread.
  *
  * @par Design decisions
- * - Aggregated stats are cumulative (all-time). If you prefer sliding-window
- *   aggregation, change 'aggregatedStats' maintenance in 'update()'.
+ * - Aggregated stats are reported twice: cumulative (all-time) and over a
+ *   sliding window as long as the frame history.
  * - ASCII bars are scaled by duration; consider dynamic scaling for large
  *   variance (enhancement suggestions below).
  *
@@ -125,102 +411,243 @@ public:
     /**
      * @brief Construct a ProfilerUI object.
      * @param historySize Maximum number of frames to retain in the rolling history (default 60).
+     * @param eventsPerFrame Average events per frame the history arena is sized for
+     *                       (default 256, i.e. 8 KiB of arena per frame).
+     * @param refreshInterval Minimum time between two terminal refreshes.
      *
      * The history size bounds memory usage of the UI and controls how many
-     * frames back the mini-history will allow you to inspect.
+     * frames back the mini-history will allow you to inspect. All history
+     * storage ('historySize * eventsPerFrame' events) is allocated here, so
+     * sizes in the thousands of frames are fine. The reporter thread is
+     * started here.
      */
-    explicit ProfilerUI(size_t historySize = 60);
+    explicit ProfilerUI(size_t historySize = 60, size_t eventsPerFrame = 256,
+                        std::chrono::milliseconds refreshInterval = std::chrono::milliseconds(100));
+
+    /** @brief Stop the reporter thread after printing any pending refresh. */
+    ~ProfilerUI();
+
+    ProfilerUI(const ProfilerUI&) = delete;
+    ProfilerUI& operator=(const ProfilerUI&) = delete;
+
+    /** @brief Frames the snapshot queue can hold before update() drops frames. */
+    static constexpr size_t kSnapshotQueueFrames = 64;
 
     /**
-     * @brief Pull the latest frame events from ChronoProfiler and update internal state.
+     * @brief Hand the latest frame events to the reporter thread.
      *
      * This must be called after 'ChronoProfiler::endFrame()' (or when using RAII,
      * after the 'ScopedFrame' destructor runs) so that 'ChronoProfiler::getEvents()'
      * returns the merged events for the most recently completed frame.
      *
-     * Responsibilities:
-     *  - copy the merged frame event list into 'frameHistory'
-     *  - maintain the 'maxHistory' rolling buffer by removing the oldest frame
+     * The events are copied into 'snapshots' and the call returns; the
+     * reporter thread later
+     *  - copies the frame into 'frameHistory', which evicts the oldest frame
      *    when capacity is exceeded
-     *  - update 'aggregatedStats' for each zone encountered
-     *  - increment the absolute 'totalFrames' counter used for frame labels
+     *  - updates 'aggregatedStats' for each zone encountered
+     *  - increments the absolute 'totalFrames' counter used for frame labels
      *
-     * Thread-safety: this function acquires 'uiMutex'.
+     * Takes no lock and, once the queue slots have grown to the largest
+     * frame, performs no heap allocations. If the queue is full the frame is
+     * dropped and counted in 'droppedSnapshots'.
+     *
+     * Thread-safety: single producer; call from one thread only.
      */
     void update();
 
-     /**
-     * @brief Render the current frame and aggregated statistics to stdout.
+    /**
+     * @brief Request a refresh of the current frame and aggregated statistics.
      *
-     * The method prints:
+     * The reporter thread prints, at most once per refresh interval:
      *  - a header line with the absolute frame number ('totalFrames')
      *  - an ASCII bar visualization of the most recent frame's zones
-     *  - a table of aggregated statistics (Zone, Avg, Max, Count)
+     *  - a table of aggregated statistics (Zone, Avg, Self, Max, Count)
+     *  - per-thread dropped event counters when a ring buffer overflowed
+     *  - the number of snapshots dropped because the queue was full
      *
-     * @note 'render()' **forces output flushing** via 'std::flush'
-     *       so UI updates appear immediately in interactive terminals.
-     *       This avoids buffering delays, especially on platforms where
-     *       stdout is line-buffered (no newline = no screen update).
+     * Requests arriving faster than the refresh interval are coalesced into
+     * one refresh showing the newest frame. The whole report is formatted in
+     * memory and written to stdout with a single flushed write.
      *
-     * Thread-safety:
-     *  - This function acquires 'uiMutex'.
-     *  - Safe to call from a render or background thread.
+     * Thread-safety: sets an atomic flag; safe to call from any thread.
      *
      * @see update()
      */
     void render();
 
-private:
-    size_t maxHistory; ///< Maximum frames retained in 'frameHistory'.
+    /**
+     * @brief Open a saved '.chrono' capture for replay.
+     *
+     * The file is memory-mapped, not loaded: frames are located through a
+     * lazily built offset index and decoded one at a time, so inspecting a
+     * late frame of a huge capture needs only that frame in memory.
+     *
+     * @param path Capture written by ChronoProfiler::beginTrace("*.chrono")
+     * @return False (with a message on stderr) if the file is missing or
+     *         not a valid capture
+     */
+    bool openReplay(const std::string& path);
+
+    /**
+     * @brief Number of frames in the open replay capture (0 if none).
+     *
+     * Indexes the whole capture on first call; frame payloads are skipped.
+     */
+    size_t replayFrameCount();
+
+    /**
+     * @brief Render frame N of the open replay capture.
+     *
+     * Uses the same ASCII layout as the live view, with names and clock taken
+     * from the capture. After the index has reached N, the lookup is O(1) and
+     * only that frame is decoded.
+     *
+     * @param frameNumber Zero-based frame position in the capture
+     */
+    void renderFrame(size_t frameNumber);
 
+private:
     /**
      * @brief Rolling history of frames.
      *
-     * Each entry is a vector of 'ChronoProfiler::Event' representing events
-     * captured for a single completed frame (merged from all threads).
+     * Each entry holds the events captured for a single completed frame
+     * (merged from all threads), stored in one preallocated arena.
      */
-    std::vector<std::vector<ChronoProfiler::Event>> frameHistory;
+    FrameHistory frameHistory;
+
+    /** @brief Length of the sliding window for zone percentiles (= history size). */
+    size_t statsWindowFrames;
 
     /**
      * @brief Aggregated all-time statistics for zones.
      *
-     * Maps zone name -> ZoneStats. Zone names are copied into 'std::string'
-     * keys for stable storage because ChronoProfiler::Event uses string_view.
+     * Maps interned zone name ID -> ZoneStats. Names are resolved from the
+     * profiler's string table only when the table is printed.
+     */
+    ZoneStatsTable aggregatedStats;
+
+    /**
+     * @brief Allocations per zone, keyed by the zone's interned name.
+     *
+     * Empty unless allocation tracking is enabled.
      */
-    std::unordered_map<std::string, ZoneStats> aggregatedStats;
+    std::map<std::string_view, AllocationStats> allocationStats;
 
-    std::mutex uiMutex; ///< Protects 'update()' and 'render()'.
+    /** @brief Scratch storage for per-event self time, reused every frame. */
+    std::vector<uint64_t> selfTicks;
+
+    /** @brief Thread names of the newest ingested frame, reused every frame. */
+    std::vector<ChronoProfiler::ThreadName> latestThreadNames;
+
+    std::mutex uiMutex; ///< Protects history, stats and the report buffer.
+
+    FrameSnapshotQueue snapshots;               ///< Frames waiting for the reporter
+    std::atomic<uint64_t> droppedSnapshots{0};  ///< Frames lost to a full queue
+    std::atomic<bool> refreshRequested{false};  ///< Set by 'render()'
+    std::atomic<bool> stopReporter{false};      ///< Set by the destructor
+    std::chrono::milliseconds refreshInterval;  ///< Minimum time between refreshes
+
+    /** @brief Report text for the next write; keeps its buffer between refreshes. */
+    std::ostringstream report;
+
+    std::unique_ptr<chronocap::MappedFile> replayFile;      ///< Mapped capture (replay mode)
+    std::unique_ptr<chronocap::CaptureReader> replayReader; ///< Index and decoder over 'replayFile'
+    chronocap::Frame replayFrame;                           ///< Decoded replay frame, reused
 
     /**
      * @brief Absolute count of frames rendered since creation.
      *
      * This is used for labeling frames in the UI and continues to grow
-     * even when 'frameHistory' has reached 'maxHistory'.
+     * even when 'frameHistory' is full.
      */
     size_t totalFrames = 0;
 
+    std::thread reporter; ///< Runs 'reporterLoop()'; declared last so it starts last
+
+    /**
+     * @brief Reporter thread body.
+     *
+     * Drains 'snapshots' every few milliseconds, and performs a requested
+     * refresh once 'refreshInterval' has passed since the previous one. A
+     * pending refresh is printed before the thread exits.
+     */
+    void reporterLoop();
+
+    /**
+     * @brief Fold one frame into history and statistics.
+     * @param events Events of the frame, as returned by ChronoProfiler::getEvents().
+     * @param threadNames Its thread names, as returned by ChronoProfiler::getThreadNames().
+     *
+     * Caller must hold 'uiMutex'.
+     */
+    void ingest(std::span<const ChronoProfiler::Event> events,
+                std::span<const ChronoProfiler::ThreadName> threadNames);
+
+    /**
+     * @brief Format the newest frame, statistics and counters into 'report'.
+     *
+     * Caller must hold 'uiMutex'.
+     */
+    void formatReport();
+
+    /**
+     * @brief Write 'report' to stdout in one call and clear it.
+     *
+     * Caller must hold 'uiMutex'.
+     */
+    void writeReport();
+
     /**
      * @brief Render a single frame's events as ASCII bars.
-     * @param events Vector of events for the frame to render.
+     * @param events Events of the frame to render.
      * @param frameIndex Absolute index of the frame (for labeling).
      *
      * Each event is printed as:
-     *   [Zone name padded] [ASCII bar proportional to duration] [N.NN ms] [ThreadName]
+     *   [Zone name indented by depth] [ASCII bar proportional to duration]
+     *   [N.NN ms] (self N.NN ms) [ThreadName]
      *
      * Implementation notes:
      * - Bars are currently scaled linearly: 'barLength = int(durationMs * 10)'.
      * - Consider dynamic scaling or clamping for extremely large durations.
      */
-    void renderFrame(const std::vector<ChronoProfiler::Event>& events, size_t frameIndex);
+    void renderFrame(std::span<const ChronoProfiler::Event> events, size_t frameIndex);
 
     /**
-     * @brief Print aggregated statistics (Zone, Avg(ms), Max(ms), Count).
+     * @brief Append one bar per zone, and one line per counter sample, to 'report'.
+     * @param events Events of one frame.
+     * @param capture Capture to resolve names and ticks from, or nullptr for
+     *                the live profiler.
+     */
+    void renderEvents(std::span<const ChronoProfiler::Event> events,
+                      const chronocap::CaptureReader* capture);
+
+    /**
+     * @brief Append aggregated statistics (Zone, Avg, Self, p50, p95, p99, StdDev, Max, Count).
+     *
+     * Prints an all-time table followed by the same percentiles over the
+     * sliding window of recent frames.
      *
      * The table uses 'std::setw' formatting to align columns. A caller may
      * prefer CSV or JSON output for automated post-processing; see
      * ChronoProfiler::exportToJSON() for JSON export of raw events.
      */
     void renderAggregatedStats();
+
+    /**
+     * @brief Append per-zone allocation counts and bytes, if any were tracked.
+     *
+     * Shows the newest frame, the per-frame average and the worst frame for
+     * every zone that allocated while tracking was enabled.
+     */
+    void renderAllocationStats();
+
+    /**
+     * @brief Append per-thread dropped event counters, if any thread dropped events.
+     *
+     * Dropped events mean the timeline for that thread is incomplete, so the
+     * section is only shown when at least one counter is non-zero.
+     */
+    void renderOverflow();
 };
 
 #else // ======================= NO-OP VERSION ======================= //
@@ -237,7 +664,9 @@ private:
 // This mirrors the pattern used in ChronoProfiler.hpp: the real behavior is
 // compiled under '#if defined(PROFILER)', while here we provide trivial
 // implementations that compile away at optimization time.
+#include <chrono>
 #include <cstddef>
+#include <string>
 
 /**
  * @class ProfilerUI
@@ -259,14 +688,26 @@ public:
     /**
      * @brief Construct a no-op ProfilerUI.
      * @param historySize Ignored.
+     * @param eventsPerFrame Ignored.
+     * @param refreshInterval Ignored.
      */
-    explicit ProfilerUI(size_t = 60) {}
+    explicit ProfilerUI(size_t = 60, size_t = 256,
+                        std::chrono::milliseconds = std::chrono::milliseconds(100)) {}
 
     /** @brief No-op update method. */
     void update() {}
 
     /** @brief No-op render method. */
     void render() {}
+
+    /** @brief Replay is unavailable without the profiler. @return Always false. */
+    bool openReplay(const std::string&) { return false; }
+
+    /** @brief No-op replay frame count. @return Always 0. */
+    size_t replayFrameCount() { return 0; }
+
+    /** @brief No-op replay render. */
+    void renderFrame(size_t) {}
 };
 
 #endif // defined(PROFILER)
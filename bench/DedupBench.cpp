@@ -0,0 +1,331 @@
+/**
+ * @file DedupBench.cpp
+ * @brief Benchmark: vertex deduplication, map versus flat table, serial versus parallel.
+ *
+ * Usage:
+ * @code
+ * make bench                   # builds and runs every benchmark
+ * build/check/DedupBench       # this one only
+ * build/check/DedupBench 4     # parallel lines limited to 4 threads
+ * build/check/DedupBench 0 50M # a 50-million-triangle grid, all threads
+ * build/check/DedupBench 0 models/statue.obj # an OBJ's corners
+ * @endcode
+ *
+ * The corner stream is a textured grid mesh (two triangles per cell, one
+ * texture seam every 16 columns) of about 1.6 million triangles, or of the
+ * count given after the thread count ("2000000", "500k", "50M"; 1M to 50M
+ * spans small to very large scans), or the triangulated corners of the OBJ
+ * given there instead. Grid corners are computed from their index when read,
+ * so even 50 million triangles (150 million corners, 4.8 GB as an array)
+ * cost nothing beyond what deduplication itself allocates; every line pays
+ * the same for computing them. The stream is deduplicated by:
+ *  - std::unordered_map<Vertex, uint32_t>, the original loadModel() loop;
+ *  - VertexDedupTable on the calling thread;
+ *  - meshimport::deduplicate() on every hardware thread (or the count given
+ *    on the command line);
+ *  - meshimport::Deduplicator fed in importObj()-sized batches;
+ *  - meshimport::importObj() reading, parsing and deduplicating the file
+ *    (OBJ only).
+ * Each line reports the median of several runs, the speedup over the map and
+ * the peak resident set size. Every line runs in its own forked process, so
+ * its peak (getrusage() ru_maxrss) is not masked by an earlier, hungrier
+ * line; the figure in parentheses is the growth over what the process
+ * started with (an OBJ's corner stream, or next to nothing for the grid).
+ * The parallel lines can only beat the serial table on a multi-core host.
+ */
+
+#include "MeshImport.hpp"
+#include "ObjReader.hpp"
+#include "VertexDedupTable.hpp"
+#include "VertexHash.hpp" ///< std::hash<Vertex> for the map
+
+#include <algorithm>      ///< std::nth_element for the median, std::min
+#include <chrono>         ///< steady_clock to time each run
+#include <cstdio>         ///< std::printf for the report
+#include <cstdlib>        ///< std::atoi, std::strtod for the arguments
+#include <exception>      ///< Import errors
+#include <functional>     ///< One line's work, run in a child
+#include <malloc.h>       ///< malloc_trim() after the OBJ import
+#include <string>         ///< OBJ path
+#include <sys/resource.h> ///< getrusage() for the peak RSS
+#include <sys/wait.h>     ///< waitpid() for each line's process
+#include <thread>         ///< hardware_concurrency for the report
+#include <unistd.h>       ///< fork(), pipe()
+#include <unordered_map>  ///< Baseline
+#include <vector>         ///< Corners, vertices, indices, timings
+
+namespace {
+
+constexpr size_t kDefaultGridSide = 896; ///< Grid of 896^2 positions, 1.6M triangles
+constexpr size_t kSeamEvery = 16;        ///< Columns between texture seams
+constexpr int kRuns = 7;                 ///< Timed runs per line
+
+/** @brief The benchmark mesh, whose triangle corners are computed from their index. */
+struct GridMesh {
+  size_t side = kDefaultGridSide; ///< Grid of side^2 positions
+
+  /** @brief The smallest grid with at least 'triangles' triangles. */
+  static GridMesh withTriangles(size_t triangles) {
+    size_t cells = 1;
+    while (2 * cells * cells < triangles)
+      ++cells;
+    return {cells + 1};
+  }
+
+  /** @brief Six corners (two triangles) per cell. */
+  size_t cornerCount() const { return (side - 1) * (side - 1) * 6; }
+
+  /** @brief Corner 'i', in row-major cell order. */
+  Vertex corner(size_t i) const {
+    // Corners a, b, c, a, c, d of a cell whose lower-left position is a
+    static constexpr uint8_t kDx[6] = {0, 1, 1, 0, 1, 0};
+    static constexpr uint8_t kDy[6] = {0, 0, 1, 0, 1, 1};
+    const size_t cell = i / 6, k = i % 6;
+    const size_t cellX = cell % (side - 1);
+    const size_t x = cellX + kDx[k], y = cell / (side - 1) + kDy[k];
+
+    Vertex v{};
+    v.position = {static_cast<float>(x), static_cast<float>(y), 0.0f};
+    v.color = {1.0f, 1.0f, 1.0f};
+    // A seam: the cell right of each seam column maps to a separate UV island
+    const bool island = x % kSeamEvery == 0 && cellX == x;
+    v.texCoord = {static_cast<float>(x) / side + (island ? 0.5f : 0.0f),
+                  static_cast<float>(y) / side};
+    return v;
+  }
+};
+
+/**
+ * @brief Parses a triangle count such as "2000000", "500k" or "50M".
+ * @param text Command-line argument
+ * @return The count, or 0 if 'text' is not one (an OBJ path)
+ */
+size_t parseTriangles(const char *text) {
+  char *end = nullptr;
+  double count = std::strtod(text, &end);
+  if (end == text)
+    return 0;
+  if (*end == 'k' || *end == 'K') {
+    count *= 1e3;
+    ++end;
+  } else if (*end == 'm' || *end == 'M') {
+    count *= 1e6;
+    ++end;
+  }
+  return *end == '\0' && count >= 1.0 ? static_cast<size_t>(count) : 0;
+}
+
+/**
+ * @brief Median wall time of 'body' in milliseconds.
+ * @param body Work to time
+ */
+template <typename Fn> double medianMs(Fn &&body) {
+  using clock = std::chrono::steady_clock;
+  std::vector<double> runMs(kRuns);
+  for (double &ms : runMs) {
+    const clock::time_point start = clock::now();
+    body();
+    ms = std::chrono::duration<double, std::milli>(clock::now() - start)
+             .count();
+  }
+  std::nth_element(runMs.begin(), runMs.begin() + kRuns / 2, runMs.end());
+  return runMs[kRuns / 2];
+}
+
+/** @brief Peak resident set size of this process so far, in KiB. */
+long peakRssKiB() {
+  rusage usage{};
+  getrusage(RUSAGE_SELF, &usage);
+  return usage.ru_maxrss;
+}
+
+/** @brief What one line measured in its process. */
+struct LineResult {
+  double ms = 0.0;        ///< Median wall time
+  long startKiB = 0;      ///< Peak RSS when the process started (the corners)
+  long peakKiB = 0;       ///< Peak RSS after every run
+  size_t uniqueCount = 0; ///< Vertices produced
+  bool ok = false;        ///< The child reported back
+};
+
+/**
+ * @brief Times 'body' in a forked child and collects its peak RSS.
+ *
+ * @param body Work to time; returns the vertex count it produced
+ * @return The child's result, with ok false if it failed
+ *
+ * @details A forked child starts with the parent's resident pages as its
+ * peak, so startKiB is read first and the line's own footprint is the
+ * difference.
+ */
+LineResult runLine(const std::function<size_t()> &body) {
+  LineResult result;
+  int fds[2];
+  if (pipe(fds) != 0)
+    return result;
+
+  const pid_t pid = fork();
+  if (pid == 0) {
+    close(fds[0]);
+    result.startKiB = peakRssKiB();
+    result.ms = medianMs([&] { result.uniqueCount = body(); });
+    result.peakKiB = peakRssKiB();
+    result.ok = true;
+    [[maybe_unused]] const ssize_t written =
+        write(fds[1], &result, sizeof(result));
+    _exit(0);
+  }
+
+  close(fds[1]);
+  if (pid > 0) {
+    LineResult child;
+    if (read(fds[0], &child, sizeof(child)) == sizeof(child))
+      result = child;
+    int status = 0;
+    waitpid(pid, &status, 0);
+    result.ok = result.ok && WIFEXITED(status) && WEXITSTATUS(status) == 0;
+  }
+  close(fds[0]);
+  return result;
+}
+
+/** @brief Prints one line of the report. */
+void printLine(const char *label, const LineResult &line, double mapMs,
+               const char *note = "") {
+  if (!line.ok) {
+    std::printf("%-10s failed\n", label);
+    return;
+  }
+  std::printf("%-10s %8.1f ms  (%.2fx)  peak %7.1f MiB (+%.1f)%s\n", label,
+              line.ms, mapMs / line.ms, line.peakKiB / 1024.0,
+              (line.peakKiB - line.startKiB) / 1024.0, note);
+}
+
+/**
+ * @brief Runs every line over one corner stream and prints the report.
+ *
+ * @param source Mesh description for the report
+ * @param cornerCount Corners in the stream
+ * @param corner Returns corner i (a Vertex) for i < cornerCount
+ * @param cornerBytes Memory the stream occupies before any line runs
+ * @param threads Thread limit for the parallel lines; 0 uses every hardware thread
+ * @param objPath OBJ to time importObj() on, or empty
+ * @return Process exit code: 0 if every line ran and agreed on the vertex count
+ */
+template <typename CornerFn>
+int runBench(const std::string &source, size_t cornerCount,
+             const CornerFn &corner, size_t cornerBytes, unsigned threads,
+             const std::string &objPath) {
+  std::vector<Vertex> vertices;
+  std::vector<uint32_t> indices;
+
+  const LineResult map = runLine([&] {
+    std::unordered_map<Vertex, uint32_t> uniqueVertices;
+    vertices.clear();
+    indices.clear();
+    for (size_t i = 0; i < cornerCount; ++i) {
+      const Vertex vertex = corner(i);
+      auto [it, inserted] = uniqueVertices.try_emplace(
+          vertex, static_cast<uint32_t>(vertices.size()));
+      if (inserted)
+        vertices.push_back(vertex);
+      indices.push_back(it->second);
+    }
+    return vertices.size();
+  });
+
+  const LineResult table = runLine([&] {
+    vertices.clear();
+    indices.clear();
+    VertexDedupTable table(vertices,
+                           VertexDedupTable::expectedVertices(cornerCount));
+    for (size_t i = 0; i < cornerCount; ++i)
+      indices.push_back(table.insert(corner(i)).first);
+    return vertices.size();
+  });
+
+  const LineResult parallel = runLine([&] {
+    meshimport::deduplicate(cornerCount, corner, vertices, indices, threads);
+    return vertices.size();
+  });
+
+  const size_t batchCorners = meshimport::objBatchCorners(threads);
+  const LineResult batched = runLine([&] {
+    meshimport::Deduplicator deduplicator(
+        vertices, indices, VertexDedupTable::expectedVertices(cornerCount),
+        threads);
+    for (size_t begin = 0; begin < cornerCount; begin += batchCorners) {
+      deduplicator.append(std::min(batchCorners, cornerCount - begin),
+                          [&](size_t i) { return corner(begin + i); });
+    }
+    return vertices.size();
+  });
+
+  LineResult imported;
+  if (!objPath.empty()) {
+    imported = runLine([&] {
+      meshimport::importObj(objPath, vertices, indices, threads);
+      return vertices.size();
+    });
+  }
+
+  std::printf("mesh:    %s, %zu corners, %zu unique vertices, %u of %u threads\n",
+              source.c_str(), cornerCount, map.uniqueCount,
+              meshimport::resolveThreadCount(threads),
+              std::thread::hardware_concurrency());
+  std::printf("corners: %.1f MiB in memory\n",
+              cornerBytes / (1024.0 * 1024.0));
+  printLine("map:", map, map.ms);
+  printLine("table:", table, map.ms);
+  printLine("parallel:", parallel, map.ms);
+  char note[64];
+  std::snprintf(note, sizeof(note), ", batches of %zu corners", batchCorners);
+  printLine("batched:", batched, map.ms, note);
+  if (!objPath.empty())
+    printLine("import:", imported, map.ms);
+
+  bool ok = map.ok && table.ok && parallel.ok && batched.ok;
+  for (const LineResult *line : {&table, &parallel, &batched})
+    ok = ok && line->uniqueCount == map.uniqueCount;
+  if (!objPath.empty())
+    ok = ok && imported.ok && imported.uniqueCount == map.uniqueCount;
+  return ok ? 0 : 1;
+}
+
+} // namespace
+
+int main(int argc, char **argv) {
+  const unsigned threads = argc > 1 ? static_cast<unsigned>(std::atoi(argv[1])) : 0;
+  const size_t triangles = argc > 2 ? parseTriangles(argv[2]) : 0;
+
+  if (argc <= 2 || triangles > 0) {
+    const GridMesh grid =
+        triangles > 0 ? GridMesh::withTriangles(triangles) : GridMesh{};
+    const std::string source = "grid " + std::to_string(grid.side) + "^2, " +
+                               std::to_string(grid.cornerCount() / 3) +
+                               " triangles";
+    return runBench(source, grid.cornerCount(),
+                    [&](size_t i) { return grid.corner(i); }, 0, threads, "");
+  }
+
+  // The file's corner stream, in file order, rebuilt from its import
+  const std::string objPath = argv[2];
+  std::vector<Vertex> corners;
+  {
+    std::vector<Vertex> vertices;
+    std::vector<uint32_t> indices;
+    try {
+      meshimport::importObj(objPath, vertices, indices, threads);
+    } catch (const std::exception &e) {
+      std::fprintf(stderr, "%s\n", e.what());
+      return 1;
+    }
+    corners.reserve(indices.size());
+    for (uint32_t index : indices)
+      corners.push_back(vertices[index]);
+  }
+  malloc_trim(0); // Or the children start with the import's freed heap resident
+  return runBench(objPath, corners.size(),
+                  [&](size_t i) { return corners[i]; },
+                  corners.size() * sizeof(Vertex), threads, objPath);
+}
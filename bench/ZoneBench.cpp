@@ -0,0 +1,89 @@
+/**
+ * @file ZoneBench.cpp
+ * @brief Microbenchmark: cost of one profiler zone (start + end).
+ *
+ * Usage:
+ * @code
+ * make bench              # builds and runs every benchmark
+ * build/check/ZoneBench   # this one only
+ * @endcode
+ *
+ * Zones are timed in batches that fit in the thread's ring, with endFrame()
+ * between batches so the frame merge is not part of the measurement. Each
+ * line reports the median batch divided by its zone count. The cost of one
+ * nowTicks() is reported as well: every zone reads the clock twice, so on
+ * hosts with a slow TSC (virtual machines in particular) that alone can
+ * exceed the budget.
+ */
+
+#include "ChronoProfiler.hpp"
+
+#include <algorithm> ///< std::nth_element for the median
+#include <chrono>    ///< steady_clock to time each batch
+#include <cstdio>    ///< std::printf for the report
+#include <vector>    ///< Per-batch timings
+
+namespace {
+
+/** @brief Target cost of one zone on the capture path. */
+constexpr double kBudgetNs = 20.0;
+
+/** @brief Zones per timed batch (well below the ring capacity). */
+constexpr int kBatchZones = 1024;
+
+/** @brief Timed batches per measurement. */
+constexpr int kBatches = 301;
+
+/**
+ * @brief Median cost per operation of 'body' run kBatchZones times per batch.
+ * @param body Work to time; runs one operation per call
+ * @return Nanoseconds per operation
+ */
+template <typename Fn> double medianNs(Fn &&body) {
+  using clock = std::chrono::steady_clock;
+  std::vector<double> batchNs(kBatches);
+
+  for (double &ns : batchNs) {
+    ChronoProfiler::beginFrame();
+    const clock::time_point start = clock::now();
+    for (int i = 0; i < kBatchZones; ++i)
+      body();
+    const clock::time_point end = clock::now();
+    ChronoProfiler::endFrame(); // Drain the ring outside the timed region
+
+    ns = std::chrono::duration<double, std::nano>(end - start).count() /
+         kBatchZones;
+  }
+
+  std::nth_element(batchNs.begin(), batchNs.begin() + kBatches / 2,
+                   batchNs.end());
+  return batchNs[kBatches / 2];
+}
+
+} // namespace
+
+int main() {
+  ChronoProfiler::init();
+  ChronoProfiler::setCapturePolicy(ChronoProfiler::CapturePolicy::everyNth(
+      1000000)); // Discard frames: only the zone path is of interest
+
+  volatile uint64_t sink = 0;
+  const double clockNs = medianNs([&] { sink = ChronoProfiler::nowTicks(); });
+  const double siteNs = medianNs([] { PROFILE_SCOPE("bench.site"); });
+  const double namedNs =
+      medianNs([] { ChronoProfiler::ScopedZone zone("bench.named"); });
+  const double nestedNs = medianNs([] {
+    PROFILE_SCOPE("bench.outer");
+    PROFILE_SCOPE("bench.inner");
+  }) / 2;
+
+  std::printf("clock:   %s, %.1f ns per nowTicks()\n",
+              ChronoProfiler::usesTsc() ? "TSC" : "steady_clock", clockNs);
+  std::printf("%-8s %6.1f ns/zone  (%.1f ns excluding the two clock reads)\n",
+              "site:", siteNs, siteNs - 2 * clockNs);
+  std::printf("%-8s %6.1f ns/zone\n", "named:", namedNs);
+  std::printf("%-8s %6.1f ns/zone\n", "nested:", nestedNs);
+  std::printf("budget:  %.0f ns/zone -> %s\n", kBudgetNs,
+              siteNs <= kBudgetNs ? "met" : "NOT met");
+  return 0;
+}
@@ -0,0 +1,375 @@
+#pragma once
+#include "ChronoProfiler.hpp"
+
+#include <cstdint>
+#include <cstring>
+#include <span>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <vector>
+
+/**
+ * @file ChronoCapture.hpp
+ * @brief Versioned binary '.chrono' capture format shared by the trace writer,
+ * the capture reader and the 'chrono-convert' tool.
+ *
+ * A capture is a fixed header followed by a stream of chunks:
+ *
+ * @code
+ * Header (24 bytes, little-endian)
+ *   char[8]  magic       "CHRONO\r\n"
+ *   uint16   version     kVersion
+ *   uint16   headerSize  kHeaderSize
+ *   uint32   flags       HeaderFlags
+ *   uint64   originTicks tick value of trace time 0
+ *
+ * Chunk
+ *   uint8    type        ChunkType
+ *   varint   size        payload bytes
+ *   payload
+ * @endcode
+ *
+ * The string table is written incrementally: a 'String' or 'Thread' chunk
+ * always precedes the first frame that references the ID. 'Clock' chunks carry
+ * the tick period whenever it changes. Each 'Frame' chunk stores its absolute
+ * start tick, so any frame decodes without the frames before it; its events
+ * are delta-encoded against the previous event and packed as LEB128 varints
+ * (about 10-12 bytes per event instead of ~200 bytes of JSON).
+ *
+ * The **chronocap** namespace holds the encoding helpers used by the writer,
+ * a read-only memory mapping of capture files, and a CaptureReader with a
+ * lazily built frame index for sequential conversion and random-access replay.
+ *
+ * @see ChronoTraceWriter
+ */
+namespace chronocap {
+
+/** @brief File signature; the CR/LF pair detects text-mode corruption. */
+inline constexpr char kMagic[8] = {'C', 'H', 'R', 'O', 'N', 'O', '\r', '\n'};
+
+/**
+ * @brief Current format version. Readers reject newer versions.
+ *
+ * Version 2 adds counter and gauge samples (events flagged with
+ * Event::kFlagCounter / kFlagPlot, whose duration field holds the value);
+ * version 1 files decode unchanged.
+ */
+inline constexpr uint16_t kVersion = 2;
+
+/** @brief Size in bytes of the fixed file header. */
+inline constexpr uint16_t kHeaderSize = 24;
+
+/** @brief Bits of the header 'flags' field. */
+enum HeaderFlags : uint32_t {
+  kFlagTscTicks = 1u << 0, ///< Ticks are invariant TSC cycles (else steady_clock)
+};
+
+/** @brief Chunk types following the header. */
+enum class ChunkType : uint8_t {
+  String = 1, ///< varint id, uint32 color, varint length, bytes
+  Thread = 2, ///< varint threadId, varint length, bytes
+  Clock = 3,  ///< float64 milliseconds per tick
+  Frame = 4,  ///< varint frameIndex, uint64 startTicks, varint count, events
+};
+
+// ----------------- //
+// Encoding helpers  //
+// ----------------- //
+
+/** @brief Appends an unsigned LEB128 varint. */
+inline void putVarint(std::string &out, uint64_t value) {
+  while (value >= 0x80) {
+    out += static_cast<char>((value & 0x7F) | 0x80);
+    value >>= 7;
+  }
+  out += static_cast<char>(value);
+}
+
+/** @brief Maps signed deltas to unsigned so small magnitudes stay short. */
+inline uint64_t zigzag(int64_t value) {
+  return (static_cast<uint64_t>(value) << 1) ^
+         static_cast<uint64_t>(value >> 63);
+}
+
+/** @brief Inverse of zigzag(). */
+inline int64_t unzigzag(uint64_t value) {
+  return static_cast<int64_t>(value >> 1) ^ -static_cast<int64_t>(value & 1);
+}
+
+/** @brief Appends a little-endian fixed-width integer. */
+template <typename T> inline void putFixed(std::string &out, T value) {
+  for (size_t i = 0; i < sizeof(T); ++i)
+    out += static_cast<char>((static_cast<uint64_t>(value) >> (i * 8)) & 0xFF);
+}
+
+/** @brief Appends a float64 as its little-endian bit pattern. */
+inline void putDouble(std::string &out, double value) {
+  uint64_t bits;
+  std::memcpy(&bits, &value, sizeof(bits));
+  putFixed(out, bits);
+}
+
+/**
+ * @brief Appends a quoted JSON string literal with the required escaping.
+ *
+ * Shared by the Chrome trace writer and chrono-convert so both emit identical
+ * text for zone and thread names.
+ */
+void appendJsonString(std::string &out, std::string_view text);
+
+/**
+ * @brief Writes the 24-byte file header.
+ *
+ * @param out Destination buffer
+ * @param originTicks Tick value that maps to trace time 0
+ * @param tscTicks Whether ticks are TSC cycles
+ */
+void writeHeader(std::string &out, uint64_t originTicks, bool tscTicks);
+
+/**
+ * @brief Appends a chunk header and payload.
+ *
+ * @param out Destination buffer
+ * @param type Chunk type
+ * @param payload Encoded chunk body
+ */
+void writeChunk(std::string &out, ChunkType type, std::string_view payload);
+
+/**
+ * @brief Encodes one frame's events as a 'Frame' chunk payload.
+ *
+ * @param payload Destination buffer (appended to)
+ * @param frameIndex Sequential index of the frame in the capture
+ * @param frameStartTicks Absolute tick at which the frame began
+ * @param events Merged frame events, as returned by ChronoProfiler::getEvents()
+ */
+void encodeFrame(std::string &payload, uint64_t frameIndex,
+                 uint64_t frameStartTicks,
+                 std::span<const ChronoProfiler::Event> events);
+
+// ---------------- //
+// Decoding         //
+// ---------------- //
+
+/**
+ * @brief Bounds-checked cursor over encoded bytes.
+ *
+ * Every read throws std::runtime_error instead of running past the end, so a
+ * corrupt or truncated capture can never cause an out-of-bounds read.
+ */
+class ByteReader {
+public:
+  explicit ByteReader(std::span<const uint8_t> bytes) : data(bytes) {}
+
+  /** @brief Reads an unsigned LEB128 varint. */
+  uint64_t varint();
+
+  /** @brief Reads a little-endian fixed-width integer. */
+  template <typename T> T fixed() {
+    require(sizeof(T));
+    uint64_t value = 0;
+    for (size_t i = 0; i < sizeof(T); ++i)
+      value |= static_cast<uint64_t>(data[pos + i]) << (i * 8);
+    pos += sizeof(T);
+    return static_cast<T>(value);
+  }
+
+  /** @brief Reads a float64. */
+  double float64();
+
+  /** @brief Returns the next 'size' bytes as a string view. */
+  std::string_view bytes(size_t size);
+
+  /** @brief Number of unread bytes. */
+  size_t remaining() const { return data.size() - pos; }
+
+  /** @brief Current offset from the start of the span. */
+  size_t offset() const { return pos; }
+
+private:
+  /** @brief Throws if fewer than 'size' bytes remain. */
+  void require(size_t size) const;
+
+  std::span<const uint8_t> data; ///< Bytes being decoded
+  size_t pos = 0;                ///< Read cursor
+};
+
+/**
+ * @brief Decodes the events of a 'Frame' chunk payload.
+ *
+ * @param reader Cursor positioned at the start of the payload
+ * @param frameIndex Receives the frame's sequential index
+ * @param frameStartTicks Receives the frame's absolute start tick
+ * @param events Receives the frame events (cleared first)
+ */
+void decodeFrame(ByteReader &reader, uint64_t &frameIndex,
+                 uint64_t &frameStartTicks,
+                 std::vector<ChronoProfiler::Event> &events);
+
+/**
+ * @struct Frame
+ * @brief One decoded frame of a capture.
+ */
+struct Frame {
+  uint64_t index = 0;      ///< Sequential frame index (gaps mark dropped frames)
+  uint64_t startTicks = 0; ///< Absolute start tick
+  std::vector<ChronoProfiler::Event> events; ///< Events with resolved parents
+};
+
+/**
+ * @class MappedFile
+ * @brief Read-only memory mapping of a whole file.
+ *
+ * Pages are faulted in only when touched, so opening a multi-gigabyte capture
+ * costs nothing until frames are actually read.
+ */
+class MappedFile {
+public:
+  /**
+   * @brief Maps a file read-only.
+   *
+   * @param path File to map
+   * @throws std::runtime_error if the file cannot be opened or mapped
+   */
+  explicit MappedFile(const std::string &path);
+
+  /** @brief Unmaps the file. */
+  ~MappedFile();
+
+  MappedFile(const MappedFile &) = delete;
+  MappedFile &operator=(const MappedFile &) = delete;
+
+  /** @brief The mapped bytes (valid for the lifetime of this object). */
+  std::span<const uint8_t> bytes() const { return {data, size}; }
+
+private:
+  const uint8_t *data = nullptr; ///< Start of the mapping
+  size_t size = 0;               ///< Mapped length in bytes
+};
+
+/**
+ * @class CaptureReader
+ * @brief Decoder for a '.chrono' capture held in memory or mapped from disk.
+ *
+ * Validates the header on construction. Frames can be read in file order with
+ * nextFrame() or by position with readFrame(). Both go through a frame-offset
+ * index that is extended lazily: reaching frame N for the first time walks
+ * chunk headers up to N, applying the small string, thread and clock chunks
+ * but skipping frame payloads. After that, any indexed frame is located in
+ * O(1) and only its own payload is decoded. A truncated final chunk (e.g. from
+ * a crashed process) ends the capture cleanly.
+ *
+ * A thread ID may be renamed mid-capture (an exited thread's ID reused by a
+ * new thread), so thread names are kept per frame position and
+ * getThreadName() answers for the frame last read, whatever order frames are
+ * read in.
+ *
+ * @code
+ * chronocap::CaptureReader reader(bytes);
+ * chronocap::Frame frame;
+ * while (reader.nextFrame(frame)) {
+ *   for (const auto &evt : frame.events)
+ *     use(reader.getString(evt.nameId), reader.ticksToMs(evt.endTicks - evt.startTicks));
+ * }
+ * @endcode
+ */
+class CaptureReader {
+public:
+  /**
+   * @brief Parses and validates the capture header.
+   *
+   * @param bytes Entire capture file contents (must outlive the reader)
+   * @throws std::runtime_error on a bad signature or unsupported version
+   */
+  explicit CaptureReader(std::span<const uint8_t> bytes);
+
+  /**
+   * @brief Decodes the frame after the one last returned by nextFrame().
+   *
+   * @param frame Receives the frame (its event vector is reused)
+   * @return False once no complete frame remains
+   * @throws std::runtime_error if a complete chunk is malformed
+   */
+  bool nextFrame(Frame &frame);
+
+  /**
+   * @brief Decodes the frame at a given position in the file.
+   *
+   * @param position Zero-based frame position (not Frame::index, which skips
+   *                 frames the writer dropped)
+   * @param frame Receives the frame (its event vector is reused)
+   * @return False if the capture holds fewer frames
+   * @throws std::runtime_error if the frame chunk is malformed
+   */
+  bool readFrame(size_t position, Frame &frame);
+
+  /**
+   * @brief Total number of complete frames (indexes the whole capture).
+   * @return Frame count
+   */
+  size_t frameCount();
+
+  /** @brief Name for an interned string ID ("" if unknown). */
+  std::string_view getString(uint16_t id) const;
+
+  /** @brief Color recorded for an interned string ID. */
+  uint32_t getColor(uint16_t id) const;
+
+  /**
+   * @brief Name a thread ID had in the frame last read.
+   *
+   * @param threadId Event::threadId
+   * @return The name of the last 'Thread' chunk for the ID that precedes
+   *         that frame ("<unnamed>" if none)
+   */
+  std::string_view getThreadName(uint32_t threadId) const;
+
+  /** @brief Converts a tick delta using the clock of the last frame read. */
+  double ticksToMs(int64_t ticks) const { return ticks * msPerTick; }
+
+  /** @brief Tick value of trace time 0. */
+  uint64_t getOriginTicks() const { return originTicks; }
+
+  /** @brief Whether the capture was recorded with TSC ticks. */
+  bool usesTsc() const { return (flags & kFlagTscTicks) != 0; }
+
+private:
+  /** @brief Location of one frame chunk payload. */
+  struct FrameEntry {
+    size_t offset;    ///< Payload offset in the capture
+    size_t size;      ///< Payload size in bytes
+    double msPerTick; ///< Clock period in effect for this frame
+  };
+
+  /** @brief A thread's name from a frame position onwards. */
+  struct ThreadNameChange {
+    size_t firstFrame; ///< Position of the first frame using the name
+    std::string name;  ///< Name from that frame on
+  };
+
+  /** @brief Extends the index by one frame. @return False at end of capture. */
+  bool indexNextFrame();
+
+  /** @brief Applies a non-frame chunk to the reader state. */
+  void applyChunk(ChunkType type, ByteReader &payload);
+
+  std::span<const uint8_t> data;   ///< Whole capture
+  size_t scanCursor = kHeaderSize; ///< Offset of the next unindexed chunk
+  bool scanComplete = false;       ///< Whole capture indexed
+  size_t nextPosition = 0;         ///< Position returned by the next nextFrame()
+  uint32_t flags = 0;              ///< Header flags
+  uint64_t originTicks = 0;        ///< Header origin tick
+  double scanMsPerTick = 0.0;      ///< Latest clock chunk seen while indexing
+  double msPerTick = 0.0;          ///< Clock of the last frame read
+  size_t framePosition = 0;        ///< Position of the last frame read
+
+  std::vector<FrameEntry> frames; ///< Lazily built frame-offset index
+
+  std::vector<std::string> strings;   ///< Interned strings by ID
+  std::vector<uint32_t> colors;       ///< Colors by string ID
+  /** @brief Name changes per thread ID, in frame order. */
+  std::unordered_map<uint32_t, std::vector<ThreadNameChange>> threadNames;
+};
+
+} // namespace chronocap
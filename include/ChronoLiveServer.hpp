@@ -0,0 +1,175 @@
+#pragma once
+
+/**
+ * @file ChronoLiveServer.hpp
+ * @brief Embedded localhost HTTP server streaming ChronoProfiler frames live.
+ *
+ * ChronoLiveServer lets a browser on the same machine (or through an SSH
+ * tunnel) watch the profiler while the renderer runs. It listens on
+ * 127.0.0.1 only and answers two requests:
+ *  - 'GET /' serves a self-contained viewer page (timeline per thread,
+ *    frame-time graph, zone statistics and counters).
+ *  - 'GET /events' opens a Server-Sent Events stream with one JSON message
+ *    per captured frame: its zones, counter samples and the aggregated zone
+ *    statistics since the server started.
+ *
+ * The frame thread only copies raw 32-byte events into a single-frame
+ * mailbox and, when the mailbox was empty, writes one byte to a pipe to wake
+ * the server. A background thread owns the sockets and does all aggregation and
+ * JSON serialization. Backpressure never reaches the renderer:
+ *  - if the server has not picked up the previous frame yet, the new frame
+ *    replaces it (the older one is counted as dropped);
+ *  - if a client has more than kMaxClientBacklog bytes unsent, frames are
+ *    skipped for that client until it catches up.
+ *
+ * Only compiled when 'PROFILER' is defined.
+ */
+
+#if defined(PROFILER)
+
+#include "ChronoProfiler.hpp"
+
+#include <atomic>        ///< Stop flag read by the server thread
+#include <mutex>         ///< Guards the frame mailbox
+#include <span>          ///< Frames are submitted as spans of events
+#include <string>        ///< Request and output buffers
+#include <thread>        ///< Background server thread
+#include <unordered_map> ///< Aggregated statistics per zone name
+#include <utility>       ///< std::pair for sorting the statistics
+#include <vector>        ///< Mailbox, clients and the frame being serialized
+
+/**
+ * @class ChronoLiveServer
+ * @brief Single-threaded, non-blocking HTTP/SSE server for live profiling.
+ *
+ * Typical usage goes through ChronoProfiler::startLiveServer() and
+ * ChronoProfiler::stopLiveServer(); endFrame() forwards every captured frame.
+ *
+ * @par Thread-safety
+ * submit() may be called from any thread. The destructor must not race with
+ * submit().
+ */
+class ChronoLiveServer {
+public:
+    /** @brief Maximum number of simultaneously connected clients. */
+    static constexpr size_t kMaxClients = 8;
+
+    /** @brief Unsent bytes per client above which frames are skipped for it. */
+    static constexpr size_t kMaxClientBacklog = 1 << 20;
+
+    /** @brief Largest accepted HTTP request header. */
+    static constexpr size_t kMaxRequestBytes = 8 * 1024;
+
+    /** @brief Zones listed in each message's statistics, by total time. */
+    static constexpr size_t kMaxStatsZones = 32;
+
+    /** @brief Server thread poll timeout (frames and shutdown wake it earlier). */
+    static constexpr int kPollTimeoutMs = 100;
+
+    /**
+     * @brief Binds 127.0.0.1:port and starts the server thread.
+     *
+     * @param port TCP port to listen on; 0 lets the system pick a free one
+     *             (see port())
+     * @throws std::runtime_error if the socket cannot be created or bound
+     */
+    explicit ChronoLiveServer(uint16_t port);
+
+    /** @brief Stops the server thread and closes every connection. */
+    ~ChronoLiveServer();
+
+    ChronoLiveServer(const ChronoLiveServer&) = delete;
+    ChronoLiveServer& operator=(const ChronoLiveServer&) = delete;
+
+    /**
+     * @brief Hands one merged frame to the server.
+     *
+     * Copies the events and their thread names into the mailbox, replacing a
+     * frame the server has not picked up yet. Never blocks on the network.
+     *
+     * @param events Events of one frame (as returned by ChronoProfiler::getEvents())
+     * @param threadNames Its thread names (as returned by ChronoProfiler::getThreadNames())
+     * @param frameStartTicks Tick at which the frame began
+     */
+    void submit(std::span<const ChronoProfiler::Event> events,
+                std::span<const ChronoProfiler::ThreadName> threadNames,
+                uint64_t frameStartTicks);
+
+    /** @brief Frames replaced in the mailbox before the server picked them up. */
+    uint64_t droppedFrames() const;
+
+    /** @brief Port the server listens on (the one picked when constructed with 0). */
+    uint16_t port() const { return listenPort; }
+
+private:
+    /** @brief One accepted connection. */
+    struct Client {
+        int fd = -1;           ///< Non-blocking socket
+        std::string request;   ///< Request header received so far
+        std::string output;    ///< Bytes waiting to be sent
+        size_t sent = 0;       ///< Bytes of 'output' already sent
+        bool streaming = false; ///< Subscribed to /events
+        bool closing = false;  ///< Close once 'output' is sent
+        bool closed = false;   ///< Remove on the next sweep
+    };
+
+    /** @brief Statistics of one zone name since the server started. */
+    struct ZoneStats {
+        uint64_t calls = 0;  ///< Number of zones recorded
+        double totalMs = 0.0; ///< Sum of inclusive durations
+        double maxMs = 0.0;  ///< Longest single zone
+    };
+
+    /** @brief Server thread body: poll sockets, pick up frames, serialize, send. */
+    void run();
+
+    /** @brief Accepts pending connections up to kMaxClients. */
+    void acceptClients();
+
+    /** @brief Reads from a client and answers its request once complete. */
+    void readClient(Client& client);
+
+    /** @brief Queues the response to a complete request header. */
+    void respond(Client& client);
+
+    /** @brief Sends as much of a client's output as the socket accepts. */
+    void writeClient(Client& client);
+
+    /** @brief Adds the frame in 'frame' to the zone statistics. */
+    void aggregateFrame();
+
+    /** @brief Serializes the frame in 'frame' as one SSE message into 'message'. */
+    void formatFrame();
+
+    /** @brief Wakes the server thread's poll() (non-blocking write). */
+    void wake();
+
+    int listenFd = -1;        ///< Listening socket
+    int wakeFds[2] = {-1, -1}; ///< Self-pipe: submit() and the destructor write, poll() reads
+    uint16_t listenPort = 0;  ///< Port bound by the constructor
+    std::atomic<bool> stopping{false}; ///< Set by the destructor
+
+    mutable std::mutex mailboxMutex;            ///< Guards the mailbox fields below
+    std::vector<ChronoProfiler::Event> mailbox; ///< Latest frame not yet picked up
+    std::vector<ChronoProfiler::ThreadName> mailboxNames; ///< Its thread names
+    uint64_t mailboxStartTicks = 0;             ///< Its start tick
+    uint64_t mailboxIndex = 0;                  ///< Its sequential frame number
+    bool mailboxFull = false;                   ///< A frame is waiting
+    uint64_t nextFrameIndex = 0;                ///< Number of the next submitted frame
+    uint64_t dropped = 0;                       ///< Frames replaced before pickup
+
+    // Server-thread-only state
+    std::vector<ChronoProfiler::Event> frame;   ///< Frame being aggregated and serialized
+    std::vector<ChronoProfiler::ThreadName> frameNames; ///< Its thread names, sorted by ID
+    uint64_t frameStartTicks = 0;               ///< Its start tick
+    uint64_t frameIndex = 0;                    ///< Its sequential frame number
+    std::vector<Client> clients;                ///< Open connections
+    std::unordered_map<uint16_t, ZoneStats> zoneStats; ///< By zone name ID
+    uint64_t framesAggregated = 0;              ///< Frames included in zoneStats
+    std::vector<std::pair<uint16_t, ZoneStats>> topZones; ///< Scratch for sorting
+    std::string message;                        ///< Serialized SSE message
+
+    std::thread serverThread; ///< Background server (started last)
+};
+
+#endif // defined(PROFILER)
@@ -18,65 +18,295 @@
  * instrumented with PROFILE_SCOPE(name). It is designed for minimal overhead and
  * thread-safe operation in multi-threaded engines (graphics/game/simulation).
  *
- * @note Optional features include thread naming, zone colors/categories, ring-buffer
- * limits, and JSON export for offline analysis.
+ * @note Optional features include thread naming, zone colors/categories, lock-free
+ * per-thread ring buffers with overflow counters, counter/gauge tracks, and JSON
+ * export for offline analysis.
  */
 
 // ----------------------------- //
 // Includes — Each one explained //
 // ----------------------------- //
-#include <chrono>        ///< High-resolution timers (std::chrono::high_resolution_clock)
-#include <string>        ///< std::string used for thread names and zone categories
-#include <string_view>   ///< std::string_view for lightweight zone names
+#include <bit>           ///< std::bit_cast for gauge values stored in Event
+#include <chrono>        ///< Monotonic timers (std::chrono::steady_clock)
+#include <string>        ///< std::string used for thread names and interned strings
+#include <string_view>   ///< std::string_view for lightweight zone names and categories
+#include <span>          ///< std::span views over merged frame events
+#include <type_traits>   ///< std::is_trivially_copyable_v check on Event
 #include <vector>        ///< Dynamic arrays used for storing profiling events
-#include <thread>        ///< std::this_thread::get_id to identify threads
 #include <mutex>         ///< std::mutex to safely merge thread-local data
-#include <unordered_map> ///< Map thread IDs to human-readable thread names
+#include <unordered_map> ///< Map interned strings to their IDs
 #include <atomic>        ///< Atomic counters for defensive tracking of event counts
+#include <array>         ///< Fixed-capacity storage for per-thread ring buffers
+#include <memory>        ///< std::unique_ptr ownership of registered thread buffers
 #include <cstdint>
 
+class ChronoTraceWriter;
+class ChronoLiveServer;
+
 /**
  * @class ChronoProfiler
  * @brief A real-time CPU profiler with per-thread, zone-based event recording.
  *
- * Use PROFILE_SCOPE("name") to mark any block of code for timing. The profiler
- * stores events in thread-local buffers during the frame, then merges them at
- * endFrame() for visualization or export.
+ * Use PROFILE_SCOPE("name") to mark any block of code for timing. Each thread
+ * publishes completed zones into its own single-producer/single-consumer ring
+ * buffer; endFrame() drains every ring without blocking the producers.
  *
  * Optional enhancements:
  *  - Thread names for clearer timeline display
  *  - Zone colors/categories for visualization grouping
- *  - Preallocated ring buffers to limit memory usage
+ *  - Fixed-capacity ring buffers with per-thread overflow counters
  *  - JSON export for offline profiling sessions
  */
 class ChronoProfiler {
 public:
     /**
      * @struct Event
-     * @brief Stores timing information for a single code zone.
+     * @brief Fixed-size, trivially-copyable record of a single code zone.
+     *
+     * Timestamps are raw clock ticks captured when the zone begins and ends;
+     * convert them with ticksToMs() only when displaying or exporting. The zone
+     * name and category are 16-bit IDs into the global string table (see
+     * internString()/getString()), so recording an event never copies or
+     * allocates a string. PROFILE_SCOPE resolves those IDs once per call site
+     * (see ZoneDescriptor); storing IDs rather than descriptor pointers keeps
+     * the record meaningful in trace and capture files. Nesting is captured as
+     * the zone's depth on its thread; endFrame() resolves the enclosing zone
+     * into parentIndex.
      *
-     * This struct is created when a zone begins (startMs) and completed when
-     * it ends (durationMs). It contains optional metadata for visualization.
+     * Counter and gauge samples (see counter() and plot()) travel in the same
+     * record: 'flags' marks them, 'startTicks' is the sample time and
+     * 'endTicks' holds the value instead of an end tick. They are never
+     * nested (depth 0, parentIndex -1).
      */
     struct Event {
-        std::string_view name; ///< Zone name (caller-owned string literal preferred)
-        double startMs;        ///< Timestamp relative to frame start
-        double durationMs;     ///< Duration of the zone in milliseconds
-        uint32_t threadId;     ///< Numeric ID representing the thread
-
-        // Optional visualization metadata
-        uint32_t color;        ///< RGBA color for UI display of this zone
-        std::string category;  ///< Optional grouping/category for zones
+        /** @brief 'flags' bit: counter sample, endTicks holds an int64_t. */
+        static constexpr uint16_t kFlagCounter = 1u << 0;
+        /** @brief 'flags' bit: gauge sample, endTicks holds a double's bits. */
+        static constexpr uint16_t kFlagPlot = 1u << 1;
+        /**
+         * @brief 'flags' bits: allocation tally of the zone 'nameId' (count or bytes).
+         *
+         * Only seen inside the rings, together with kFlagCounter; endFrame()
+         * renames them to the zone's kAllocCountPrefix / kAllocBytesPrefix
+         * counters before the frame is published.
+         */
+        static constexpr uint16_t kFlagAllocCount = 1u << 2;
+        static constexpr uint16_t kFlagAllocBytes = 1u << 3;
+
+        uint64_t startTicks; ///< Raw clock ticks when the zone started
+        uint64_t endTicks;   ///< Raw clock ticks when the zone ended (value for samples)
+        uint32_t threadId;   ///< Numeric ID representing the thread
+        int32_t parentIndex; ///< Index of the enclosing zone in getEvents(), or -1
+        uint16_t nameId;     ///< Interned zone name
+        uint16_t categoryId; ///< Interned category (0 = none)
+        uint16_t depth;      ///< Number of zones open on this thread when it started
+        uint16_t flags;      ///< kFlagCounter / kFlagPlot, 0 for zones
+
+        /** @brief True for counter and gauge samples, false for zones. */
+        bool isValue() const { return (flags & (kFlagCounter | kFlagPlot)) != 0; }
+
+        /** @brief Sample value (counter total or gauge reading); 0 for zones. */
+        double value() const {
+            if (flags & kFlagPlot)
+                return std::bit_cast<double>(endTicks);
+            return (flags & kFlagCounter) ? static_cast<double>(static_cast<int64_t>(endTicks)) : 0.0;
+        }
+
+        /** @brief Inclusive duration of the zone in milliseconds (0 for samples). */
+        double durationMs() const {
+            return isValue() ? 0.0 : ChronoProfiler::ticksToMs(endTicks - startTicks);
+        }
+    };
+
+    static_assert(sizeof(Event) == 32, "Event should stay a compact 32-byte record");
+    static_assert(std::is_trivially_copyable_v<Event>, "Event must be trivially copyable");
+
+    /**
+     * @struct ZoneDescriptor
+     * @brief Compile-time description of one PROFILE_SCOPE call site.
+     *
+     * PROFILE_SCOPE declares one 'static constexpr' descriptor per call site, so
+     * the name, source location, color and category cost nothing at runtime.
+     * The macro fills in the file and line; the remaining fields are the macro
+     * arguments in order.
+     */
+    struct ZoneDescriptor {
+        std::string_view file;          ///< Source file of the call site (__FILE__)
+        uint32_t line;                  ///< Source line of the call site (__LINE__)
+        std::string_view name;          ///< Zone name
+        uint32_t color = 0x64C8FFFF;    ///< RGBA color stored with the name
+        std::string_view category = {}; ///< Optional category for grouping
+    };
+
+    /**
+     * @class ZoneSite
+     * @brief Per-call-site registration slot paired with a ZoneDescriptor.
+     *
+     * Caches the interned name and category IDs of its descriptor. They are
+     * resolved the first time the zone is entered; afterwards entering the zone
+     * is a single relaxed load and never touches a string. The constructor is
+     * constexpr, so a function-local 'static constinit' ZoneSite needs no
+     * initialization guard.
+     */
+    class ZoneSite {
+    public:
+        /** @brief Binds the site to its descriptor, which must outlive it. */
+        constexpr explicit ZoneSite(const ZoneDescriptor& descriptor) : desc(descriptor) {}
+
+        ZoneSite(const ZoneSite&) = delete;
+        ZoneSite& operator=(const ZoneSite&) = delete;
+
+        /** @brief The call site's descriptor. */
+        const ZoneDescriptor& descriptor() const { return desc; }
+
+    private:
+        friend class ChronoProfiler;
+
+        const ZoneDescriptor& desc;   ///< Static descriptor of the call site
+        std::atomic<uint32_t> ids{0}; ///< (categoryId << 16) | nameId, 0 until resolved
+    };
+
+    /**
+     * @brief Thread ID of the GPU timeline.
+     *
+     * GPU zones (see GpuProfiler) are reported as events on this pseudo-thread,
+     * so viewers show them as a separate "GPU" track next to the CPU threads.
+     */
+    static constexpr uint32_t kGpuThreadId = 0xFFFFFFFFu;
+
+    /**
+     * @brief Thread ID of the counter track.
+     *
+     * endFrame() reports every counter and gauge sample on this pseudo-thread,
+     * named "Counters", whichever thread recorded it.
+     */
+    static constexpr uint32_t kCounterThreadId = 0xFFFFFFFEu;
+
+    /**
+     * @brief Returned by currentThreadId() once the calling thread has begun exiting.
+     *
+     * Never appears in events and cannot be named.
+     */
+    static constexpr uint32_t kExitedThreadId = 0xFFFFFFFDu;
+
+    /**
+     * @brief Number of dense thread IDs that can carry a name.
+     *
+     * Threads are numbered 0, 1, 2, ... in the order they first touch the
+     * profiler. An exited thread's ID is reused by a later thread once its
+     * last events have been merged, so IDs stay below the peak number of
+     * threads alive at the same time, however many come and go. Only threads
+     * beyond this many alive at once record events but report as
+     * "<unnamed>". The reserved pseudo-thread IDs above are far outside the
+     * dense range.
+     */
+    static constexpr uint32_t kMaxNamedThreads = 4096;
+
+    /**
+     * @struct ThreadOverflow
+     * @brief Number of events a thread had to drop because its ring was full.
+     */
+    struct ThreadOverflow {
+        uint32_t threadId; ///< Numeric ID of the producing thread
+        uint64_t dropped;  ///< Events discarded since the thread registered
+    };
+
+    /**
+     * @struct CapturePolicy
+     * @brief Decides which frames endFrame() publishes.
+     *
+     * Zones are always recorded into the per-thread rings (that part is a few
+     * nanoseconds per zone); the policy only decides whether a frame is
+     * merged, handed to the active trace and reported by isFrameCaptured().
+     * Frames that are not captured are discarded without sorting or copying.
+     *
+     * - Continuous: every frame.
+     * - EveryNth: one frame out of 'interval'.
+     * - Random: each frame independently with probability 'sampleRate'.
+     * - Triggered: only frames longer than 'triggerMs'. The last
+     *   'preTriggerFrames' frames are kept in a flight recorder and written
+     *   to the trace ahead of the triggering frame, so the lead-up to a hitch
+     *   is captured too.
+     */
+    struct CapturePolicy {
+        /** @brief Capture strategy. */
+        enum class Mode {
+            Continuous, ///< Capture every frame
+            EveryNth,   ///< Capture one frame out of 'interval'
+            Random,     ///< Capture frames with probability 'sampleRate'
+            Triggered   ///< Capture frames slower than 'triggerMs' plus a flight recorder
+        };
+
+        Mode mode = Mode::Continuous; ///< Active strategy
+        uint32_t interval = 1;        ///< EveryNth: capture period in frames
+        double sampleRate = 1.0;      ///< Random: probability in [0, 1]
+        double triggerMs = 0.0;       ///< Triggered: frame time threshold in milliseconds
+        uint32_t preTriggerFrames = 0; ///< Triggered: frames kept before the trigger (K)
+
+        /** @brief Capture every frame. */
+        static CapturePolicy continuous() { return {}; }
+
+        /** @brief Capture one frame out of n (n = 0 is treated as 1). */
+        static CapturePolicy everyNth(uint32_t n) {
+            CapturePolicy policy;
+            policy.mode = Mode::EveryNth;
+            policy.interval = n ? n : 1;
+            return policy;
+        }
+
+        /** @brief Capture each frame with the given probability. */
+        static CapturePolicy random(double rate) {
+            CapturePolicy policy;
+            policy.mode = Mode::Random;
+            policy.sampleRate = rate;
+            return policy;
+        }
+
+        /**
+         * @brief Capture frames slower than a threshold.
+         * @param thresholdMs Frame time (beginFrame() to endFrame()) that triggers a capture
+         * @param framesBefore Number of preceding frames kept in the flight recorder
+         */
+        static CapturePolicy triggered(double thresholdMs, uint32_t framesBefore) {
+            CapturePolicy policy;
+            policy.mode = Mode::Triggered;
+            policy.triggerMs = thresholdMs;
+            policy.preTriggerFrames = framesBefore;
+            return policy;
+        }
+
+        /**
+         * @brief Parses a policy from text, e.g. an environment variable.
+         *
+         * Accepted forms: "continuous", "every:N", "random:RATE" and
+         * "trigger:MS[:K]".
+         *
+         * @param spec Policy description
+         * @param policy Receives the parsed policy on success
+         * @return False (leaving 'policy' unchanged) if 'spec' is malformed
+         */
+        static bool parse(std::string_view spec, CapturePolicy& policy);
     };
 
     // ----------------------- //
     // Frame lifecycle methods //
     // ----------------------- //
 
+    /**
+     * @brief Prepares the profiler clock; call once at startup, before the first frame.
+     *
+     * Selects the tick source and, with the invariant TSC, spins for up to
+     * 10 ms to get a first tick-period estimate, so that cost is paid here
+     * rather than inside the first endFrame(). Later frames only refine the
+     * estimate and never wait. Calling it again does nothing.
+     */
+    static void init();
+
     /**
      * @brief Starts a new profiling frame.
      *
-     * Clears the previous frame's merged events and stores the reference start time.
+     * Stores the reference start time; the previous captured frame stays
+     * available from getEvents().
      * Call this once per frame, typically at the beginning of your render/update loop.
      */
     static void beginFrame();
@@ -84,12 +314,38 @@ public:
     /**
      * @brief Ends the current profiling frame.
      *
-     * Merges all thread-local events from all threads into a global frameEvents vector.
-     * Only here is a lock required (mergeMutex), ensuring minimal overhead during
-     * normal profiling.
+     * Drains every thread's ring buffer. If the capture policy selects the
+     * frame, its events replace the global frameEvents vector and go to the
+     * active trace; otherwise they are discarded or kept in the flight
+     * recorder (see CapturePolicy). Producers are never blocked: the rings are
+     * lock-free, and mergeMutex only serializes consumers and thread registration.
+     *
+     * Each thread's events are ordered by start time (parents before children)
+     * and linked to their enclosing zone, see linkZones().
      */
     static void endFrame();
 
+    /**
+     * @brief Selects which frames are captured from the next endFrame() on.
+     *
+     * Resets the frame counter used by EveryNth and empties the flight recorder.
+     *
+     * @param policy New capture policy
+     */
+    static void setCapturePolicy(const CapturePolicy& policy);
+
+    /** @brief Returns the active capture policy. */
+    static CapturePolicy getCapturePolicy();
+
+    /**
+     * @brief Whether the most recent endFrame() captured its frame.
+     *
+     * When true, getEvents() holds that frame; when false getEvents() still
+     * holds the previous captured frame. Use it to gate per-frame consumers
+     * such as ProfilerUI::update().
+     */
+    static bool isFrameCaptured();
+
     // -------------------- //
     // Zone instrumentation //
     // -------------------- //
@@ -98,40 +354,287 @@ public:
      * @brief Marks the start of a profiling zone.
      *
      * Normally called internally via ScopedZone/PROFILE_SCOPE. Records start
-     * timestamp, thread ID, and optional color/category.
+     * timestamp, thread ID, and optional color/category on the thread's stack
+     * of open zones. Nothing is published until the zone ends.
+     *
+     * The name and category are interned on first use; later calls with the
+     * same string literal hit a per-thread cache and never touch the global table.
      *
      * @param name Zone name
-     * @param color Optional RGBA color (default: cyan-ish)
+     * @param color Optional RGBA color (default: cyan-ish), stored with the name
      * @param category Optional category string for visualization grouping
      */
-    static void pushEventStart(std::string_view name, uint32_t color = 0x64C8FFFF, const std::string& category = "");
+    static void pushEventStart(std::string_view name, uint32_t color = 0x64C8FFFF, std::string_view category = {});
+
+    /**
+     * @brief Marks the start of a zone described at compile time.
+     *
+     * Used by PROFILE_SCOPE. The first call registers the site's descriptor
+     * (interning its name and category and remembering it as the name's
+     * source); later calls reuse the IDs cached in the site.
+     *
+     * @param site Registration slot of the call site
+     */
+    static void pushEventStart(ZoneSite& site);
 
     /**
      * @brief Ends the most recent profiling zone on this thread.
      *
-     * Calculates duration, offsets startMs relative to frameStart, and finalizes the event.
-     * Does nothing if there is no corresponding start (defensive check).
+     * Stamps the end tick and publishes the finished event to the thread's ring
+     * buffer. Does nothing if there is no corresponding start (defensive check).
      */
     static void pushEventEnd();
 
+    // ------------------------ //
+    // Counter and gauge tracks //
+    // ------------------------ //
+
+    /**
+     * @brief Adds to a per-frame counter.
+     *
+     * All increments of a counter during a frame, from any thread, are summed
+     * by endFrame() into one sample at the frame's start tick. Once a counter
+     * has been used it reports a sample (possibly 0) in every captured frame,
+     * so its track reads as "amount per frame".
+     *
+     * The increment travels through the calling thread's ring like a zone, so
+     * code that counts very often (e.g. per draw call) should accumulate
+     * locally and call this once per frame.
+     *
+     * @param name Counter name, e.g. "vk.drawCalls" (interned on first use)
+     * @param delta Amount to add
+     */
+    static void counter(std::string_view name, int64_t delta = 1);
+
+    /**
+     * @brief Records a gauge sample.
+     *
+     * Every sample is kept with its timestamp, e.g. for memory in use.
+     *
+     * @param name Gauge name, e.g. "gpu.memory.bytes" (interned on first use)
+     * @param value Current value
+     */
+    static void plot(std::string_view name, double value);
+
+    // ------------------- //
+    // Allocation tracking //
+    // ------------------- //
+
+    /** @brief Counter name prefix for the allocations made inside a zone. */
+    static constexpr std::string_view kAllocCountPrefix = "alloc.count/";
+
+    /** @brief Counter name prefix for the bytes allocated inside a zone. */
+    static constexpr std::string_view kAllocBytesPrefix = "alloc.bytes/";
+
+    /**
+     * @brief Turns attribution of heap allocations to zones on or off.
+     *
+     * Profiling builds replace the global operator new (see
+     * ChronoAllocHooks.cpp). While tracking is on, every allocation is
+     * charged to the innermost open zone of the allocating thread; when the
+     * zone ends, its totals become the counters "alloc.count/<zone>" and
+     * "alloc.bytes/<zone>". Allocations made outside any zone are not
+     * attributed. Off by default; when off, the hook costs one relaxed load.
+     *
+     * @param enabled True to start attributing allocations
+     */
+    static void setAllocationTracking(bool enabled);
+
+    /** @brief True while allocations are attributed to zones. */
+    static bool isAllocationTracking();
+
+    /**
+     * @brief Charges an allocation to the calling thread's innermost zone.
+     *
+     * Called by the operator new replacements. Never allocates and never
+     * takes a lock, so it is safe from inside operator new.
+     *
+     * @param bytes Requested size
+     */
+    static void recordAllocation(size_t bytes);
+
+    /**
+     * @brief Heap allocations charged to zones in the last captured frame.
+     *
+     * Sums every "alloc.count/<zone>" counter of getEvents(), i.e. every
+     * allocation made inside a zone on any thread. Once the caches have warmed
+     * up, a render loop whose work is all inside zones should report 0.
+     *
+     * @return Allocation count (0 while tracking is off)
+     */
+    static int64_t frameAllocationCount();
+
     // --------- //
     // Accessors //
     // --------- //
 
     /**
-     * @brief Returns merged events for the last completed frame.
+     * @brief Returns merged events for the last captured frame.
+     *
+     * Events are grouped by thread and, within a thread, ordered by start time,
+     * so every zone appears before the zones nested inside it. Counter and
+     * gauge samples (Event::isValue()) follow all zones.
      *
      * @return Reference to vector of Events. Do not store long-term!
      */
     static const std::vector<Event>& getEvents();
 
     /**
-     * @brief Retrieves a human-readable name for a thread ID.
+     * @struct ThreadName
+     * @brief Name a thread ID had when a frame was merged.
      *
-     * @param threadId Numeric thread ID
-     * @return String name if registered, else "<unnamed>"
+     * An exited thread's ID is reused by the next new thread, so a consumer
+     * that formats a frame later (trace writer, live server, ProfilerUI
+     * reporter) must not look the name up by ID at that point. It uses the
+     * names captured with the frame instead (see getThreadNames()).
+     */
+    struct ThreadName {
+        uint32_t threadId; ///< Event::threadId
+        uint16_t nameId;   ///< Interned name (0 = unnamed)
+    };
+
+    /**
+     * @brief Names of the threads in getEvents(), as they were when the frame was merged.
+     *
+     * @return One entry per thread ID in the frame, sorted by ID. Do not store long-term!
+     */
+    static std::span<const ThreadName> getThreadNames();
+
+    /**
+     * @brief Looks a thread up in a frame's name snapshot.
+     *
+     * @param names Snapshot from getThreadNames() (or a copy of it)
+     * @param threadId Thread ID of an event of that frame
+     * @return Name, or "<unnamed>" (valid for the lifetime of the process)
+     */
+    static std::string_view findThreadName(std::span<const ThreadName> names, uint32_t threadId);
+
+    /**
+     * @brief Adds events recorded on another timeline to the next endFrame().
+     *
+     * Used for zones that are not measured by PROFILE_SCOPE on a CPU thread,
+     * such as GPU timestamp queries. The events must already be expressed in
+     * profiler ticks (see nowTicks()) and carry their own threadId and depth;
+     * endFrame() appends them as one block and resolves their parents.
+     *
+     * @param events Completed events (copied)
+     */
+    static void submitEvents(std::span<const Event> events);
+
+    /**
+     * @brief Computes the exclusive (self) time of every event in a merged frame.
+     *
+     * Self time is the inclusive duration minus the durations of direct children.
+     *
+     * @param events Merged frame events, as returned by getEvents()
+     * @param selfTicks Output, resized to events.size(); entry i is the self time of events[i]
+     */
+    static void computeSelfTicks(std::span<const Event> events, std::vector<uint64_t>& selfTicks);
+
+    /** @brief Tick value captured by the most recent beginFrame(). */
+    static uint64_t getFrameStartTicks();
+
+    /**
+     * @brief Returns the current time in raw clock ticks (rdtsc or steady_clock).
+     *
+     * Exposed so other clocks (e.g. GPU timestamps) can be mapped onto the
+     * profiler timeline.
+     */
+    static uint64_t nowTicks();
+
+    /**
+     * @brief Converts a tick delta into milliseconds.
+     *
+     * Uses the calibrated tick period (see getMsPerTick()). This is the only
+     * place ticks become floating point; the capture path never converts.
+     *
+     * @param ticks Signed or unsigned tick difference
+     * @return Duration in milliseconds
+     */
+    static double ticksToMs(int64_t ticks);
+
+    /** @overload */
+    static double ticksToMs(uint64_t ticks) { return ticksToMs(static_cast<int64_t>(ticks)); }
+
+    /**
+     * @brief Length of one tick in milliseconds.
+     *
+     * With the invariant TSC the period is measured against steady_clock; the
+     * estimate is refined at each endFrame() until the measurement baseline
+     * reaches one second, then frozen. With steady_clock it is exact.
+     *
+     * @return Milliseconds per tick
+     */
+    static double getMsPerTick();
+
+    /** @brief True when timestamps come from the invariant TSC rather than steady_clock. */
+    static bool usesTsc();
+
+    // ------------- //
+    // String table  //
+    // ------------- //
+
+    /**
+     * @brief Interns a string and returns its 16-bit ID.
+     *
+     * Equal strings always receive the same ID. ID 0 is the empty string. When
+     * the table is full, new strings map to ID 0.
+     *
+     * @param text String to intern (copied on first use)
+     * @param color Color remembered for the string when it names a zone; only
+     *              the first registration sets it
+     * @return Stable ID valid for the lifetime of the process
+     */
+    static uint16_t internString(std::string_view text, uint32_t color = 0);
+
+    /**
+     * @brief Looks up an interned string without locking.
+     *
+     * @param id ID returned by internString()
+     * @return View of the interned string (valid for the lifetime of the process)
+     */
+    static std::string_view getString(uint16_t id);
+
+    /**
+     * @brief Color registered alongside an interned zone name.
+     *
+     * @param id ID returned by internString()
+     * @return RGBA color, or 0 when none was registered
+     */
+    static uint32_t getZoneColor(uint16_t id);
+
+    /**
+     * @brief Call site of the first PROFILE_SCOPE registered under a zone name.
+     *
+     * @param id ID returned by internString()
+     * @return The call site's descriptor, or nullptr when the name was never
+     *         entered through PROFILE_SCOPE
+     */
+    static const ZoneDescriptor* getZoneSource(uint16_t id);
+
+    /**
+     * @brief Dense ID of the calling thread.
+     *
+     * The ID belongs to the thread's ring, which the first call registers
+     * (see localBuffer()). A ring recycled from an exited thread keeps its
+     * ID, so no two live threads, and no two threads within one frame, ever
+     * share an ID. Later calls are a plain TLS load.
+     *
+     * @return ID stored in Event::threadId for this thread's events, or
+     *         kExitedThreadId if the thread is exiting
      */
-    static std::string getThreadName(uint32_t threadId);
+    static uint32_t currentThreadId();
+
+    /**
+     * @brief Retrieves a human-readable name for a thread ID without locking.
+     *
+     * Names live in an append-only registry indexed by thread ID that points
+     * into the interned string table, so lookups are two atomic loads.
+     *
+     * @param threadId Numeric thread ID (dense ID, kGpuThreadId or kCounterThreadId)
+     * @return Name if registered, else "<unnamed>" (valid for the lifetime of the process)
+     */
+    static std::string_view getThreadName(uint32_t threadId);
 
     /**
      * @brief Assigns a human-readable name to the calling thread.
@@ -142,6 +645,27 @@ public:
      */
     static void setThreadName(const std::string& name);
 
+    /**
+     * @brief Assigns a human-readable name to any thread ID.
+     *
+     * Names pseudo-threads such as kGpuThreadId that never call setThreadName().
+     *
+     * @param threadId Numeric thread ID
+     * @param name Thread name string
+     */
+    static void setThreadName(uint32_t threadId, const std::string& name);
+
+    /**
+     * @brief Returns the number of dropped events for every registered thread.
+     *
+     * A thread drops an event when its ring buffer is full or when zones are
+     * nested deeper than kMaxZoneDepth.
+     *
+     * @return One entry per thread that has recorded at least one zone and
+     *         whose ring has not been reclaimed after the thread exited
+     */
+    static std::vector<ThreadOverflow> getOverflowCounts();
+
     /**
      * @brief Exports the current profiling session to a JSON file.
      *
@@ -151,6 +675,48 @@ public:
      */
     static void exportToJSON(const std::string& filename);
 
+    /**
+     * @brief Starts streaming every subsequent frame to a capture file.
+     *
+     * Each endFrame() hands its merged events to a ChronoTraceWriter, which
+     * encodes and writes them on a background thread. Any trace already in
+     * progress is finished first.
+     *
+     * A filename ending in '.chrono' selects the compact binary format (convert
+     * it with 'chrono-convert'); anything else is written as Chrome Trace Event
+     * JSON (open in chrome://tracing or Perfetto).
+     *
+     * @param filename Path to the output file
+     * @return False if the file could not be opened
+     */
+    static bool beginTrace(const std::string& filename);
+
+    /**
+     * @brief Flushes and closes the trace started by beginTrace().
+     *
+     * Blocks until all queued frames are written. No-op without an active trace.
+     */
+    static void endTrace();
+
+    /**
+     * @brief Starts the live viewer server on 127.0.0.1.
+     *
+     * Each captured frame is handed to a ChronoLiveServer, which serializes it
+     * on its own thread and streams it to browsers connected to
+     * 'http://127.0.0.1:<port>/'. A server already running is stopped first.
+     *
+     * @param port TCP port to listen on
+     * @return False if the port could not be bound
+     */
+    static bool startLiveServer(uint16_t port);
+
+    /**
+     * @brief Stops the live viewer server and disconnects its viewers.
+     *
+     * No-op when no server is running.
+     */
+    static void stopLiveServer();
+
     // -------------------------------- //
     // RAII helper for scoped profiling //
     // -------------------------------- //
@@ -163,9 +729,11 @@ public:
      */
     class ScopedZone {
     public:
-        explicit ScopedZone(std::string_view name, uint32_t color = 0x64C8FFFF, const std::string& category = "") {
+        explicit ScopedZone(std::string_view name, uint32_t color = 0x64C8FFFF, std::string_view category = {}) {
             ChronoProfiler::pushEventStart(name, color, category);
         }
+        /** @brief Begins a zone registered at compile time (see PROFILE_SCOPE). */
+        explicit ScopedZone(ZoneSite& site) { ChronoProfiler::pushEventStart(site); }
         ~ScopedZone() { ChronoProfiler::pushEventEnd(); }
     };
 
@@ -207,46 +775,390 @@ private:
     // Internal state
     // --------------------
 
-    /** @brief Thread-local event list for each thread. */
-    static thread_local std::vector<Event> threadEvents;
+    static constexpr size_t kRingCapacity = 4096; ///< Events per thread ring (power of two)
+    static constexpr size_t kMaxZoneDepth = 64;   ///< Maximum nesting of open zones per thread
+    static constexpr size_t kStringPageSize = 256; ///< Interned strings per string-table page
+    static constexpr size_t kMaxStrings = 65536;   ///< Capacity of the 16-bit string table
+    static constexpr size_t kNameCacheSize = 256;  ///< Per-thread name cache slots (power of two)
+
+    static_assert((kRingCapacity & (kRingCapacity - 1)) == 0, "kRingCapacity must be a power of two");
+
+    /**
+     * @class ThreadBuffer
+     * @brief Fixed-capacity single-producer/single-consumer ring of finished events.
+     *
+     * The owning thread is the only producer and endFrame() is the only consumer.
+     * Head and tail sit on separate cache lines and are published with
+     * acquire/release ordering, so neither side ever takes a lock.
+     *
+     * Buffers are owned by the profiler, not by their thread. When the thread
+     * exits it only marks its buffer 'retired'; the next endFrame() drains the
+     * remaining events and moves the buffer to a free pool, from which the
+     * next new thread takes it (see localBuffer()).
+     */
+    class ThreadBuffer {
+    public:
+        explicit ThreadBuffer(uint32_t threadId) : threadId(threadId) {}
+
+        /**
+         * @brief Hands a recycled buffer, and its thread ID, to a new thread.
+         *
+         * Called with mergeMutex held, after the buffer was fully drained.
+         */
+        void reset() {
+            overflowCount.store(0, std::memory_order_relaxed);
+            openCount = 0;
+            openAllocs.fill({});
+            cachedTail = tail.load(std::memory_order_relaxed);
+            retired.store(false, std::memory_order_relaxed);
+            reclaimable = false;
+        }
+
+        /** @brief Producer side: append an event, or count it as dropped if full. */
+        void push(const Event& evt) {
+            const size_t h = head.load(std::memory_order_relaxed);
+            if (h - cachedTail >= kRingCapacity) {
+                // Only re-read the consumer's cache line when the ring looks full
+                cachedTail = tail.load(std::memory_order_acquire);
+                if (h - cachedTail >= kRingCapacity) {
+                    overflowCount.fetch_add(1, std::memory_order_relaxed);
+                    return;
+                }
+            }
+            events[h & (kRingCapacity - 1)] = evt;
+            head.store(h + 1, std::memory_order_release);
+        }
+
+        /**
+         * @brief Consumer side: hand every published event to fn, then free the slots.
+         *
+         * Sets 'reclaimable' when the owning thread had already exited: its
+         * last events were published before 'retired', so the ring is now empty
+         * for good.
+         */
+        template <typename Fn>
+        void drain(Fn&& fn) {
+            const bool wasRetired = retired.load(std::memory_order_acquire); // Before head
+            size_t t = tail.load(std::memory_order_relaxed);
+            const size_t h = head.load(std::memory_order_acquire);
+            for (; t != h; ++t) {
+                fn(events[t & (kRingCapacity - 1)]);
+            }
+            tail.store(t, std::memory_order_release);
+            reclaimable = wasRetired;
+        }
+
+        const uint32_t threadId;                 ///< Dense ID, reused with the buffer
+        std::atomic<uint64_t> overflowCount{0};  ///< Events dropped by this thread
+        std::atomic<bool> retired{false};        ///< Owning thread has exited
+        bool reclaimable = false;                ///< Consumer-only: retired and drained
+
+        // Producer-only state: zones that have started but not yet ended.
+        std::array<Event, kMaxZoneDepth> openZones; ///< Stack of open zones
+        size_t openCount = 0;                       ///< Current nesting depth
+
+        /** @brief Allocations charged to one open zone (see recordAllocation()). */
+        struct AllocTally {
+            uint64_t count = 0; ///< Allocations
+            uint64_t bytes = 0; ///< Bytes requested
+        };
+        std::array<AllocTally, kMaxZoneDepth> openAllocs{}; ///< Parallel to openZones
+        size_t cachedTail = 0;                      ///< Producer's last view of tail
+
+        /** @brief Producer-only cache mapping string literal addresses to interned IDs. */
+        struct NameCacheEntry {
+            const char* data = nullptr;
+            size_t size = 0;
+            uint16_t id = 0;
+        };
+        std::array<NameCacheEntry, kNameCacheSize> nameCache; ///< Direct-mapped by address
+
+        /** @brief Interns text through the name cache, falling back to internString(). */
+        uint16_t intern(std::string_view text, uint32_t color);
+
+    private:
+        std::array<Event, kRingCapacity> events;  ///< Ring storage
+        alignas(64) std::atomic<size_t> head{0};  ///< Next slot to write (producer)
+        alignas(64) std::atomic<size_t> tail{0};  ///< Next slot to read (consumer)
+    };
+
+    /**
+     * @brief Returns the calling thread's ring, registering it on first use.
+     *
+     * @return The ring, or nullptr once the thread has begun exiting (its
+     *         ring may already belong to another thread)
+     */
+    static ThreadBuffer* localBuffer();
+
+    /** @brief Slow path of localBuffer(): registers the thread's ring on its first zone. */
+    static ThreadBuffer* registerThreadBuffer();
+
+    /**
+     * @brief The calling thread's ring, or nullptr before its first zone.
+     *
+     * Constant-initialized, so reading it never runs a TLS guard or
+     * allocates (recordAllocation() reads it from inside operator new).
+     */
+    static thread_local ThreadBuffer* threadBuffer;
+
+    /**
+     * @brief Turns an allocation tally from a ring into the zone's counter.
+     *
+     * Interns "alloc.count/<zone>" or "alloc.bytes/<zone>" on first use.
+     *
+     * @param evt Tally with kFlagAllocCount or kFlagAllocBytes
+     * @return Counter sample named after the zone
+     *
+     * @note Called with mergeMutex held.
+     */
+    static Event renameAllocation(Event evt);
+
+    /**
+     * @struct ThreadExitHook
+     * @brief thread_local whose destructor retires the thread's ring at thread exit.
+     */
+    struct ThreadExitHook {
+        ThreadBuffer** buffer = nullptr; ///< The thread's cached ring pointer
+        bool* exited = nullptr;          ///< Set once the ring is retired
+        ~ThreadExitHook();
+    };
+
+    /**
+     * @brief Moves drained rings of exited threads to freeThreadBuffers.
+     *
+     * @note Called with mergeMutex held, after every ring was drained.
+     */
+    static void recycleThreadBuffers();
+
+    /**
+     * @brief Drains every thread ring and the submitted events into one frame.
+     *
+     * @param events Destination, cleared first
+     * @param threadNames Receives the names of the frame's threads
+     */
+    static void mergeFrame(std::vector<Event>& events, std::vector<ThreadName>& threadNames);
+
+    /**
+     * @brief Records the current name of every thread ID in a merged frame.
+     *
+     * @param events Merged frame
+     * @param threadNames Destination, cleared first; sorted by thread ID
+     */
+    static void snapshotThreadNames(std::span<const Event> events,
+                                    std::vector<ThreadName>& threadNames);
+
+    /**
+     * @brief Orders and links one thread's events in a merged frame.
+     *
+     * Sorts events[first, end) by start tick and fills in parentIndex from
+     * the recorded depths.
+     *
+     * @param events Frame being merged
+     * @param first Index of the first event drained from the thread
+     */
+    static void linkZones(std::vector<Event>& events, size_t first);
+
+    /**
+     * @brief Appends the frame's counter totals and gauge samples.
+     *
+     * Consumes valueEvents. Counters seen in earlier frames but not in this
+     * one report 0.
+     *
+     * @param events Frame being merged
+     */
+    static void appendValues(std::vector<Event>& events);
+
+    /** @brief Publishes a counter or gauge sample to the calling thread's ring. */
+    static void pushValue(std::string_view name, uint16_t flags, uint64_t bits);
+
+    /** @brief Pushes an open zone with resolved IDs onto a thread's zone stack. */
+    static void openZone(ThreadBuffer& buffer, uint16_t nameId, uint16_t categoryId);
+
+    /** @brief Interns a site's descriptor, records it as the name's source and caches the IDs. */
+    static uint32_t registerZone(ZoneSite& site);
+
+    /**
+     * @struct InternedString
+     * @brief One string-table entry: the owned text plus an optional zone color.
+     */
+    struct InternedString {
+        std::string text;
+        uint32_t color = 0;
+        std::atomic<const ZoneDescriptor*> source{nullptr}; ///< First PROFILE_SCOPE site, if any
+    };
+
+    /** @brief Fixed-size block of string-table entries; never moves once published. */
+    struct StringPage {
+        std::array<InternedString, kStringPageSize> entries;
+    };
+
+    /** @brief Published string-table pages, readable without locking. */
+    static std::array<std::atomic<StringPage*>, kMaxStrings / kStringPageSize> stringPages;
 
-    static constexpr size_t kMaxEventsPerThread = 1024; ///< Optional ring buffer limit
+    /** @brief Owns the string-table pages. Guarded by stringTableMutex. */
+    static std::vector<std::unique_ptr<StringPage>> ownedStringPages;
+
+    /** @brief Lookup from text to ID. Keys view the owned page strings. */
+    static std::unordered_map<std::string_view, uint16_t> stringIds;
+
+    /** @brief Number of IDs handed out so far (ID 0 is the empty string). */
+    static size_t stringCount;
+
+    /** @brief Mutex serializing insertions into the string table. */
+    static std::mutex stringTableMutex;
 
     /** @brief Final merged events for the current frame. */
     static std::vector<Event> frameEvents;
 
-    /** @brief Mapping from thread IDs to human-readable names. */
-    static std::unordered_map<uint32_t, std::string> threadNames;
+    /** @brief Names of the threads in frameEvents, captured by the merge. */
+    static std::vector<ThreadName> frameThreadNames;
+
+    /** @brief Dense thread ID of the next newly allocated ring (guarded by mergeMutex). */
+    static uint32_t nextThreadId;
 
-    /** @brief Mutex protecting access to threadNames map. */
-    static std::mutex threadNamesMutex;
+    /** @brief Interned name of each dense thread ID (0 = unnamed). */
+    static std::array<std::atomic<uint16_t>, kMaxNamedThreads> threadNameIds;
 
-    /** @brief Mutex protecting merging of thread-local events into frameEvents. */
+    /** @brief Interned names of the kGpuThreadId and kCounterThreadId pseudo-threads. */
+    static std::atomic<uint16_t> gpuThreadNameId;
+    static std::atomic<uint16_t> counterThreadNameId;
+
+    /** @brief Registry slot holding a thread's name, or nullptr if it cannot be named. */
+    static std::atomic<uint16_t>* threadNameSlot(uint32_t threadId);
+
+    /** @brief Mutex serializing consumers (merge/clear) and thread registration. */
     static std::mutex mergeMutex;
 
-    /** @brief Frame start timestamp. */
-    static std::chrono::high_resolution_clock::time_point frameStart;
+    /** @brief Frame start timestamp in raw ticks. */
+    static uint64_t frameStartTicks;
+
+    /** @brief Start tick of the frame held in frameEvents (the last captured one). */
+    static uint64_t capturedFrameStartTicks;
+
+    /**
+     * @struct TickBaseline
+     * @brief Tick source and the TSC/steady_clock reading pair used for calibration.
+     */
+    struct TickBaseline {
+        bool tsc;                                     ///< nowTicks() reads the invariant TSC
+        uint64_t tscTicks;                            ///< TSC when the baseline was taken
+        std::chrono::steady_clock::time_point steady; ///< steady_clock at the same moment
+    };
+
+    /**
+     * @brief The baseline, taken on first use.
+     *
+     * A function-local static rather than a namespace-scope one, so a zone
+     * running during another translation unit's static initialization never
+     * reads it before it is set.
+     */
+    static const TickBaseline& tickBaseline();
+
+    /** @brief Current milliseconds-per-tick estimate (0 until first calibrated; constinit). */
+    static std::atomic<double> msPerTick;
+
+    /** @brief Set once the calibration baseline is long enough to stop refining (constinit). */
+    static std::atomic<bool> tickCalibrationFrozen;
+
+    /**
+     * @brief Re-measures msPerTick against steady_clock unless frozen.
+     *
+     * @param wait Spin until the baseline reaches 10 ms (init() only); otherwise
+     *        a baseline that short is left alone.
+     */
+    static void calibrateTicks(bool wait);
+
+    /** @brief Owns every registered thread ring for multi-threaded merging. */
+    static std::vector<std::unique_ptr<ThreadBuffer>> allThreadBuffers;
+
+    /** @brief Rings of exited threads, ready for reuse (guarded by mergeMutex). */
+    static std::vector<std::unique_ptr<ThreadBuffer>> freeThreadBuffers;
+
+    /** @brief One frame kept by the Triggered policy's flight recorder. */
+    struct RecordedFrame {
+        uint64_t startTicks = 0;   ///< Frame start tick
+        std::vector<Event> events; ///< Merged events (capacity reused)
+        std::vector<ThreadName> threadNames; ///< Names as of the merge
+    };
+
+    /** @brief Applies the capture policy to a frame ending at frameEndTicks. */
+    static bool shouldCapture(uint64_t frameEndTicks);
+
+    /** @brief Active capture policy (guarded by mergeMutex). */
+    static CapturePolicy capturePolicy;
+
+    /** @brief Frames ended since the policy was set (guarded by mergeMutex). */
+    static uint64_t policyFrameCount;
+
+    /** @brief Ring of the last preTriggerFrames frames (guarded by mergeMutex). */
+    static std::vector<RecordedFrame> flightRecorder;
+
+    /** @brief Next flight recorder slot and number of valid slots. */
+    static size_t flightRecorderNext;
+    static size_t flightRecorderCount;
+
+    /** @brief Result of the last endFrame(), readable from any thread. */
+    static std::atomic<bool> frameCaptured;
+
+    /** @brief Samples drained by mergeFrame(), reused every frame (guarded by mergeMutex). */
+    static std::vector<Event> valueEvents;
+
+    /** @brief Per zone name ID: interned count and bytes counter IDs (guarded by mergeMutex). */
+    static std::vector<std::array<uint16_t, 2>> allocCounterNames;
 
-    /** @brief Returns high-resolution current time in milliseconds. */
-    static double nowMs();
+    /** @brief Set by setAllocationTracking(). */
+    static std::atomic<bool> allocationTracking;
 
-    /** @brief Total event counter to prevent runaway event generation. */
-    static std::atomic<size_t> totalEventCount;
+    /** @brief Name IDs of every counter seen so far, sorted (guarded by mergeMutex). */
+    static std::vector<uint16_t> counterIds;
 
-    /** @brief Stores all thread-local buffers for multi-threaded merging. */
-    static std::vector<std::vector<Event>*> allThreadBuffers;
+    /** @brief Per-frame totals, parallel to counterIds (guarded by mergeMutex). */
+    static std::vector<int64_t> counterTotals;
+
+    /** @brief Events from submitEvents() awaiting the next endFrame() (guarded by mergeMutex). */
+    static std::vector<Event> submittedEvents;
+
+    /** @brief Active streaming trace, if any (guarded by mergeMutex). */
+    static std::unique_ptr<ChronoTraceWriter> traceWriter;
+
+    /** @brief Live viewer server, if running (guarded by mergeMutex). */
+    static std::unique_ptr<ChronoLiveServer> liveServer;
 };
 
 /**
- * @def PROFILE_SCOPE(name)
+ * @def PROFILER_CONCAT(a, b)
+ * @brief Pastes two tokens after macro-expanding them (so __LINE__ becomes a number).
+ */
+#define PROFILER_CONCAT_INNER(a, b) a##b
+#define PROFILER_CONCAT(a, b) PROFILER_CONCAT_INNER(a, b)
+
+/**
+ * @def PROFILE_SCOPE(name, color, category)
  * @brief Profiles a scope automatically using RAII.
  *
+ * Declares a 'static constexpr' ZoneDescriptor and a 'static constinit'
+ * ZoneSite for the call site, then a ScopedZone bound to them. Color and
+ * category are optional. Every argument must be a constant expression; use
+ * ChronoProfiler::ScopedZone directly for names built at runtime. Identifiers
+ * are suffixed with the line number, so several scopes may share a block
+ * (but not a line).
+ *
  * Usage:
  * @code
  * PROFILE_SCOPE("Physics Update");
+ * PROFILE_SCOPE("Upload", 0xFF8040FF, "GPU");
  * @endcode
  */
-#define PROFILE_SCOPE(name) ChronoProfiler::ScopedZone _scope_##__LINE__(name)
+#define PROFILE_SCOPE(...) \
+    PROFILE_SCOPE_AT(PROFILER_CONCAT(_chronoZone, __LINE__), __VA_ARGS__)
+
+/** @brief Implementation of PROFILE_SCOPE with the per-line identifier 'var'. */
+#define PROFILE_SCOPE_AT(var, ...)                                                          \
+    static constexpr ChronoProfiler::ZoneDescriptor PROFILER_CONCAT(var, Desc){            \
+        __FILE__, __LINE__, __VA_ARGS__};                                                   \
+    static constinit ChronoProfiler::ZoneSite PROFILER_CONCAT(var, Site){                   \
+        PROFILER_CONCAT(var, Desc)};                                                        \
+    ChronoProfiler::ScopedZone var(PROFILER_CONCAT(var, Site))
 
 // ---------------- END REAL PROFILER IMPLEMENTATION ---------------- //
 
@@ -264,7 +1176,9 @@ private:
 // + Ensures symbols still exist so linking never breaks                   //
 // ----------------------------------------------------------------------- //
 
+#include <bit>
 #include <vector>
+#include <span>
 #include <string>
 #include <string_view>
 #include <cstdint>
@@ -300,15 +1214,75 @@ public:
      * named 'Event' and a 'std::vector<Event>' return type.
      */
     struct Event {
-        std::string name = "";
+        uint64_t startTicks = 0;
+        uint64_t endTicks = 0;
+        uint32_t threadId = 0;
+        int32_t parentIndex = -1;
+        uint16_t nameId = 0;
+        uint16_t categoryId = 0;
+        uint16_t depth = 0;
+        uint16_t flags = 0;
+
+        static constexpr uint16_t kFlagCounter = 1u << 0;
+        static constexpr uint16_t kFlagPlot = 1u << 1;
+        static constexpr uint16_t kFlagAllocCount = 1u << 2;
+        static constexpr uint16_t kFlagAllocBytes = 1u << 3;
+
+        bool isValue() const { return (flags & (kFlagCounter | kFlagPlot)) != 0; }
+        double value() const {
+            if (flags & kFlagPlot)
+                return std::bit_cast<double>(endTicks);
+            return (flags & kFlagCounter) ? static_cast<double>(static_cast<int64_t>(endTicks)) : 0.0;
+        }
+        double durationMs() const { return 0.0; }
+    };
+
+    /** @brief Thread ID of the GPU timeline (kept for API parity). */
+    static constexpr uint32_t kGpuThreadId = 0xFFFFFFFFu;
+
+    /** @brief Thread ID of the counter track (kept for API parity). */
+    static constexpr uint32_t kCounterThreadId = 0xFFFFFFFEu;
+
+    /** @brief currentThreadId() of an exiting thread (kept for API parity). */
+    static constexpr uint32_t kExitedThreadId = 0xFFFFFFFDu;
+
+    /**
+     * @struct ZoneDescriptor
+     * @brief Dummy call-site descriptor matching the real profiler's layout.
+     */
+    struct ZoneDescriptor {
+        std::string_view file;
+        uint32_t line;
+        std::string_view name;
+        uint32_t color = 0;
+        std::string_view category = {};
+    };
+
+    /**
+     * @class ZoneSite
+     * @brief Dummy call-site registration slot (holds nothing).
+     */
+    class ZoneSite {
+    public:
+        constexpr explicit ZoneSite(const ZoneDescriptor& /*descriptor*/) {}
+    };
+
+    /**
+     * @struct ThreadOverflow
+     * @brief Dummy struct matching the real profiler's overflow report.
+     */
+    struct ThreadOverflow {
         uint32_t threadId = 0;
-        double durationMs = 0.0;
+        uint64_t dropped = 0;
     };
 
     // ----------------------- //
     // Frame lifecycle (no-op) //
     // ----------------------- //
 
+    /** @brief Does nothing; the no-op profiler has no clock to prepare. */
+    static void init() {}
+
     /**
      * @brief Begin a new profiling frame.
      *
@@ -324,6 +1298,47 @@ public:
      */
     static void endFrame() {}
 
+    /**
+     * @struct CapturePolicy
+     * @brief Dummy capture policy matching the real profiler's API.
+     */
+    struct CapturePolicy {
+        enum class Mode { Continuous, EveryNth, Random, Triggered };
+
+        Mode mode = Mode::Continuous;
+        uint32_t interval = 1;
+        double sampleRate = 1.0;
+        double triggerMs = 0.0;
+        uint32_t preTriggerFrames = 0;
+
+        static CapturePolicy continuous() { return {}; }
+        static CapturePolicy everyNth(uint32_t /*n*/) { return {}; }
+        static CapturePolicy random(double /*rate*/) { return {}; }
+        static CapturePolicy triggered(double /*thresholdMs*/, uint32_t /*framesBefore*/) { return {}; }
+        static bool parse(std::string_view /*spec*/, CapturePolicy& /*policy*/) { return true; }
+    };
+
+    /**
+     * @brief Select the capture policy (ignored).
+     *
+     * @param policy Capture policy (ignored)
+     */
+    static void setCapturePolicy(const CapturePolicy& /*policy*/) {}
+
+    /**
+     * @brief Return the capture policy (always the default).
+     *
+     * @return CapturePolicy Default-constructed policy
+     */
+    static CapturePolicy getCapturePolicy() { return {}; }
+
+    /**
+     * @brief Whether the last frame was captured (always false).
+     *
+     * @return bool Always false, so per-frame consumers are skipped
+     */
+    static bool isFrameCaptured() { return false; }
+
     // ----------------------- //
     // Event recording (no-op) //
     // ----------------------- //
@@ -335,7 +1350,14 @@ public:
      * @param color Suggested UI color if visualization exists (ignored)
      * @param category Optional category grouping (ignored)
      */
-    static void pushEventStart(std::string_view /*name*/, uint32_t /*color*/ = 0, const std::string& /*category*/ = "") {}
+    static void pushEventStart(std::string_view /*name*/, uint32_t /*color*/ = 0, std::string_view /*category*/ = {}) {}
+
+    /**
+     * @brief Begin recording a zone described at compile time.
+     *
+     * @param site Call-site registration slot (ignored)
+     */
+    static void pushEventStart(ZoneSite& /*site*/) {}
 
     /**
      * @brief End the most recently recorded profiling zone.
@@ -344,6 +1366,45 @@ public:
      */
     static void pushEventEnd() {}
 
+    /**
+     * @brief Add to a per-frame counter (ignored).
+     *
+     * @param name Counter name (ignored)
+     * @param delta Amount to add (ignored)
+     */
+    static void counter(std::string_view /*name*/, int64_t /*delta*/ = 1) {}
+
+    /**
+     * @brief Record a gauge sample (ignored).
+     *
+     * @param name Gauge name (ignored)
+     * @param value Current value (ignored)
+     */
+    static void plot(std::string_view /*name*/, double /*value*/) {}
+
+    static constexpr std::string_view kAllocCountPrefix = "alloc.count/";
+    static constexpr std::string_view kAllocBytesPrefix = "alloc.bytes/";
+
+    /**
+     * @brief Turn allocation tracking on or off (ignored).
+     *
+     * @param enabled Ignored; no allocation hooks are installed
+     */
+    static void setAllocationTracking(bool /*enabled*/) {}
+
+    /** @brief Always false. */
+    static bool isAllocationTracking() { return false; }
+
+    /**
+     * @brief Charge an allocation to the current zone (ignored).
+     *
+     * @param bytes Ignored
+     */
+    static void recordAllocation(size_t /*bytes*/) {}
+
+    /** @brief Always 0. */
+    static int64_t frameAllocationCount() { return 0; }
+
     // ------------------------------------------- //
     // Accessors (always return safe empty result) //
     // ------------------------------------------- //
@@ -358,16 +1419,80 @@ public:
         return empty;
     }
 
+    /** @brief Thread ID and name of a frame (never produced). */
+    struct ThreadName {
+        uint32_t threadId = 0;
+        uint16_t nameId = 0;
+    };
+
+    /**
+     * @brief Names of the frame's threads (always empty).
+     *
+     * @return std::span<const ThreadName> Always empty
+     */
+    static std::span<const ThreadName> getThreadNames() { return {}; }
+
+    /**
+     * @brief Look a thread up in a name snapshot (always empty).
+     *
+     * @return std::string_view Always empty
+     */
+    static std::string_view findThreadName(std::span<const ThreadName> /*names*/,
+                                           uint32_t /*threadId*/) {
+        return {};
+    }
+
+    /**
+     * @brief Intern a string (ignored).
+     *
+     * @return uint16_t Always 0
+     */
+    static uint16_t internString(std::string_view /*text*/, uint32_t /*color*/ = 0) {
+        return 0;
+    }
+
+    /**
+     * @brief Look up an interned string (always empty).
+     *
+     * @return std::string_view Always empty
+     */
+    static std::string_view getString(uint16_t /*id*/) {
+        return {};
+    }
+
+    /**
+     * @brief Look up a zone's call site (always none).
+     *
+     * @return const ZoneDescriptor* Always nullptr
+     */
+    static const ZoneDescriptor* getZoneSource(uint16_t /*id*/) {
+        return nullptr;
+    }
+
     /**
      * @brief Retrieve thread name (always empty string).
      *
      * @param threadId Ignored
-     * @return std::string Always empty
+     * @return std::string_view Always empty
      */
-    static std::string getThreadName(uint32_t /*threadId*/) {
+    static std::string_view getThreadName(uint32_t /*threadId*/) {
         return {};
     }
 
+    /**
+     * @brief ID of the calling thread (always 0).
+     *
+     * @return uint32_t Always 0
+     */
+    static uint32_t currentThreadId() { return 0; }
+
+    /**
+     * @brief Add events from another timeline (ignored).
+     *
+     * @param events Completed events (ignored)
+     */
+    static void submitEvents(std::span<const Event> /*events*/) {}
+
     /**
      * @brief Assign a name to the calling thread (ignored).
      *
@@ -375,6 +1500,23 @@ public:
      */
     static void setThreadName(const std::string& /*name*/) {}
 
+    /**
+     * @brief Assign a name to any thread ID (ignored).
+     *
+     * @param threadId Numeric thread ID
+     * @param name Human-readable thread name
+     */
+    static void setThreadName(uint32_t /*threadId*/, const std::string& /*name*/) {}
+
+    /**
+     * @brief Return per-thread overflow counters (always empty).
+     *
+     * @return std::vector<ThreadOverflow> Always empty
+     */
+    static std::vector<ThreadOverflow> getOverflowCounts() {
+        return {};
+    }
+
     /**
      * @brief Export profiling data to JSON (ignored).
      *
@@ -382,6 +1524,32 @@ public:
      */
     static void exportToJSON(const std::string& /*filename*/) {}
 
+    /**
+     * @brief Start streaming a Chrome trace (ignored).
+     *
+     * @param filename Trace output path (ignored)
+     * @return Always false
+     */
+    static bool beginTrace(const std::string& /*filename*/) { return false; }
+
+    /**
+     * @brief Finish the streaming trace (ignored).
+     */
+    static void endTrace() {}
+
+    /**
+     * @brief Start the live viewer server (ignored).
+     *
+     * @param port TCP port (ignored)
+     * @return Always false
+     */
+    static bool startLiveServer(uint16_t /*port*/) { return false; }
+
+    /**
+     * @brief Stop the live viewer server (ignored).
+     */
+    static void stopLiveServer() {}
+
     // ------------------------------------------------------------- //
     // RAII helpers — identical API to real profiler, but do nothing //
     // ------------------------------------------------------------- //
@@ -402,7 +1570,14 @@ public:
          * @param color UI color for visualizers (ignored)
          * @param category Optional grouping tag (ignored)
          */
-        ScopedZone(std::string_view /*name*/, uint32_t /*color*/ = 0, const std::string& /*category*/ = "") {}
+        ScopedZone(std::string_view /*name*/, uint32_t /*color*/ = 0, std::string_view /*category*/ = {}) {}
+
+        /**
+         * @brief Construct a compile-time registered zone (ignored).
+         *
+         * @param site Call-site registration slot (ignored)
+         */
+        explicit ScopedZone(ZoneSite& /*site*/) {}
     };
 
     /**
@@ -422,7 +1597,7 @@ public:
 };
 
 /**
- * @def PROFILE_SCOPE(name)
+ * @def PROFILE_SCOPE(name, color, category)
  * @brief Macro expands to nothing when profiler is disabled.
  *
  * Usage (remains valid in all builds):
@@ -430,7 +1605,7 @@ public:
  * PROFILE_SCOPE("UpdatePhysics");
  * @endcode
  */
-#define PROFILE_SCOPE(name)
+#define PROFILE_SCOPE(...)
 
 // end of file
 #endif
@@ -0,0 +1,164 @@
+#pragma once
+
+/**
+ * @file ChronoTraceWriter.hpp
+ * @brief Streaming capture writer for ChronoProfiler frames.
+ *
+ * ChronoTraceWriter appends every merged profiler frame to disk, either as
+ * JSON in the Chrome Trace Event format ('ph: "X"' complete events plus
+ * thread-name metadata, opened directly in chrome://tracing or
+ * https://ui.perfetto.dev) or in the compact binary '.chrono' format (see
+ * ChronoCapture.hpp), which is meant for continuous capture and converted
+ * offline with 'chrono-convert'.
+ *
+ * The frame thread only copies raw 32-byte events into a bounded queue; a
+ * background thread encodes the events and writes them to disk. When the
+ * queue is full, whole frames are dropped (and counted) instead of stalling
+ * the caller.
+ *
+ * Only compiled when 'PROFILER' is defined.
+ */
+
+#if defined(PROFILER)
+
+#include "ChronoCapture.hpp"
+#include "ChronoProfiler.hpp"
+
+#include <bitset>             ///< String IDs already written to a binary capture
+#include <condition_variable> ///< Wakes the flush thread when frames arrive
+#include <cstdio>             ///< std::FILE output
+#include <mutex>              ///< Guards the pending-event queue
+#include <span>               ///< Frames are submitted as spans of events
+#include <string>             ///< Output formatting buffer
+#include <thread>             ///< Background flush thread
+#include <string_view>        ///< Thread names last written
+#include <unordered_map>      ///< Thread names last written, by thread ID
+#include <vector>             ///< Pending and in-flight event batches
+
+/**
+ * @class ChronoTraceWriter
+ * @brief Bounded, background-flushed Chrome JSON / binary capture writer.
+ *
+ * Typical usage goes through ChronoProfiler::beginTrace() and
+ * ChronoProfiler::endTrace(); endFrame() forwards every merged frame.
+ *
+ * @par Thread-safety
+ * submit() may be called from any thread. The destructor must not race with
+ * submit().
+ */
+class ChronoTraceWriter {
+public:
+    /** @brief Default capacity of the pending queue, in events (2 MiB of records). */
+    static constexpr size_t kDefaultMaxPendingEvents = 1 << 16;
+
+    /** @brief Maximum number of frames queued at once (bounds empty frames too). */
+    static constexpr size_t kMaxPendingFrames = 4096;
+
+    /** @brief On-disk encoding. */
+    enum class Format {
+        ChromeJson, ///< Chrome Trace Event JSON
+        Binary      ///< Delta/varint '.chrono' capture
+    };
+
+    /**
+     * @brief Opens the output file and starts the flush thread.
+     *
+     * @param filename Destination path (truncated)
+     * @param originTicks Profiler tick value written as timestamp 0
+     * @param format On-disk encoding
+     * @param maxPendingEvents Bound on events queued but not yet written
+     * @throws std::runtime_error if the file cannot be opened
+     */
+    ChronoTraceWriter(const std::string& filename, uint64_t originTicks,
+                      Format format = Format::ChromeJson,
+                      size_t maxPendingEvents = kDefaultMaxPendingEvents);
+
+    /** @brief Flushes all pending frames, terminates the document and closes the file. */
+    ~ChronoTraceWriter();
+
+    ChronoTraceWriter(const ChronoTraceWriter&) = delete;
+    ChronoTraceWriter& operator=(const ChronoTraceWriter&) = delete;
+
+    /**
+     * @brief Queues one merged frame for writing.
+     *
+     * Copies the events and their thread names into the pending queue and
+     * wakes the flush thread. If the frame does not fit, it is dropped as a
+     * whole and counted.
+     *
+     * @param events Events of one frame (as returned by ChronoProfiler::getEvents())
+     * @param threadNames Its thread names (as returned by ChronoProfiler::getThreadNames())
+     * @param frameStartTicks Tick at which the frame began
+     * @return False if the frame was dropped
+     */
+    bool submit(std::span<const ChronoProfiler::Event> events,
+                std::span<const ChronoProfiler::ThreadName> threadNames,
+                uint64_t frameStartTicks);
+
+    /** @brief Number of events dropped because the queue was full. */
+    uint64_t droppedEvents() const;
+
+private:
+    /** @brief Frame boundary inside the pending/batch event vectors. */
+    struct PendingFrame {
+        uint64_t index;       ///< Sequential frame number (dropped frames leave gaps)
+        uint64_t startTicks;  ///< Frame start tick
+        size_t eventCount;    ///< Number of events belonging to this frame
+        size_t nameCount;     ///< Number of thread names belonging to this frame
+    };
+
+    /** @brief Flush thread body: drain the queue, format, write, repeat. */
+    void run();
+
+    /** @brief True (with the name) if a thread's name in a frame differs from the one last written. */
+    bool threadNameChanged(uint32_t threadId,
+                           std::span<const ChronoProfiler::ThreadName> threadNames,
+                           std::string_view& name);
+
+    /** @brief Appends one event (and any new thread metadata) as Chrome JSON. */
+    void formatEvent(const ChronoProfiler::Event& evt,
+                     std::span<const ChronoProfiler::ThreadName> threadNames);
+
+    /** @brief Appends one frame (plus new strings, threads and clock) as binary chunks. */
+    void encodeFrame(const PendingFrame& frame, std::span<const ChronoProfiler::Event> events,
+                     std::span<const ChronoProfiler::ThreadName> threadNames);
+
+    /** @brief Appends a tick value as microseconds since 'originTicks'. */
+    void appendMicros(int64_t ticks);
+
+    /** @brief Appends a counter or gauge value (non-finite values as 0). */
+    void appendValue(double value);
+
+    /** @brief Writes 'output' to the file and clears it. */
+    void flushOutput();
+
+    std::FILE* file = nullptr;       ///< Destination file
+    const Format format;             ///< On-disk encoding
+    const size_t maxPendingEvents;   ///< Queue bound in events
+    const uint64_t originTicks;      ///< Tick value mapped to ts = 0
+    const long processId;            ///< 'pid' field of every event
+
+    mutable std::mutex queueMutex;            ///< Guards pending, dropped and stopping
+    std::condition_variable queueCondition;   ///< Signalled on submit and shutdown
+    std::vector<ChronoProfiler::Event> pending; ///< Events waiting for the flush thread
+    std::vector<ChronoProfiler::ThreadName> pendingNames; ///< Thread names of the pending frames
+    std::vector<PendingFrame> pendingFrames;  ///< Frame boundaries within 'pending'
+    uint64_t nextFrameIndex = 0;              ///< Index assigned to the next submitted frame
+    uint64_t dropped = 0;                     ///< Events discarded on overflow
+    bool stopping = false;                    ///< Set by the destructor
+
+    // Flush-thread-only state
+    std::vector<ChronoProfiler::Event> batch; ///< Events being formatted
+    std::vector<ChronoProfiler::ThreadName> batchNames; ///< Thread names of the batch frames
+    std::vector<PendingFrame> batchFrames;    ///< Frame boundaries within 'batch'
+    std::string output;                       ///< Encoded bytes awaiting fwrite
+    std::string chunk;                        ///< Scratch payload for binary chunks
+    std::unordered_map<uint32_t, std::string_view> writtenNames; ///< Name last emitted per thread ID
+    std::bitset<65536> writtenStrings;        ///< String IDs already in the binary capture
+    double writtenMsPerTick = 0.0;            ///< Clock period last written to the capture
+    bool firstRecord = true;                  ///< Controls the JSON comma separator
+
+    std::thread flushThread; ///< Background writer (started last)
+};
+
+#endif // defined(PROFILER)
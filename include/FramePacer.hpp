@@ -0,0 +1,177 @@
+#pragma once
+
+#include "LogHistogram.hpp"
+
+#include <array>   // for per-metric histograms and the worst hitches
+#include <chrono>  // for std::chrono::steady_clock
+#include <cstdint> // for frame counters
+#include <ostream> // for the end-of-run report
+#include <span>    // for the worst hitches
+
+/**
+ * @file FramePacer.hpp
+ * @brief Frame pacing statistics and hitch detection for the render loop.
+ *
+ * FramePacer times every frame of the main loop, independently of the
+ * profiler's capture policy: the CPU frame time (one loop iteration) and the
+ * time spent blocked in the three places where the renderer waits on the
+ * GPU or the display (the in-flight fence, swapchain image acquisition and
+ * presentation). Each metric goes into a LogHistogram, so memory stays
+ * constant for runs of any length and p99 / p99.9 come out of the same data.
+ *
+ * A frame is a hitch when its CPU frame time exceeds 'hitchFactor' times the
+ * median of the last kMedianWindowFrames frames. Using a rolling median keeps
+ * the detector meaningful when the steady-state rate changes (window resize,
+ * vsync on/off).
+ *
+ * The class only reads std::chrono::steady_clock and does not depend on
+ * ChronoProfiler, so it is available in every build.
+ *
+ * @code
+ * FramePacer pacer;
+ * while (running) {
+ *     pacer.beginFrame();
+ *     {
+ *         FramePacer::ScopedTimer wait(pacer, FramePacer::Metric::FenceWait);
+ *         waitForFence();
+ *     }
+ *     ...
+ *     pacer.endFrame();
+ * }
+ * pacer.report(std::cout);
+ * @endcode
+ */
+class FramePacer {
+public:
+    /** @brief Per-frame measurements. */
+    enum class Metric : uint8_t {
+        CpuFrame,  ///< beginFrame() to endFrame()
+        FenceWait, ///< Waiting for the frame-in-flight fence
+        Acquire,   ///< Acquiring the next swapchain image
+        Present,   ///< Queueing the image for presentation
+        Count      ///< Number of metrics (not a metric)
+    };
+
+    /** @brief Number of metrics. */
+    static constexpr size_t kMetricCount = static_cast<size_t>(Metric::Count);
+
+    /** @brief Frames recorded before hitch detection starts. */
+    static constexpr uint64_t kWarmupFrames = 30;
+
+    /** @brief Length of the rolling window the hitch median is taken over. */
+    static constexpr uint64_t kMedianWindowFrames = 600;
+
+    /** @brief Number of worst hitches listed in the report. */
+    static constexpr size_t kWorstHitches = 5;
+
+    /** @brief One detected hitch. */
+    struct Hitch {
+        uint64_t frame = 0;    ///< Zero-based frame number
+        double ms = 0.0;       ///< CPU frame time
+        double medianMs = 0.0; ///< Rolling median when it happened
+    };
+
+    /**
+     * @brief Create an empty monitor.
+     * @param hitchFactor A frame is a hitch above this multiple of the median (k).
+     */
+    explicit FramePacer(double hitchFactor = 2.0);
+
+    /** @brief Start timing a frame. */
+    void beginFrame();
+
+    /**
+     * @brief Finish the frame: record every metric and check for a hitch.
+     * @return True if the frame was a hitch.
+     */
+    bool endFrame();
+
+    /**
+     * @brief Finish the frame with a CPU frame time measured elsewhere.
+     *
+     * Same as endFrame(), but 'cpuMs' replaces the time since beginFrame()
+     * (replayed or synthetic frame times).
+     *
+     * @param cpuMs CPU frame time in milliseconds.
+     * @return True if the frame was a hitch.
+     */
+    bool endFrame(double cpuMs);
+
+    /**
+     * @brief Add time to a wait metric of the current frame.
+     *
+     * Several calls in one frame accumulate. Wait metrics that were never
+     * touched in a frame (e.g. Present when acquisition failed) are not
+     * recorded for it.
+     *
+     * @param metric FenceWait, Acquire or Present.
+     * @param ms Duration in milliseconds.
+     */
+    void addTime(Metric metric, double ms);
+
+    /**
+     * @class ScopedTimer
+     * @brief Adds the lifetime of a scope to a metric of the current frame.
+     */
+    class ScopedTimer {
+    public:
+        ScopedTimer(FramePacer& pacer, Metric metric)
+            : pacer(pacer), metric(metric), start(Clock::now()) {}
+        ~ScopedTimer() { pacer.addTime(metric, msSince(start)); }
+
+        ScopedTimer(const ScopedTimer&) = delete;
+        ScopedTimer& operator=(const ScopedTimer&) = delete;
+
+    private:
+        FramePacer& pacer;
+        Metric metric;
+        std::chrono::steady_clock::time_point start;
+    };
+
+    /** @brief All-time histogram of a metric. */
+    const LogHistogram& histogram(Metric metric) const {
+        return histograms[static_cast<size_t>(metric)];
+    }
+
+    /** @brief Frames recorded so far. */
+    uint64_t frameCount() const { return frames; }
+
+    /** @brief Hitches detected so far. */
+    uint64_t hitchCount() const { return hitches; }
+
+    /** @brief Up to kWorstHitches largest hitches, largest first. */
+    std::span<const Hitch> worstHitches() const { return {worst.data(), worstCount}; }
+
+    /**
+     * @brief Write the end-of-run report.
+     *
+     * Prints avg / p50 / p99 / p99.9 / max for every metric, the hitch count
+     * and rate, and the worst hitches. The stream's formatting flags and
+     * precision are restored afterwards.
+     *
+     * @param out Destination stream.
+     */
+    void report(std::ostream& out) const;
+
+private:
+    using Clock = std::chrono::steady_clock;
+
+    /** @brief Milliseconds elapsed since a time point. */
+    static double msSince(Clock::time_point start) {
+        return std::chrono::duration<double, std::milli>(Clock::now() - start).count();
+    }
+
+    /** @brief Keep the hitch if it is among the kWorstHitches largest. */
+    void rememberHitch(const Hitch& hitch);
+
+    double hitchFactor;                                ///< k
+    Clock::time_point frameStart;                      ///< Set by beginFrame()
+    std::array<double, kMetricCount> frameMs{};        ///< Wait times of the current frame
+    uint32_t touchedMetrics = 0;                       ///< Bit per metric used this frame
+    std::array<LogHistogram, kMetricCount> histograms; ///< All-time distributions
+    WindowedHistogram recentFrames{kMedianWindowFrames}; ///< CPU frame times for the median
+    uint64_t frames = 0;                               ///< Frames recorded
+    uint64_t hitches = 0;                              ///< Hitches detected
+    std::array<Hitch, kWorstHitches> worst{};          ///< Largest hitches, descending
+    size_t worstCount = 0;                             ///< Valid entries in 'worst'
+};
@@ -0,0 +1,285 @@
+#pragma once
+
+/**
+ * @file GpuProfiler.hpp
+ * @brief GPU timestamp-query zones reported on ChronoProfiler's timeline.
+ *
+ * GpuProfiler brackets command-buffer regions with 'vkCmdWriteTimestamp' and
+ * hands the measured intervals to ChronoProfiler as events on the
+ * ChronoProfiler::kGpuThreadId pseudo-thread. They then appear as a "GPU"
+ * track in ProfilerUI, the JSON export and streaming captures, alongside the
+ * CPU zones of the same run.
+ *
+ * Each frame in flight owns its own timestamp query pool. A slot's results are
+ * read right after the renderer has waited on that slot's fence, when they
+ * are known to be available, so reading them never stalls the CPU or the GPU.
+ * As a consequence GPU zones are reported MAX_FRAMES_IN_FLIGHT frames after
+ * the CPU frame that recorded them.
+ *
+ * GPU ticks are mapped onto profiler ticks with VK_EXT_calibrated_timestamps
+ * when the device supports it (re-sampled every kCalibrationInterval frames to
+ * follow clock drift). Otherwise, for example on lavapipe builds without the
+ * extension, the first timestamp of a frame is anchored to the CPU tick at
+ * which the command buffer was submitted; durations are exact either way, only
+ * the placement relative to CPU zones is approximate.
+ *
+ * Real implementation only when 'PROFILER' is defined; otherwise every call
+ * is an empty inline stub.
+ */
+
+#include <vulkan/vulkan_raii.hpp>
+
+#include <cstdint>
+#include <string_view>
+
+#if defined(PROFILER)
+
+#include "ChronoProfiler.hpp"
+
+#include <array>  ///< Per-slot stack of open zones
+#include <vector> ///< Per-slot query pools, zones and readback storage
+
+/**
+ * @class GpuProfiler
+ * @brief Per-frame-in-flight timestamp query pools feeding ChronoProfiler.
+ *
+ * Usage from the renderer:
+ * @code
+ * gpuProfiler.init(physicalGPU, device, graphicsQueueFamilyIndex,
+ *                  MAX_FRAMES_IN_FLIGHT, calibrationEnabled);
+ *
+ * // drawFrame(), after waiting on inFlightFences[currentFrame]
+ * gpuProfiler.collect(currentFrame);
+ *
+ * // recordCommandBuffer()
+ * cmd.begin({});
+ * gpuProfiler.beginFrame(cmd, currentFrame);
+ * {
+ *     GpuProfiler::ScopedZone zone(gpuProfiler, cmd, "Main Pass");
+ *     ...
+ * }
+ * gpuProfiler.endFrame(cmd);
+ * cmd.end();
+ *
+ * // drawFrame(), just before vkQueueSubmit
+ * gpuProfiler.markSubmitted(currentFrame);
+ * @endcode
+ *
+ * @par Thread-safety
+ * Not thread-safe: all calls are expected from the thread recording and
+ * submitting the frame's command buffer.
+ */
+class GpuProfiler {
+public:
+    /** @brief Timestamp queries per frame (two per zone, including the frame zone). */
+    static constexpr uint32_t kMaxQueriesPerFrame = 64;
+
+    /** @brief Maximum nesting of open GPU zones. */
+    static constexpr uint32_t kMaxZoneDepth = 16;
+
+    /** @brief Frames between clock re-synchronizations. */
+    static constexpr uint32_t kCalibrationInterval = 120;
+
+    GpuProfiler() = default;
+
+    GpuProfiler(const GpuProfiler&) = delete;
+    GpuProfiler& operator=(const GpuProfiler&) = delete;
+
+    /**
+     * @brief Device extension that enables calibrated timestamps, if supported.
+     *
+     * The renderer adds the returned name to its device extensions before the
+     * logical device is created and passes whether it did to init().
+     *
+     * @param physicalDevice Selected physical GPU
+     * @return VK_EXT_CALIBRATED_TIMESTAMPS_EXTENSION_NAME when the extension and
+     *         a host time domain matching the profiler clock are available,
+     *         otherwise nullptr
+     */
+    static const char* calibrationExtension(const vk::raii::PhysicalDevice& physicalDevice);
+
+    /**
+     * @brief Creates one timestamp query pool per frame in flight.
+     *
+     * Leaves the profiler disabled (every call a no-op) when the queue family
+     * reports no valid timestamp bits.
+     *
+     * @param physicalDevice Physical GPU the device was created from
+     * @param device Logical device (must outlive this object)
+     * @param queueFamilyIndex Family of the queue the frames are submitted to
+     * @param framesInFlight Number of frames that may be in flight at once
+     * @param calibrationEnabled Whether calibrationExtension() was enabled on the device
+     */
+    void init(const vk::raii::PhysicalDevice& physicalDevice, const vk::raii::Device& device,
+              uint32_t queueFamilyIndex, uint32_t framesInFlight, bool calibrationEnabled);
+
+    /** @brief True once init() found timestamp support. */
+    bool isEnabled() const { return enabled; }
+
+    /**
+     * @brief Reads back the zones of the frame last submitted from a slot.
+     *
+     * Must be called after the slot's fence has signalled and before the slot's
+     * command buffer is recorded again. Uses no wait flag: the results are
+     * already available, and a slot whose queries are not (e.g. it was never
+     * submitted) is skipped.
+     *
+     * @param frameSlot Frame-in-flight index
+     */
+    void collect(uint32_t frameSlot);
+
+    /**
+     * @brief Resets the slot's queries and opens the "GPU Frame" zone.
+     *
+     * Record right after vk::CommandBuffer::begin(), outside any rendering.
+     *
+     * @param cmd Command buffer being recorded for the slot
+     * @param frameSlot Frame-in-flight index
+     */
+    void beginFrame(const vk::raii::CommandBuffer& cmd, uint32_t frameSlot);
+
+    /**
+     * @brief Closes the "GPU Frame" zone (and any zone left open).
+     *
+     * @param cmd Command buffer passed to beginFrame()
+     */
+    void endFrame(const vk::raii::CommandBuffer& cmd);
+
+    /**
+     * @brief Opens a nested GPU zone.
+     *
+     * Zones beyond kMaxQueriesPerFrame or kMaxZoneDepth are counted as dropped.
+     *
+     * @param cmd Command buffer passed to beginFrame()
+     * @param name Zone name (interned on first use)
+     * @param color Zone color for viewers
+     */
+    void beginZone(const vk::raii::CommandBuffer& cmd, std::string_view name,
+                   uint32_t color = 0x76B900FF);
+
+    /**
+     * @brief Closes the innermost open GPU zone.
+     *
+     * @param cmd Command buffer passed to beginFrame()
+     */
+    void endZone(const vk::raii::CommandBuffer& cmd);
+
+    /**
+     * @brief Records the CPU tick at which the slot's command buffer is submitted.
+     *
+     * Anchors GPU time when calibrated timestamps are unavailable.
+     *
+     * @param frameSlot Frame-in-flight index
+     */
+    void markSubmitted(uint32_t frameSlot);
+
+    /** @brief Zones dropped because a frame ran out of queries or depth. */
+    uint64_t droppedZones() const { return dropped; }
+
+    /**
+     * @class ScopedZone
+     * @brief RAII helper that brackets a scope of command recording.
+     */
+    class ScopedZone {
+    public:
+        ScopedZone(GpuProfiler& profiler, const vk::raii::CommandBuffer& cmd, std::string_view name,
+                   uint32_t color = 0x76B900FF)
+            : profiler(profiler), cmd(cmd) {
+            profiler.beginZone(cmd, name, color);
+        }
+        ~ScopedZone() { profiler.endZone(cmd); }
+
+        ScopedZone(const ScopedZone&) = delete;
+        ScopedZone& operator=(const ScopedZone&) = delete;
+
+    private:
+        GpuProfiler& profiler;
+        const vk::raii::CommandBuffer& cmd;
+    };
+
+private:
+    /** @brief One zone recorded into a slot's command buffer. */
+    struct Zone {
+        uint32_t beginQuery; ///< Query index of the begin timestamp
+        uint32_t endQuery;   ///< Query index of the end timestamp
+        uint16_t nameId;     ///< Interned zone name
+        uint16_t depth;      ///< Nesting depth within the frame
+    };
+
+    /** @brief Query pool and bookkeeping for one frame in flight. */
+    struct FrameSlot {
+        vk::raii::QueryPool pool = nullptr;           ///< kMaxQueriesPerFrame timestamps
+        std::vector<Zone> zones;                      ///< Zones in begin order
+        std::array<uint32_t, kMaxZoneDepth> openZones; ///< Indices into 'zones'
+        uint32_t openCount = 0;                       ///< Current nesting depth
+        uint32_t pendingEnds = 0;                     ///< Open zones still owed an end query
+        uint32_t queryCount = 0;                      ///< Queries written this frame
+        uint64_t submitTicks = 0;                     ///< CPU tick at submission
+        bool submitted = false;                       ///< Results pending readback
+    };
+
+    /** @brief Writes a zone's begin timestamp, or counts it as dropped. */
+    void openZone(const vk::raii::CommandBuffer& cmd, uint16_t nameId);
+
+    /** @brief Re-samples the GPU and host clocks together (calibrated mode). */
+    void calibrate();
+
+    /** @brief Maps a raw GPU timestamp to profiler ticks. */
+    uint64_t toProfilerTicks(uint64_t gpuTicks) const;
+
+    const vk::raii::Device* device = nullptr; ///< Device owning the query pools
+    std::vector<FrameSlot> slots;             ///< One per frame in flight
+    FrameSlot* recording = nullptr;           ///< Slot between beginFrame() and endFrame()
+
+    bool enabled = false;         ///< Timestamps supported on the queue
+    bool calibrated = false;      ///< VK_EXT_calibrated_timestamps in use
+    double gpuNsPerTick = 1.0;    ///< VkPhysicalDeviceLimits::timestampPeriod
+    uint64_t validMask = ~0ull;   ///< Mask of valid timestamp bits
+
+    uint64_t anchorGpuTicks = 0;   ///< GPU timestamp of the clock anchor
+    uint64_t anchorCpuTicks = 0;   ///< Profiler tick at the same instant
+    bool anchored = false;         ///< An anchor has been established
+    uint32_t framesSinceAnchor = 0; ///< Frames collected since the anchor was set
+
+    uint16_t frameNameId = 0;  ///< Interned "GPU Frame"
+    uint16_t categoryId = 0;   ///< Interned "gpu"
+    uint64_t dropped = 0;      ///< Zones that did not fit
+
+    std::vector<uint64_t> results;              ///< Readback storage
+    std::vector<ChronoProfiler::Event> events;  ///< Events built by collect()
+};
+
+#else
+
+/**
+ * @class GpuProfiler
+ * @brief No-op stub used when profiling is disabled.
+ *
+ * No query pools are created and no commands are recorded.
+ */
+class GpuProfiler {
+public:
+    static const char* calibrationExtension(const vk::raii::PhysicalDevice& /*physicalDevice*/) {
+        return nullptr;
+    }
+    void init(const vk::raii::PhysicalDevice& /*physicalDevice*/, const vk::raii::Device& /*device*/,
+              uint32_t /*queueFamilyIndex*/, uint32_t /*framesInFlight*/, bool /*calibrationEnabled*/) {}
+    bool isEnabled() const { return false; }
+    void collect(uint32_t /*frameSlot*/) {}
+    void beginFrame(const vk::raii::CommandBuffer& /*cmd*/, uint32_t /*frameSlot*/) {}
+    void endFrame(const vk::raii::CommandBuffer& /*cmd*/) {}
+    void beginZone(const vk::raii::CommandBuffer& /*cmd*/, std::string_view /*name*/,
+                   uint32_t /*color*/ = 0) {}
+    void endZone(const vk::raii::CommandBuffer& /*cmd*/) {}
+    void markSubmitted(uint32_t /*frameSlot*/) {}
+    uint64_t droppedZones() const { return 0; }
+
+    /** @brief No-op RAII zone. */
+    class ScopedZone {
+    public:
+        ScopedZone(GpuProfiler& /*profiler*/, const vk::raii::CommandBuffer& /*cmd*/,
+                   std::string_view /*name*/, uint32_t /*color*/ = 0) {}
+    };
+};
+
+#endif // PROFILER
@@ -0,0 +1,224 @@
+#pragma once
+
+#include <algorithm> // for std::min, std::max
+#include <array>     // for bucket storage
+#include <bit>       // for std::bit_width
+#include <cmath>     // for std::sqrt, std::ceil
+#include <cstdint>   // for fixed-width counters
+#include <limits>    // for min/max sentinels
+
+/**
+ * @file LogHistogram.hpp
+ * @brief Fixed-size, log-bucketed latency histogram with streaming quantiles.
+ *
+ * LogHistogram records durations (in milliseconds) into buckets whose width
+ * grows with the value, like an HDR histogram: each power-of-two range of
+ * nanoseconds is split into 'kSubBuckets' equal sub-buckets. Quantiles are
+ * reported at bucket midpoints, so the relative error is bounded by half a
+ * sub-bucket (about 3%) at any magnitude, from nanoseconds to minutes.
+ *
+ * Memory is constant (one 32-bit counter per bucket, ~2.4 KiB) no matter how
+ * many samples are recorded, and recording is a bit scan plus an increment.
+ * Histograms can be merged, which WindowedHistogram uses to maintain
+ * statistics over the most recent frames.
+ *
+ * The header has no profiler dependency and is usable in every build.
+ *
+ * @code
+ * LogHistogram frameTimes;
+ * frameTimes.add(16.7);
+ * double p99 = frameTimes.quantile(0.99);
+ * @endcode
+ */
+class LogHistogram {
+public:
+    /** @brief log2 of the number of sub-buckets per power of two. */
+    static constexpr unsigned kSubBucketBits = 4;
+
+    /** @brief Sub-buckets per power of two (relative bucket width 1/16). */
+    static constexpr unsigned kSubBuckets = 1u << kSubBucketBits;
+
+    /** @brief Values are clamped below 2^kMaxValueBits ns (about 18 minutes). */
+    static constexpr unsigned kMaxValueBits = 40;
+
+    /** @brief Total number of buckets. */
+    static constexpr size_t kBucketCount = (kMaxValueBits - kSubBucketBits + 1) * kSubBuckets;
+
+    /**
+     * @brief Record one sample.
+     * @param ms Duration in milliseconds (negative values count as 0).
+     */
+    void add(double ms) {
+        const double ns = std::max(ms, 0.0) * 1e6 + 0.5;
+        const uint64_t value = ns >= static_cast<double>(kMaxValue) ? kMaxValue
+                                                                    : static_cast<uint64_t>(ns);
+        ++buckets[bucketIndex(value)];
+        ++total;
+        sum += ms;
+        sumSquares += ms * ms;
+        minMs = std::min(minMs, ms);
+        maxMs = std::max(maxMs, ms);
+    }
+
+    /** @brief Add every sample of another histogram. */
+    void merge(const LogHistogram& other) {
+        for (size_t i = 0; i < kBucketCount; ++i)
+            buckets[i] += other.buckets[i];
+        total += other.total;
+        sum += other.sum;
+        sumSquares += other.sumSquares;
+        minMs = std::min(minMs, other.minMs);
+        maxMs = std::max(maxMs, other.maxMs);
+    }
+
+    /** @brief Discard all samples. */
+    void reset() { *this = LogHistogram(); }
+
+    /** @brief Number of recorded samples. */
+    uint64_t count() const { return total; }
+
+    /** @brief Arithmetic mean in milliseconds (0 if empty). */
+    double mean() const { return total ? sum / static_cast<double>(total) : 0.0; }
+
+    /** @brief Population standard deviation in milliseconds (0 if empty). */
+    double stddev() const {
+        if (total == 0)
+            return 0.0;
+        const double m = mean();
+        return std::sqrt(std::max(sumSquares / static_cast<double>(total) - m * m, 0.0));
+    }
+
+    /** @brief Smallest sample in milliseconds (0 if empty). */
+    double min() const { return total ? minMs : 0.0; }
+
+    /** @brief Largest sample in milliseconds (0 if empty). */
+    double max() const { return total ? maxMs : 0.0; }
+
+    /**
+     * @brief Estimate a quantile.
+     * @param q Quantile in [0, 1] (e.g. 0.99 for p99).
+     * @return Midpoint of the bucket holding the q-th sample, in milliseconds,
+     *         clamped to [min(), max()] (0 if empty).
+     */
+    double quantile(double q) const {
+        if (total == 0)
+            return 0.0;
+
+        const uint64_t rank = std::max<uint64_t>(
+            1, static_cast<uint64_t>(std::ceil(std::clamp(q, 0.0, 1.0) * static_cast<double>(total))));
+        uint64_t seen = 0;
+        for (size_t i = 0; i < kBucketCount; ++i) {
+            seen += buckets[i];
+            if (seen >= rank) {
+                const double mid = 0.5 * static_cast<double>(bucketLower(i) + bucketUpper(i)) * 1e-6;
+                return std::clamp(mid, minMs, maxMs);
+            }
+        }
+        return maxMs;
+    }
+
+    /**
+     * @brief Bucket holding a value.
+     * @param ns Value in nanoseconds (already clamped to kMaxValue).
+     */
+    static size_t bucketIndex(uint64_t ns) {
+        const unsigned bits = static_cast<unsigned>(std::bit_width(ns));
+        if (bits <= kSubBucketBits)
+            return static_cast<size_t>(ns); // Small values are exact
+        const unsigned shift = bits - kSubBucketBits - 1;
+        return static_cast<size_t>(shift + 1) * kSubBuckets + ((ns >> shift) - kSubBuckets);
+    }
+
+    /** @brief Smallest nanosecond value mapped to a bucket. */
+    static uint64_t bucketLower(size_t index) {
+        if (index < 2 * kSubBuckets)
+            return index;
+        const unsigned shift = static_cast<unsigned>(index / kSubBuckets) - 1;
+        return (kSubBuckets + index % kSubBuckets) << shift;
+    }
+
+    /** @brief Largest nanosecond value mapped to a bucket. */
+    static uint64_t bucketUpper(size_t index) {
+        return index + 1 < kBucketCount ? bucketLower(index + 1) - 1 : kMaxValue;
+    }
+
+private:
+    /** @brief Largest representable value in nanoseconds. */
+    static constexpr uint64_t kMaxValue = (uint64_t{1} << kMaxValueBits) - 1;
+
+    std::array<uint32_t, kBucketCount> buckets{}; ///< Sample count per bucket
+    uint64_t total = 0;                            ///< Number of samples
+    double sum = 0.0;                              ///< Sum of samples (ms)
+    double sumSquares = 0.0;                       ///< Sum of squared samples (ms^2)
+    double minMs = std::numeric_limits<double>::infinity();  ///< Smallest sample
+    double maxMs = -std::numeric_limits<double>::infinity(); ///< Largest sample
+};
+
+/**
+ * @class WindowedHistogram
+ * @brief LogHistogram over approximately the last N frames.
+ *
+ * The window is split into 'kBlocks' blocks of N / kBlocks frames, each with
+ * its own histogram, plus a running total of all blocks. When a new block
+ * starts, the oldest block is cleared and reused and the total is rebuilt
+ * from the remaining blocks (keeping min/max exact), so memory stays at
+ * kBlocks + 1 histograms and no sample is ever stored individually. The
+ * window covers between N - N / kBlocks and N frames.
+ *
+ * Rotation is lazy: it happens when the histogram is next touched, so zones
+ * that stop appearing cost nothing per frame.
+ */
+class WindowedHistogram {
+public:
+    /** @brief Number of rotating blocks (window granularity is N / kBlocks). */
+    static constexpr size_t kBlocks = 4;
+
+    /**
+     * @brief Create an empty window.
+     * @param windowFrames Window length N in frames.
+     */
+    explicit WindowedHistogram(uint64_t windowFrames = 600)
+        : blockFrames(std::max<uint64_t>(1, (windowFrames + kBlocks - 1) / kBlocks)) {}
+
+    /**
+     * @brief Record a sample observed in a given frame.
+     * @param ms Duration in milliseconds.
+     * @param frame Absolute frame number (non-decreasing across calls).
+     */
+    void add(double ms, uint64_t frame) {
+        advance(frame);
+        blocks[currentBlock % kBlocks].add(ms);
+        total.add(ms);
+    }
+
+    /**
+     * @brief Histogram of the window ending at a frame.
+     * @param frame Current absolute frame number.
+     */
+    const LogHistogram& window(uint64_t frame) {
+        advance(frame);
+        return total;
+    }
+
+private:
+    /** @brief Retire blocks that have fallen out of the window. */
+    void advance(uint64_t frame) {
+        const uint64_t block = frame / blockFrames;
+        if (block <= currentBlock)
+            return;
+
+        const uint64_t expired = std::min<uint64_t>(block - currentBlock, kBlocks);
+        for (uint64_t b = 1; b <= expired; ++b)
+            blocks[(currentBlock + b) % kBlocks].reset();
+        currentBlock = block;
+
+        total.reset();
+        for (const auto& b : blocks)
+            total.merge(b);
+    }
+
+    std::array<LogHistogram, kBlocks> blocks; ///< Per-block samples
+    LogHistogram total;                       ///< Sum of all blocks
+    uint64_t blockFrames;                     ///< Frames per block
+    uint64_t currentBlock = 0;                ///< Block receiving new samples
+};
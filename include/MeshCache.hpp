@@ -0,0 +1,150 @@
+#pragma once
+
+#include "Vertex.hpp" // for Vertex
+#include <cstddef>    // for size_t
+#include <cstdint>    // for fixed-width header fields
+#include <memory>     // for std::unique_ptr
+#include <span>       // for views over the mapped arrays
+#include <string>     // for file paths
+
+/**
+ * @file MeshCache.hpp
+ * @brief Versioned binary mesh cache ('.amesh') loaded through mmap.
+ *
+ * Importing an OBJ means parsing text and deduplicating every corner. The
+ * result, a vertex array and an index array, is written next to the source
+ * as an '.amesh' file so later launches can skip both steps.
+ *
+ * File layout (host byte order, so caches are machine-local):
+ *  - Header (80 bytes): magic, format version, vertex stride, array sizes,
+ *    the source file's size, modification time and XXH64 content hash, and
+ *    the mesh bounds.
+ *  - vertexCount Vertex records.
+ *  - indexCount uint32_t indices.
+ *
+ * open() maps the file read-only and hands out spans pointing into the
+ * mapping, so the renderer copies them straight into its staging buffers.
+ * A cache is used only when it matches the source: an unchanged size and
+ * modification time are trusted; otherwise the source is hashed and the
+ * cache is accepted (and its stamp refreshed) only if the content is
+ * identical. Anything else (missing, stale, truncated or from another
+ * format version) makes open() return nullptr and the caller re-imports.
+ *
+ * open() also checks that every index is below the vertex count, so a
+ * damaged cache cannot make the renderer read past its vertex buffer.
+ *
+ * The writer stamps the cache with the source as it was imported: take the
+ * size and modification time with statSource() before reading the source,
+ * and hash exactly the bytes the importer reads (importObj() does this while
+ * parsing, so the source is read only once). A source edited during the
+ * import then fails the next open() instead of being trusted.
+ *
+ * @code
+ * const std::string cachePath = MeshCache::cachePathFor("models/statue.obj");
+ * if (auto cache = MeshCache::open(cachePath, "models/statue.obj")) {
+ *     upload(cache->vertices(), cache->indices());
+ * } else if (MeshCache::SourceStamp stamp; MeshCache::statSource("models/statue.obj", stamp)) {
+ *     importObj("models/statue.obj", vertices, indices, 0, &stamp.hash);
+ *     MeshCache::write(cachePath, stamp, vertices, indices);
+ * }
+ * @endcode
+ *
+ * @note Uses POSIX mmap; only Linux and macOS are supported.
+ */
+class MeshCache {
+public:
+    /** @brief Format version; bump whenever the layout or Vertex changes. */
+    static constexpr uint32_t kVersion = 1;
+
+    /** @brief Identity of a source file, as stored in the cache header. */
+    struct SourceStamp {
+        uint64_t size = 0;   ///< Size in bytes
+        int64_t mtimeNs = 0; ///< Modification time (file clock, ns)
+        uint64_t hash = 0;   ///< XXH64 of the contents
+    };
+
+    /** @brief Axis-aligned bounds of the cached vertices' positions. */
+    struct Bounds {
+        glm::vec3 min; ///< Smallest x, y and z
+        glm::vec3 max; ///< Largest x, y and z
+    };
+
+    /**
+     * @brief Cache path for a source mesh: its extension replaced by '.amesh'.
+     *
+     * @param sourcePath Path of the source mesh (e.g. "models/statue.obj").
+     * @return Path of its cache (e.g. "models/statue.amesh").
+     */
+    static std::string cachePathFor(const std::string &sourcePath);
+
+    /**
+     * @brief Maps a cache if it is valid for the given source.
+     *
+     * @param cachePath Path of the '.amesh' file.
+     * @param sourcePath Path of the mesh it was built from.
+     * @return The mapped cache, or nullptr if it is missing, stale or invalid
+     *         (including an index that is not below the vertex count).
+     */
+    static std::unique_ptr<MeshCache> open(const std::string &cachePath,
+                                           const std::string &sourcePath);
+
+    /**
+     * @brief Size and modification time of a source; 'hash' is left at 0.
+     *
+     * Call it before the source is read for import, then fill in the hash.
+     *
+     * @param sourcePath Path of the source mesh.
+     * @param stamp Receives the size and modification time.
+     * @return False if the source does not exist or cannot be inspected.
+     */
+    static bool statSource(const std::string &sourcePath, SourceStamp &stamp);
+
+    /**
+     * @brief XXH64 of a source file, for importers that do not hash as they read.
+     *
+     * @param sourcePath Path of the source mesh.
+     * @param hash Receives the hash.
+     * @return False if the file cannot be read.
+     */
+    static bool hashSource(const std::string &sourcePath, uint64_t &hash);
+
+    /**
+     * @brief Writes a cache for a source.
+     *
+     * The file is written under a temporary name and renamed into place, so
+     * a concurrent or interrupted run never sees a partial cache.
+     *
+     * @param cachePath Path of the '.amesh' file to create or replace.
+     * @param source Stamp of the source taken before it was imported.
+     * @param vertices Deduplicated vertices.
+     * @param indices Index buffer referencing 'vertices'.
+     * @throws std::runtime_error if the cache cannot be written.
+     */
+    static void write(const std::string &cachePath, const SourceStamp &source,
+                      std::span<const Vertex> vertices, std::span<const uint32_t> indices);
+
+    /** @brief Unmaps the file; spans returned earlier become invalid. */
+    ~MeshCache();
+
+    MeshCache(const MeshCache &) = delete;
+    MeshCache &operator=(const MeshCache &) = delete;
+
+    /** @brief Cached vertices, pointing into the mapping. */
+    std::span<const Vertex> vertices() const { return vertexSpan; }
+
+    /** @brief Cached indices, pointing into the mapping. */
+    std::span<const uint32_t> indices() const { return indexSpan; }
+
+    /** @brief Bounds stored in the header. */
+    const Bounds &bounds() const { return meshBounds; }
+
+private:
+    /** @brief Takes ownership of a mapping of 'size' bytes. */
+    MeshCache(void *mapping, size_t size);
+
+    void *mapping = nullptr;               ///< Base of the read-only mapping
+    size_t mappingSize = 0;                ///< Length of the mapping
+    std::span<const Vertex> vertexSpan;    ///< Vertices inside the mapping
+    std::span<const uint32_t> indexSpan;   ///< Indices inside the mapping
+    Bounds meshBounds{};                   ///< Copied from the header
+};
@@ -0,0 +1,252 @@
+#pragma once
+
+#include "Vertex.hpp"           // for Vertex
+#include "VertexDedupTable.hpp" // for the chunk-local dedup tables
+#include <atomic>               // for the pool's task counter
+#include <condition_variable>   // for waking and waiting on pool workers
+#include <cstddef>              // for size_t
+#include <cstdint>              // for uint32_t, uint64_t
+#include <exception>            // for std::exception_ptr
+#include <functional>           // for std::function
+#include <memory>               // for std::unique_ptr
+#include <mutex>                // for the pool state
+#include <span>                 // for std::span
+#include <thread>               // for the pool workers
+#include <vector>               // for std::vector
+
+/**
+ * @file MeshImport.hpp
+ * @brief Parallel vertex deduplication for mesh import.
+ *
+ * An OBJ face list is a stream of corners, each referencing a position and a
+ * texture coordinate. Vulkan wants one vertex buffer of unique vertices plus
+ * an index buffer, so every corner has to be looked up in a table of the
+ * vertices seen so far. On multi-million-triangle meshes that loop dominates
+ * startup.
+ *
+ * meshimport::deduplicate() splits the corner stream into contiguous chunks
+ * and deduplicates each chunk on its own thread into a chunk-local
+ * VertexDedupTable; the same threads then look each chunk-local vertex up in
+ * the stream-wide table. A serial merge walks the chunks in order and only
+ * inserts the vertices that lookup missed, assigning global indices on first
+ * occurrence, and a parallel pass remaps the chunk-local indices.
+ * meshimport::Deduplicator does the same for a stream that arrives in
+ * batches, running every batch on one persistent meshimport::WorkerPool.
+ *
+ * Because chunks are merged in stream order and each chunk lists its vertices
+ * in first-occurrence order, global indices are assigned in the order of each
+ * vertex's first occurrence in the whole stream. The output is therefore
+ * byte-identical to a single serial pass, whatever the chunk count.
+ *
+ * @code
+ * meshimport::deduplicate(cornerCount,
+ *                         [&](size_t corner) { return makeVertex(corner); },
+ *                         vertices, indices);
+ * @endcode
+ */
+namespace meshimport {
+
+/** @brief Smallest number of corners worth handing to a separate thread. */
+constexpr size_t kMinCornersPerChunk = size_t{1} << 16;
+
+/**
+ * @brief Resolves a thread limit.
+ *
+ * @param threadCount Thread limit; 0 means std::thread::hardware_concurrency().
+ * @return At least 1.
+ */
+unsigned resolveThreadCount(unsigned threadCount);
+
+/**
+ * @brief Number of chunks to split a corner stream into.
+ *
+ * @param cornerCount Number of corners in the stream.
+ * @param threadCount Thread limit; 0 uses std::thread::hardware_concurrency().
+ * @return At least 1, and at most one chunk per kMinCornersPerChunk corners.
+ */
+size_t chunkCountFor(size_t cornerCount, unsigned threadCount);
+
+/**
+ * @class WorkerPool
+ * @brief Fixed set of threads that run indexed tasks on request.
+ *
+ * The threads are started once and sleep between run() calls, so a stream
+ * deduplicated in many batches does not pay for thread creation per batch.
+ */
+class WorkerPool {
+public:
+    /**
+     * @brief Starts threadCount - 1 workers; the caller of run() is the last thread.
+     * @param threadCount Threads taking part in run(), at least 1.
+     */
+    explicit WorkerPool(unsigned threadCount);
+
+    /** @brief Stops and joins the workers. */
+    ~WorkerPool();
+
+    WorkerPool(const WorkerPool &) = delete;
+    WorkerPool &operator=(const WorkerPool &) = delete;
+
+    /**
+     * @brief Runs task(0) .. task(count - 1) on the workers and the calling thread.
+     *
+     * Tasks are claimed in index order by whichever thread is free. Returns
+     * once every task has finished. Not reentrant: one run() at a time.
+     *
+     * @param count Number of tasks.
+     * @param task Work to run; receives the task index.
+     * @throws The first exception thrown by a task (lowest index), after all
+     *         tasks have finished.
+     */
+    void run(size_t count, const std::function<void(size_t)> &task);
+
+private:
+    /** @brief Worker thread body: waits for a run() and helps with it. */
+    void work();
+
+    /** @brief Claims and runs tasks of the current run() until none are left. */
+    void runTasks();
+
+    std::mutex mutex;                              ///< Guards the run state below
+    std::condition_variable wake;                  ///< Signalled when a run starts or on shutdown
+    std::condition_variable finished;              ///< Signalled when the last worker leaves a run
+    const std::function<void(size_t)> *task = nullptr; ///< Task of the current run
+    size_t taskCount = 0;                          ///< Tasks in the current run
+    std::atomic<size_t> nextTask{0};               ///< Next unclaimed task index
+    std::vector<std::exception_ptr> errors;        ///< Per-task failures of the current run
+    uint64_t generation = 0;                       ///< Incremented by every run()
+    size_t activeWorkers = 0;                      ///< Workers still inside the current run
+    bool stopping = false;                         ///< Set by the destructor
+    std::vector<std::thread> workers;              ///< Started by the constructor
+};
+
+/**
+ * @class Deduplicator
+ * @brief Deduplicates a corner stream that arrives in consecutive batches.
+ *
+ * Keeps one stream-wide VertexDedupTable, so the result after the last
+ * append() is the same as one deduplicate() call over the concatenated
+ * batches. Batches large enough to split run the chunked parallel scheme;
+ * smaller ones insert straight into the stream-wide table.
+ */
+class Deduplicator {
+public:
+    /**
+     * @brief Starts an empty mesh.
+     *
+     * @param vertices Receives the unique vertices (cleared here).
+     * @param indices Receives one index per corner (cleared here).
+     * @param expectedVertices Unique vertex count to size the table for.
+     * @param threadCount Thread limit; 0 uses every hardware thread and 1
+     *        runs serially on the calling thread.
+     */
+    Deduplicator(std::vector<Vertex> &vertices, std::vector<uint32_t> &indices,
+                 size_t expectedVertices = 0, unsigned threadCount = 0);
+
+    /**
+     * @brief Deduplicates the next batch of corners.
+     *
+     * @tparam CornerFn Callable as 'Vertex(size_t corner)' for corners
+     *         0 .. cornerCount - 1 of the batch; invoked concurrently from
+     *         several threads, so it must not modify shared state.
+     * @param cornerCount Number of corners in the batch.
+     * @param corner Builds the vertex of one corner.
+     */
+    template <class CornerFn>
+    void append(size_t cornerCount, const CornerFn &corner) {
+        const size_t base = indices.size();
+        const size_t chunkCount = chunkCountFor(cornerCount, threadCount);
+        indices.resize(base + cornerCount);
+
+        // Too small to split: insert straight into the stream-wide table
+        if (chunkCount == 1) {
+            for (size_t i = 0; i < cornerCount; ++i)
+                indices[base + i] = table.insert(corner(i)).first;
+            return;
+        }
+
+        if (!pool)
+            pool = std::make_unique<WorkerPool>(threadCount);
+        if (chunks.size() < chunkCount)
+            chunks.resize(chunkCount);
+        std::vector<size_t> chunkBegins(chunkCount + 1);
+        for (size_t c = 0; c <= chunkCount; ++c)
+            chunkBegins[c] = cornerCount * c / chunkCount;
+
+        // Each chunk writes its local indices straight into its slice of 'indices'
+        pool->run(chunkCount, [&](size_t c) {
+            const size_t begin = chunkBegins[c];
+            const size_t end = chunkBegins[c + 1];
+            Chunk &chunk = chunks[c];
+            chunk.vertices.clear();
+            VertexDedupTable local(chunk.vertices, VertexDedupTable::expectedVertices(end - begin));
+
+            for (size_t i = begin; i < end; ++i)
+                indices[base + i] = local.insert(corner(i)).first;
+            findKnown(chunk);
+        });
+
+        mergeChunks(chunkCount, chunkBegins, base);
+    }
+
+private:
+    /** @brief Per-chunk scratch space, kept across batches. */
+    struct Chunk {
+        std::vector<Vertex> vertices;  ///< Chunk-local unique vertices, first occurrence first
+        std::vector<uint64_t> hashes;  ///< vertexHash64() of each local vertex
+        std::vector<uint32_t> remap;   ///< Stream-wide index of each local vertex
+    };
+
+    /**
+     * @brief Hashes a chunk's vertices and looks them up in the stream-wide table.
+     *
+     * Runs on the pool while the stream-wide table is read-only. Vertices
+     * seen in earlier batches get their index in 'remap'; the rest get
+     * VertexDedupTable::kEmpty and are inserted by mergeChunks().
+     *
+     * @param chunk Chunk whose 'vertices' are filled.
+     */
+    void findKnown(Chunk &chunk) const;
+
+    /**
+     * @brief Merges chunk-local results into the stream-wide table.
+     *
+     * @param chunkCount Number of chunks used by the batch.
+     * @param chunkBegins First corner of each chunk within the batch, plus
+     *        the batch's corner count.
+     * @param base Position of the batch's first corner in 'indices'.
+     */
+    void mergeChunks(size_t chunkCount, std::span<const size_t> chunkBegins, size_t base);
+
+    std::vector<uint32_t> &indices;   ///< One index per corner so far
+    VertexDedupTable table;           ///< Stream-wide table appending the vertices
+    unsigned threadCount;             ///< Resolved thread limit for chunked batches
+    std::unique_ptr<WorkerPool> pool; ///< Started by the first chunked batch
+    std::vector<Chunk> chunks;        ///< Scratch space of the chunked batches
+};
+
+/**
+ * @brief Deduplicates a corner stream into unique vertices and indices.
+ *
+ * @tparam CornerFn Callable as 'Vertex(size_t corner)'; invoked concurrently
+ *         from several threads, so it must not modify shared state.
+ * @param cornerCount Number of corners in the stream.
+ * @param corner Builds the vertex of one corner.
+ * @param vertices Receives the unique vertices (previous contents are replaced).
+ * @param indices Receives one index per corner (previous contents are replaced).
+ * @param threadCount Thread limit; 0 uses every hardware thread and 1 runs
+ *        serially on the calling thread.
+ *
+ * @note Vertices compare with Vertex::operator==, so a vertex containing NaN
+ *       never matches and gets its own entry.
+ */
+template <class CornerFn>
+void deduplicate(size_t cornerCount, const CornerFn &corner,
+                 std::vector<Vertex> &vertices, std::vector<uint32_t> &indices,
+                 unsigned threadCount = 0) {
+    Deduplicator deduplicator(vertices, indices,
+                              VertexDedupTable::expectedVertices(cornerCount), threadCount);
+    deduplicator.append(cornerCount, corner);
+}
+
+} // namespace meshimport
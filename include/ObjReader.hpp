@@ -0,0 +1,87 @@
+#pragma once
+
+#include "Vertex.hpp" // for Vertex
+#include <cstddef>    // for size_t
+#include <cstdint>    // for uint32_t
+#include <string>     // for the file path
+#include <vector>     // for the output arrays
+
+/**
+ * @file ObjReader.hpp
+ * @brief Streaming Wavefront OBJ import into deduplicated vertices and indices.
+ *
+ * Loading a whole OBJ through TinyOBJLoader first materializes every position,
+ * normal and texture coordinate plus a 12-byte index triple per corner, and
+ * only then deduplicates. On multi-million-triangle meshes those arrays are
+ * several times the size of the final buffers.
+ *
+ * meshimport::importObj() instead reads the file in fixed-size chunks on a
+ * parser thread, resolves every face corner to a full Vertex as soon as its
+ * line is parsed, and hands the corners over in batches. The calling thread
+ * feeds each batch to a meshimport::Deduplicator while the parser fills the
+ * next one, so parsing overlaps deduplication. A batch holds
+ * kMinCornersPerChunk corners per deduplication thread (at least
+ * kObjBatchCorners), so every batch keeps all of them busy. Besides the
+ * output, working memory is the positions and texture coordinates read so
+ * far, one read chunk and at most kObjQueueDepth + 2 corner batches.
+ *
+ * Supported subset:
+ *  - 'v x y z' positions (a fourth component or vertex colors are ignored).
+ *  - 'vt u v' texture coordinates (v is flipped for Vulkan).
+ *  - 'f' faces with 'p', 'p/t', 'p//n' or 'p/t/n' corners, including negative
+ *    (relative) indices. Polygons are fan-triangulated.
+ *  - Everything else (normals, groups, materials, comments) is skipped.
+ *
+ * @code
+ * std::vector<Vertex> vertices;
+ * std::vector<uint32_t> indices;
+ * meshimport::importObj("models/statue.obj", vertices, indices);
+ * @endcode
+ *
+ * @note Numbers are parsed with std::strtof, which follows the C locale; the
+ *       renderer never changes it.
+ */
+namespace meshimport {
+
+/** @brief Bytes read from the file per chunk. */
+constexpr size_t kObjReadBytes = size_t{1} << 20;
+
+/** @brief Minimum corners per batch handed from the parser to deduplication (8 MiB). */
+constexpr size_t kObjBatchCorners = size_t{1} << 18;
+
+/**
+ * @brief Corners per batch for a deduplication thread count.
+ *
+ * @param threadCount Thread limit; 0 uses every hardware thread.
+ * @return kMinCornersPerChunk per thread, and at least kObjBatchCorners.
+ */
+size_t objBatchCorners(unsigned threadCount);
+
+/** @brief Parsed batches that may wait for deduplication before the parser blocks. */
+constexpr size_t kObjQueueDepth = 2;
+
+/**
+ * @brief Imports an OBJ file as deduplicated vertices and a triangle index list.
+ *
+ * The result is identical to running meshimport::deduplicate() over the
+ * file's triangulated corners in file order. Corners without a texture
+ * coordinate get the one 'vt 0 0' would give, (0, 1) after the V flip; every
+ * vertex is white.
+ *
+ * @param path Path of the '.obj' file.
+ * @param vertices Receives the unique vertices (previous contents are replaced).
+ * @param indices Receives three indices per triangle (previous contents are replaced).
+ * @param threadCount Thread limit for deduplication; 0 uses every hardware
+ *        thread. Parsing always runs on one extra thread.
+ * @param contentHash If not null, receives the XXH64 of the bytes parsed,
+ *        computed as each chunk is read (the value MeshCache stamps a cache
+ *        with), so the file need not be read again to be hashed.
+ * @throws std::runtime_error if the file cannot be read or a line is
+ *         malformed (the message names the line), including faces that
+ *         reference a vertex not yet defined.
+ */
+void importObj(const std::string &path, std::vector<Vertex> &vertices,
+               std::vector<uint32_t> &indices, unsigned threadCount = 0,
+               uint64_t *contentHash = nullptr);
+
+} // namespace meshimport
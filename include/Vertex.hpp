@@ -95,6 +95,7 @@ struct Vertex {
      *
      * @note This operator enables vertices to be de-duplicated in
      *       hash-based containers such as std::unordered_set.
+     * @see vertexEqual() in VertexHash.hpp, a branch-free SIMD equivalent.
      */
     bool operator==(const Vertex &other) const {
         return position == other.position &&
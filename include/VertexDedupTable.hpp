@@ -0,0 +1,151 @@
+#pragma once
+
+#include "Vertex.hpp"     // for Vertex
+#include "VertexHash.hpp" // for vertexHash64, vertexEqual
+#include <algorithm>      // for std::max
+#include <bit>            // for std::bit_ceil
+#include <cstddef>        // for size_t
+#include <cstdint>        // for uint32_t, uint64_t
+#include <utility>        // for std::pair
+#include <vector>         // for slot and vertex storage
+
+/**
+ * @file VertexDedupTable.hpp
+ * @brief Flat, open-addressing table for deduplicating mesh vertices.
+ *
+ * std::unordered_map<Vertex, uint32_t> allocates one node per unique vertex
+ * and chases a pointer per lookup. VertexDedupTable instead keeps a single
+ * power-of-two array of 'uint32_t' slots, each holding an index into the
+ * vertex array it deduplicates into (or kEmpty). Lookups hash the vertex
+ * with vertexHash64() and probe linearly, comparing against the referenced
+ * vertices with vertexEqual() (same result as Vertex::operator==).
+ *
+ * Per unique vertex the table costs 4 bytes divided by the load factor
+ * (kMaxLoad), versus a heap node plus a bucket pointer for the map.
+ *
+ * @code
+ * std::vector<Vertex> vertices;
+ * VertexDedupTable table(vertices, VertexDedupTable::expectedVertices(indexCount));
+ * auto [index, inserted] = table.insert(vertex);
+ * @endcode
+ */
+class VertexDedupTable {
+public:
+    /** @brief Slot value marking an unused slot. */
+    static constexpr uint32_t kEmpty = UINT32_MAX;
+
+    /** @brief The table grows when more than half of the slots are used. */
+    static constexpr double kMaxLoad = 0.5;
+
+    /**
+     * @brief Estimates the unique vertex count of an index stream.
+     *
+     * Closed triangle meshes have about one vertex per six corners; seams in
+     * the texture coordinates add more. Sizing for a quarter of the corners
+     * avoids rehashing on typical meshes without reserving a slot per corner.
+     *
+     * @param indexCount Number of corners (indices) that will be inserted.
+     * @return Expected number of unique vertices.
+     */
+    static size_t expectedVertices(size_t indexCount) { return indexCount / 4; }
+
+    /**
+     * @brief Creates an empty table appending to 'vertices'.
+     *
+     * @param vertices Vertex array the slots index into. New vertices are
+     *        appended to it; vertices already in it are not indexed.
+     * @param expectedCount Number of unique vertices to size the table for.
+     */
+    explicit VertexDedupTable(std::vector<Vertex> &vertices, size_t expectedCount = 0)
+        : vertices(vertices) {
+        slots.assign(capacityFor(expectedCount), kEmpty);
+        mask = slots.size() - 1;
+    }
+
+    /**
+     * @brief Finds a vertex or appends it to the vertex array.
+     *
+     * @param vertex Vertex to look up.
+     * @return Index of the equal vertex in the vertex array, and whether it was
+     *         appended by this call.
+     */
+    std::pair<uint32_t, bool> insert(const Vertex &vertex) {
+        return insert(vertex, vertexHash64(vertex));
+    }
+
+    /**
+     * @brief insert() with the hash already computed.
+     *
+     * @param vertex Vertex to look up.
+     * @param hash vertexHash64(vertex).
+     * @return Same as insert(const Vertex&).
+     */
+    std::pair<uint32_t, bool> insert(const Vertex &vertex, uint64_t hash) {
+        if (count + 1 > static_cast<size_t>(slots.size() * kMaxLoad))
+            grow();
+
+        for (size_t slot = hash & mask;; slot = (slot + 1) & mask) {
+            const uint32_t index = slots[slot];
+            if (index == kEmpty) {
+                const auto added = static_cast<uint32_t>(vertices.size());
+                vertices.push_back(vertex);
+                slots[slot] = added;
+                ++count;
+                return {added, true};
+            }
+            if (vertexEqual(vertices[index], vertex))
+                return {index, false};
+        }
+    }
+
+    /**
+     * @brief Looks a vertex up without inserting it.
+     *
+     * Only reads the table, so several threads may call it concurrently as
+     * long as nobody inserts meanwhile.
+     *
+     * @param vertex Vertex to look up.
+     * @param hash vertexHash64(vertex).
+     * @return Index of the equal vertex in the vertex array, or kEmpty.
+     */
+    uint32_t find(const Vertex &vertex, uint64_t hash) const {
+        for (size_t slot = hash & mask;; slot = (slot + 1) & mask) {
+            const uint32_t index = slots[slot];
+            if (index == kEmpty || vertexEqual(vertices[index], vertex))
+                return index;
+        }
+    }
+
+    /** @brief Number of vertices inserted through this table. */
+    size_t size() const { return count; }
+
+    /** @brief Number of slots. */
+    size_t capacity() const { return slots.size(); }
+
+private:
+    /** @brief Smallest power-of-two slot count holding 'count' within kMaxLoad. */
+    static size_t capacityFor(size_t count) {
+        return std::bit_ceil(std::max<size_t>(16, static_cast<size_t>(count / kMaxLoad) + 1));
+    }
+
+    /** @brief Doubles the slot array and reinserts every index. */
+    void grow() {
+        std::vector<uint32_t> old(slots.size() * 2, kEmpty);
+        old.swap(slots);
+        mask = slots.size() - 1;
+
+        for (const uint32_t index : old) {
+            if (index == kEmpty)
+                continue;
+            size_t slot = vertexHash64(vertices[index]) & mask;
+            while (slots[slot] != kEmpty)
+                slot = (slot + 1) & mask;
+            slots[slot] = index;
+        }
+    }
+
+    std::vector<Vertex> &vertices; ///< Vertex array the slots index into
+    std::vector<uint32_t> slots;   ///< Vertex indices, or kEmpty
+    size_t mask = 0;               ///< slots.size() - 1
+    size_t count = 0;              ///< Occupied slots
+};
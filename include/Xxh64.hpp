@@ -0,0 +1,136 @@
+#pragma once
+
+#include "VertexHash.hpp" // for the XXH64 primes and rounds
+#include <algorithm>      // for std::min
+#include <cstddef>        // for size_t
+#include <cstdint>        // for uint64_t
+#include <cstring>        // for std::memcpy
+
+/**
+ * @file Xxh64.hpp
+ * @brief Streaming XXH64 (seed 0) for hashing files as they are read.
+ *
+ * MeshCache stamps a cache with the XXH64 of its source file. Xxh64 lets the
+ * code that reads the source anyway (e.g. meshimport::importObj()) compute
+ * that hash chunk by chunk, so the file is not read a second time just to be
+ * hashed. The result is the reference XXH64 whatever the chunk sizes.
+ *
+ * @code
+ * Xxh64 hasher;
+ * while (size_t n = read(buffer))
+ *     hasher.update(buffer, n);
+ * const uint64_t hash = hasher.digest();
+ * @endcode
+ */
+class Xxh64 {
+public:
+    /**
+     * @brief XXH64 of a byte range in one call.
+     *
+     * @param data First byte (may be null if 'size' is 0).
+     * @param size Number of bytes.
+     * @return 64-bit hash.
+     */
+    static uint64_t hash(const void *data, size_t size) {
+        Xxh64 hasher;
+        hasher.update(data, size);
+        return hasher.digest();
+    }
+
+    /**
+     * @brief Appends bytes to the hashed stream.
+     *
+     * @param data First byte (may be null if 'size' is 0).
+     * @param size Number of bytes.
+     */
+    void update(const void *data, size_t size) {
+        const auto *p = static_cast<const unsigned char *>(data);
+        total += size;
+
+        // Complete a stripe left over from the previous call
+        if (buffered > 0) {
+            const size_t take = std::min(size, sizeof(buffer) - buffered);
+            std::memcpy(buffer + buffered, p, take);
+            buffered += take;
+            p += take;
+            size -= take;
+            if (buffered < sizeof(buffer))
+                return;
+            consumeStripe(buffer);
+            buffered = 0;
+        }
+
+        for (; size >= sizeof(buffer); p += sizeof(buffer), size -= sizeof(buffer))
+            consumeStripe(p);
+
+        if (size > 0) {
+            std::memcpy(buffer, p, size);
+            buffered = size;
+        }
+    }
+
+    /** @brief Hash of every byte passed to update() so far. */
+    uint64_t digest() const {
+        using namespace vertexhash_detail;
+        constexpr uint64_t kPrime5 = 0x27D4EB2F165667C5ull;
+
+        uint64_t hash;
+        if (total >= sizeof(buffer)) {
+            hash = std::rotl(lanes[0], 1) + std::rotl(lanes[1], 7) +
+                   std::rotl(lanes[2], 12) + std::rotl(lanes[3], 18);
+            for (const uint64_t lane : lanes)
+                hash = mergeRound(hash, lane);
+        } else {
+            hash = kPrime5;
+        }
+        hash += total;
+
+        const unsigned char *p = buffer;
+        const unsigned char *const end = buffer + buffered;
+        for (; p + 8 <= end; p += 8) {
+            hash ^= mixRound(0, load<uint64_t>(p));
+            hash = std::rotl(hash, 27) * kPrime1 + kPrime4;
+        }
+        if (p + 4 <= end) {
+            hash ^= static_cast<uint64_t>(load<uint32_t>(p)) * kPrime1;
+            hash = std::rotl(hash, 23) * kPrime2 + kPrime3;
+            p += 4;
+        }
+        for (; p < end; ++p) {
+            hash ^= *p * kPrime5;
+            hash = std::rotl(hash, 11) * kPrime1;
+        }
+
+        // Avalanche
+        hash ^= hash >> 33;
+        hash *= kPrime2;
+        hash ^= hash >> 29;
+        hash *= kPrime3;
+        hash ^= hash >> 32;
+        return hash;
+    }
+
+private:
+    /** @brief Unaligned load in host byte order. */
+    template <class T> static T load(const unsigned char *p) {
+        T value;
+        std::memcpy(&value, p, sizeof(T));
+        return value;
+    }
+
+    /** @brief Mixes one 32-byte stripe into the four lanes. */
+    void consumeStripe(const unsigned char *stripe) {
+        using vertexhash_detail::mixRound;
+        lanes[0] = mixRound(lanes[0], load<uint64_t>(stripe));
+        lanes[1] = mixRound(lanes[1], load<uint64_t>(stripe + 8));
+        lanes[2] = mixRound(lanes[2], load<uint64_t>(stripe + 16));
+        lanes[3] = mixRound(lanes[3], load<uint64_t>(stripe + 24));
+    }
+
+    uint64_t lanes[4] = {vertexhash_detail::kPrime1 + vertexhash_detail::kPrime2,
+                         vertexhash_detail::kPrime2, 0,
+                         0 - vertexhash_detail::kPrime1}; ///< Accumulators (seed 0)
+    unsigned char buffer[32];                            ///< Partial stripe
+    size_t buffered = 0;                                 ///< Bytes in 'buffer'
+    uint64_t total = 0;                                  ///< Bytes hashed so far
+};
@@ -29,6 +29,7 @@
 #include <limits>
 #include <memory>
 #include <set>
+#include <span>
 #include <stdexcept>
 #include <unordered_map>
 #include <vector>
@@ -52,6 +53,11 @@
 // Project Headers //
 // =============== //
 #include "ChronoProfiler.hpp"
+#include "FramePacer.hpp"
+#include "GpuProfiler.hpp"
+#include "MeshCache.hpp"
+#include "MeshImport.hpp"
+#include "ObjReader.hpp"
 #include "ProfilerUI.hpp"
 #include "UniformBufferObject.hpp"
 #include "Vertex.hpp"
@@ -130,6 +136,9 @@ public:
 private:
   ProfilerUI profilerUI; // Initialize here with default history size
 
+  /** @brief Frame-time histograms and hitch detection for every frame */
+  FramePacer framePacer;
+
   /** @brief RAII context for Vulkan initialization */
   vk::raii::Context context;
 
@@ -220,6 +229,9 @@ private:
   /** @brief Fences to synchronize CPU and GPU */
   std::vector<vk::raii::Fence> inFlightFences;
 
+  /** @brief GPU timestamp zones (declared after the device it depends on) */
+  GpuProfiler gpuProfiler;
+
   /** @brief Vertex buffer */
   vk::raii::Buffer vertexBuffer = nullptr;
 
@@ -277,6 +289,15 @@ private:
   /** @brief Indices loaded from the model */
   std::vector<uint32_t> indices;
 
+  /** @brief Mapped '.amesh' cache the model was loaded from, if any */
+  std::unique_ptr<MeshCache> meshCache;
+
+  /** @brief Model vertices to upload: 'vertices' or the mapped cache */
+  std::span<const Vertex> modelVertices;
+
+  /** @brief Model indices to upload and draw: 'indices' or the mapped cache */
+  std::span<const uint32_t> modelIndices;
+
   /** @brief Current frame index for multi-frame rendering */
   uint32_t currentFrame = 0;
 
@@ -304,7 +325,8 @@ private:
   vk::SampleCountFlagBits getMaxUsableSampleCount();
 
   /**
-   * @brief Loads a 3D model from MODEL_PATH into `vertices` and `indices`.
+   * @brief Loads a 3D model from its '.amesh' cache, or imports MODEL_PATH
+   * into `vertices` and `indices` and writes the cache.
    *
    * @throws std::runtime_error on file I/O failure or invalid model format.
    */
@@ -0,0 +1,151 @@
+#if defined(PROFILER)
+
+#include "ChronoProfiler.hpp"
+
+/**
+ * @file ChronoAllocHooks.cpp
+ * @brief Global operator new/delete replacements feeding allocation tracking.
+ *
+ * @details
+ * Every replaceable form of operator new allocates with malloc (or
+ * posix_memalign for over-aligned types) and reports the requested size to
+ * ChronoProfiler::recordAllocation(), which charges it to the innermost open
+ * zone while allocation tracking is enabled. Every form of operator delete
+ * releases with free. Frees are not attributed: the request size is not
+ * known for all of them, and the goal is to find allocations on hot paths.
+ *
+ * Only linked into profiling builds, so release builds keep the standard
+ * library's allocator untouched.
+ */
+
+#include <cstdlib> ///< std::malloc / std::free / posix_memalign
+#include <new>     ///< std::bad_alloc, std::align_val_t, std::get_new_handler
+
+namespace {
+
+/**
+ * @brief Allocate like the standard operator new.
+ * @param size Requested size
+ * @return Non-null pointer
+ * @throws std::bad_alloc when memory is exhausted and no new-handler helps
+ */
+void *allocate(std::size_t size) {
+  for (;;) {
+    if (void *ptr = std::malloc(size ? size : 1)) {
+      ChronoProfiler::recordAllocation(size);
+      return ptr;
+    }
+    std::new_handler handler = std::get_new_handler();
+    if (!handler)
+      throw std::bad_alloc();
+    handler();
+  }
+}
+
+/**
+ * @brief Allocate with an alignment above the default new alignment.
+ * @param size Requested size
+ * @param alignment Requested alignment (a power of two)
+ * @return Non-null pointer
+ * @throws std::bad_alloc when memory is exhausted and no new-handler helps
+ */
+void *allocateAligned(std::size_t size, std::align_val_t alignment) {
+  std::size_t align = static_cast<std::size_t>(alignment);
+  if (align < sizeof(void *))
+    align = sizeof(void *); // posix_memalign minimum
+  for (;;) {
+    void *ptr = nullptr;
+    if (posix_memalign(&ptr, align, size ? size : 1) == 0) {
+      ChronoProfiler::recordAllocation(size);
+      return ptr;
+    }
+    std::new_handler handler = std::get_new_handler();
+    if (!handler)
+      throw std::bad_alloc();
+    handler();
+  }
+}
+
+} // namespace
+
+// ------------ //
+// operator new //
+// ------------ //
+
+void *operator new(std::size_t size) { return allocate(size); }
+void *operator new[](std::size_t size) { return allocate(size); }
+
+void *operator new(std::size_t size, const std::nothrow_t &) noexcept {
+  try {
+    return allocate(size);
+  } catch (...) {
+    return nullptr;
+  }
+}
+void *operator new[](std::size_t size, const std::nothrow_t &) noexcept {
+  try {
+    return allocate(size);
+  } catch (...) {
+    return nullptr;
+  }
+}
+
+void *operator new(std::size_t size, std::align_val_t alignment) {
+  return allocateAligned(size, alignment);
+}
+void *operator new[](std::size_t size, std::align_val_t alignment) {
+  return allocateAligned(size, alignment);
+}
+
+void *operator new(std::size_t size, std::align_val_t alignment,
+                   const std::nothrow_t &) noexcept {
+  try {
+    return allocateAligned(size, alignment);
+  } catch (...) {
+    return nullptr;
+  }
+}
+void *operator new[](std::size_t size, std::align_val_t alignment,
+                     const std::nothrow_t &) noexcept {
+  try {
+    return allocateAligned(size, alignment);
+  } catch (...) {
+    return nullptr;
+  }
+}
+
+// --------------- //
+// operator delete //
+// --------------- //
+
+void operator delete(void *ptr) noexcept { std::free(ptr); }
+void operator delete[](void *ptr) noexcept { std::free(ptr); }
+void operator delete(void *ptr, std::size_t) noexcept { std::free(ptr); }
+void operator delete[](void *ptr, std::size_t) noexcept { std::free(ptr); }
+void operator delete(void *ptr, const std::nothrow_t &) noexcept {
+  std::free(ptr);
+}
+void operator delete[](void *ptr, const std::nothrow_t &) noexcept {
+  std::free(ptr);
+}
+
+void operator delete(void *ptr, std::align_val_t) noexcept { std::free(ptr); }
+void operator delete[](void *ptr, std::align_val_t) noexcept {
+  std::free(ptr);
+}
+void operator delete(void *ptr, std::size_t, std::align_val_t) noexcept {
+  std::free(ptr);
+}
+void operator delete[](void *ptr, std::size_t, std::align_val_t) noexcept {
+  std::free(ptr);
+}
+void operator delete(void *ptr, std::align_val_t,
+                     const std::nothrow_t &) noexcept {
+  std::free(ptr);
+}
+void operator delete[](void *ptr, std::align_val_t,
+                       const std::nothrow_t &) noexcept {
+  std::free(ptr);
+}
+
+#endif // defined(PROFILER)
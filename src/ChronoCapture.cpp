@@ -0,0 +1,428 @@
+#include "ChronoCapture.hpp"
+
+/**
+ * @file ChronoCapture.cpp
+ * @brief Encoding and decoding of the binary '.chrono' capture format.
+ *
+ * @details
+ * Built into the application (for ChronoTraceWriter) and into the standalone
+ * 'chrono-convert' tool, so nothing here depends on the live profiler state.
+ *
+ * Per-event encoding inside a 'Frame' chunk, all varints:
+ *  - zigzag(threadId - previous threadId)
+ *  - zigzag(startTicks - previous startTicks), the first relative to the frame
+ *  - endTicks - startTicks, or the raw value for counter/gauge samples
+ *  - nameId, categoryId, depth
+ *  - index - parentIndex, or 0 for a root zone
+ *  - flags
+ * Events are grouped by thread and ordered by start within a thread, so the
+ * thread and start deltas are almost always one or two bytes.
+ */
+
+#include <algorithm> ///< std::upper_bound over thread name changes
+#include <cstdio>    ///< std::snprintf for \u escapes
+#include <iterator>  ///< std::prev
+#include <stdexcept> ///< std::runtime_error on malformed input
+
+#include <fcntl.h>    ///< open()
+#include <sys/mman.h> ///< mmap()/munmap()
+#include <sys/stat.h> ///< fstat() for the file size
+#include <unistd.h>   ///< close()
+
+namespace chronocap {
+
+// ------------- //
+// Encoding      //
+// ------------- //
+
+/**
+ * @brief Appends a quoted, escaped JSON string.
+ * @param out Destination buffer
+ * @param text Raw text
+ */
+void appendJsonString(std::string &out, std::string_view text) {
+  out += '"';
+  for (char c : text) {
+    switch (c) {
+    case '"':
+      out += "\\\"";
+      break;
+    case '\\':
+      out += "\\\\";
+      break;
+    case '\n':
+      out += "\\n";
+      break;
+    case '\t':
+      out += "\\t";
+      break;
+    default:
+      if (static_cast<unsigned char>(c) < 0x20) {
+        char escaped[8];
+        std::snprintf(escaped, sizeof(escaped), "\\u%04x", c);
+        out += escaped;
+      } else {
+        out += c;
+      }
+    }
+  }
+  out += '"';
+}
+
+/**
+ * @brief Write the fixed capture header.
+ * @param out Destination buffer
+ * @param originTicks Tick value of trace time 0
+ * @param tscTicks Whether ticks come from the TSC
+ */
+void writeHeader(std::string &out, uint64_t originTicks, bool tscTicks) {
+  out.append(kMagic, sizeof(kMagic));
+  putFixed<uint16_t>(out, kVersion);
+  putFixed<uint16_t>(out, kHeaderSize);
+  putFixed<uint32_t>(out, tscTicks ? kFlagTscTicks : 0u);
+  putFixed<uint64_t>(out, originTicks);
+}
+
+/**
+ * @brief Append a framed chunk.
+ * @param out Destination buffer
+ * @param type Chunk type tag
+ * @param payload Chunk body
+ */
+void writeChunk(std::string &out, ChunkType type, std::string_view payload) {
+  out += static_cast<char>(type);
+  putVarint(out, payload.size());
+  out.append(payload);
+}
+
+/**
+ * @brief Delta/varint encode one frame.
+ * @param payload Destination buffer
+ * @param frameIndex Sequential frame index
+ * @param frameStartTicks Absolute frame start tick
+ * @param events Frame events with parent indices resolved
+ */
+void encodeFrame(std::string &payload, uint64_t frameIndex,
+                 uint64_t frameStartTicks,
+                 std::span<const ChronoProfiler::Event> events) {
+  putVarint(payload, frameIndex);
+  putFixed<uint64_t>(payload, frameStartTicks);
+  putVarint(payload, events.size());
+
+  uint32_t prevThread = 0;
+  uint64_t prevStart = frameStartTicks;
+  for (size_t i = 0; i < events.size(); ++i) {
+    const auto &evt = events[i];
+    putVarint(payload, zigzag(static_cast<int64_t>(evt.threadId) -
+                              static_cast<int64_t>(prevThread)));
+    putVarint(payload, zigzag(static_cast<int64_t>(evt.startTicks - prevStart)));
+    putVarint(payload, evt.isValue() ? evt.endTicks
+                                     : evt.endTicks - evt.startTicks);
+    putVarint(payload, evt.nameId);
+    putVarint(payload, evt.categoryId);
+    putVarint(payload, evt.depth);
+    putVarint(payload, evt.parentIndex < 0
+                           ? 0
+                           : i - static_cast<size_t>(evt.parentIndex));
+    putVarint(payload, evt.flags);
+
+    prevThread = evt.threadId;
+    prevStart = evt.startTicks;
+  }
+}
+
+// ------------- //
+// Decoding      //
+// ------------- //
+
+void ByteReader::require(size_t size) const {
+  if (size > remaining())
+    throw std::runtime_error("chrono capture: unexpected end of data");
+}
+
+uint64_t ByteReader::varint() {
+  uint64_t value = 0;
+  for (int shift = 0; shift < 64; shift += 7) {
+    require(1);
+    const uint8_t byte = data[pos++];
+    value |= static_cast<uint64_t>(byte & 0x7F) << shift;
+    if ((byte & 0x80) == 0)
+      return value;
+  }
+  throw std::runtime_error("chrono capture: varint too long");
+}
+
+double ByteReader::float64() {
+  const uint64_t bits = fixed<uint64_t>();
+  double value;
+  std::memcpy(&value, &bits, sizeof(value));
+  return value;
+}
+
+std::string_view ByteReader::bytes(size_t size) {
+  require(size);
+  std::string_view view(reinterpret_cast<const char *>(data.data() + pos),
+                        size);
+  pos += size;
+  return view;
+}
+
+/**
+ * @brief Decode a 'Frame' chunk payload produced by encodeFrame().
+ *
+ * @throws std::runtime_error if the payload is truncated or a parent index
+ *         points outside the frame
+ */
+void decodeFrame(ByteReader &reader, uint64_t &frameIndex,
+                 uint64_t &frameStartTicks,
+                 std::vector<ChronoProfiler::Event> &events) {
+  frameIndex = reader.varint();
+  frameStartTicks = reader.fixed<uint64_t>();
+  const uint64_t count = reader.varint();
+
+  // Every event takes at least 8 bytes; reject counts the payload cannot hold
+  if (count > reader.remaining() / 8)
+    throw std::runtime_error("chrono capture: bad frame event count");
+
+  events.clear();
+  events.reserve(count);
+
+  uint32_t prevThread = 0;
+  uint64_t prevStart = frameStartTicks;
+  for (uint64_t i = 0; i < count; ++i) {
+    ChronoProfiler::Event evt{};
+    evt.threadId =
+        static_cast<uint32_t>(prevThread + unzigzag(reader.varint()));
+    evt.startTicks = prevStart + static_cast<uint64_t>(unzigzag(reader.varint()));
+    const uint64_t span = reader.varint(); // Duration, or value of a sample
+    evt.nameId = static_cast<uint16_t>(reader.varint());
+    evt.categoryId = static_cast<uint16_t>(reader.varint());
+    evt.depth = static_cast<uint16_t>(reader.varint());
+
+    const uint64_t parentDelta = reader.varint();
+    if (parentDelta > i)
+      throw std::runtime_error("chrono capture: bad parent index");
+    evt.parentIndex = parentDelta == 0 ? -1 : static_cast<int32_t>(i - parentDelta);
+    evt.flags = static_cast<uint16_t>(reader.varint());
+    evt.endTicks = evt.isValue() ? span : evt.startTicks + span;
+
+    events.push_back(evt);
+    prevThread = evt.threadId;
+    prevStart = evt.startTicks;
+  }
+}
+
+// ---------- //
+// MappedFile //
+// ---------- //
+
+/**
+ * @brief Map a file read-only.
+ * @param path File to map
+ */
+MappedFile::MappedFile(const std::string &path) {
+  const int fd = ::open(path.c_str(), O_RDONLY);
+  if (fd < 0)
+    throw std::runtime_error("Failed to open file: " + path);
+
+  struct stat info {};
+  if (::fstat(fd, &info) != 0) {
+    ::close(fd);
+    throw std::runtime_error("Failed to stat file: " + path);
+  }
+
+  size = static_cast<size_t>(info.st_size);
+  if (size > 0) {
+    void *mapping = ::mmap(nullptr, size, PROT_READ, MAP_PRIVATE, fd, 0);
+    if (mapping == MAP_FAILED) {
+      ::close(fd);
+      throw std::runtime_error("Failed to map file: " + path);
+    }
+    data = static_cast<const uint8_t *>(mapping);
+  }
+  ::close(fd); // The mapping keeps the file referenced
+}
+
+MappedFile::~MappedFile() {
+  if (data)
+    ::munmap(const_cast<uint8_t *>(data), size);
+}
+
+// ------------- //
+// CaptureReader //
+// ------------- //
+
+/**
+ * @brief Validate the header of an in-memory capture.
+ * @param bytes Capture contents
+ */
+CaptureReader::CaptureReader(std::span<const uint8_t> bytes) : data(bytes) {
+  ByteReader header(bytes);
+  if (bytes.size() < kHeaderSize ||
+      header.bytes(sizeof(kMagic)) != std::string_view(kMagic, sizeof(kMagic))) {
+    throw std::runtime_error("not a chrono capture (bad signature)");
+  }
+
+  const uint16_t version = header.fixed<uint16_t>();
+  const uint16_t headerSize = header.fixed<uint16_t>();
+  if (version > kVersion || headerSize < kHeaderSize ||
+      headerSize > bytes.size()) {
+    throw std::runtime_error("unsupported chrono capture version " +
+                             std::to_string(version));
+  }
+
+  flags = header.fixed<uint32_t>();
+  originTicks = header.fixed<uint64_t>();
+  scanCursor = headerSize;
+}
+
+/**
+ * @brief Walk chunk headers until the next frame chunk and index it.
+ * @return False when the capture (or its last complete chunk) is exhausted
+ *
+ * @details Frame payloads are skipped without decoding; only the metadata
+ *          chunks in between are applied.
+ */
+bool CaptureReader::indexNextFrame() {
+  while (!scanComplete && scanCursor < data.size()) {
+    ByteReader chunk(data.subspan(scanCursor));
+    ChunkType type;
+    uint64_t size;
+    try {
+      type = static_cast<ChunkType>(chunk.fixed<uint8_t>());
+      size = chunk.varint();
+    } catch (const std::runtime_error &) {
+      break; // Truncated chunk header at the end of the file
+    }
+    if (size > chunk.remaining())
+      break; // Truncated payload: capture was cut short
+
+    const size_t payloadOffset = scanCursor + chunk.offset();
+    scanCursor = payloadOffset + size;
+
+    if (type == ChunkType::Frame) {
+      frames.push_back({payloadOffset, size, scanMsPerTick});
+      return true;
+    }
+    ByteReader payload(data.subspan(payloadOffset, size));
+    applyChunk(type, payload);
+  }
+  scanComplete = true;
+  return false;
+}
+
+/**
+ * @brief Decode one frame by position.
+ * @param position Zero-based position of the frame in the file
+ * @param frame Output frame
+ * @return False if there is no such frame
+ */
+bool CaptureReader::readFrame(size_t position, Frame &frame) {
+  while (frames.size() <= position && indexNextFrame()) {
+  }
+  if (position >= frames.size())
+    return false;
+
+  const FrameEntry &entry = frames[position];
+  ByteReader payload(data.subspan(entry.offset, entry.size));
+  decodeFrame(payload, frame.index, frame.startTicks, frame.events);
+  msPerTick = entry.msPerTick;
+  framePosition = position;
+  return true;
+}
+
+/**
+ * @brief Decode chunks until the next frame.
+ * @param frame Output frame
+ * @return False when the capture (or its last complete chunk) is exhausted
+ */
+bool CaptureReader::nextFrame(Frame &frame) {
+  if (!readFrame(nextPosition, frame))
+    return false;
+  ++nextPosition;
+  return true;
+}
+
+/**
+ * @brief Index the remaining capture and report its length.
+ * @return Number of complete frames
+ */
+size_t CaptureReader::frameCount() {
+  while (indexNextFrame()) {
+  }
+  return frames.size();
+}
+
+/**
+ * @brief Apply a string, thread or clock chunk.
+ *
+ * @details Unknown chunk types are skipped so older readers can open captures
+ *          that gained new optional chunks.
+ */
+void CaptureReader::applyChunk(ChunkType type, ByteReader &payload) {
+  switch (type) {
+  case ChunkType::String: {
+    const uint64_t id = payload.varint();
+    const uint32_t color = payload.fixed<uint32_t>();
+    const std::string_view text = payload.bytes(payload.varint());
+    if (id > UINT16_MAX)
+      throw std::runtime_error("chrono capture: bad string id");
+    if (strings.size() <= id) {
+      strings.resize(id + 1);
+      colors.resize(id + 1, 0);
+    }
+    strings[id] = std::string(text);
+    colors[id] = color;
+    break;
+  }
+  case ChunkType::Thread: {
+    // Applies from the next frame to be indexed on
+    const uint32_t threadId = static_cast<uint32_t>(payload.varint());
+    const std::string_view name = payload.bytes(payload.varint());
+    std::vector<ThreadNameChange> &changes = threadNames[threadId];
+    if (!changes.empty() && changes.back().firstFrame == frames.size())
+      changes.back().name = name;
+    else
+      changes.push_back({frames.size(), std::string(name)});
+    break;
+  }
+  case ChunkType::Clock:
+    scanMsPerTick = payload.float64();
+    break;
+  default:
+    break;
+  }
+}
+
+std::string_view CaptureReader::getString(uint16_t id) const {
+  return id < strings.size() ? std::string_view(strings[id])
+                             : std::string_view();
+}
+
+uint32_t CaptureReader::getColor(uint16_t id) const {
+  return id < colors.size() ? colors[id] : 0;
+}
+
+/**
+ * @brief Resolve a thread name against the frame last read.
+ * @param threadId Thread ID of an event in that frame
+ * @return Latest name recorded for the ID up to that frame
+ *
+ * @details Every frame up to the one last read is indexed, so its name
+ * changes are known; a binary search finds the one in effect.
+ */
+std::string_view CaptureReader::getThreadName(uint32_t threadId) const {
+  auto it = threadNames.find(threadId);
+  if (it == threadNames.end())
+    return "<unnamed>";
+  const std::vector<ThreadNameChange> &changes = it->second;
+  auto next = std::upper_bound(
+      changes.begin(), changes.end(), framePosition,
+      [](size_t position, const ThreadNameChange &change) {
+        return position < change.firstFrame;
+      });
+  return next != changes.begin() ? std::string_view(std::prev(next)->name)
+                                 : std::string_view("<unnamed>");
+}
+
+} // namespace chronocap
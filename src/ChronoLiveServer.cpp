@@ -0,0 +1,622 @@
+#if defined(PROFILER)
+
+#include "ChronoLiveServer.hpp"
+#include "ChronoCapture.hpp"
+
+/**
+ * @file ChronoLiveServer.cpp
+ * @brief Implementation of the live profiling HTTP/SSE server.
+ *
+ * @details
+ * The server uses Server-Sent Events rather than WebSockets: the stream only
+ * flows from the renderer to the browser, SSE is plain HTTP (no handshake or
+ * framing to implement), and EventSource reconnects by itself.
+ *
+ * Each captured frame becomes one message:
+ * '''
+ * event: frame
+ * data: {"frame":N,"ms":F,"dropped":D,
+ *        "threads":[[id,"name"],...],
+ *        "zones":[[threadId,depth,startMs,durationMs,"name"],...],
+ *        "counters":[["name",value],...],
+ *        "statsFrames":N,"stats":[["name",calls,totalMs,maxMs],...]}
+ * '''
+ * (on a single line). Zone start times are relative to the frame start; GPU
+ * zones, reported a few frames late, may start before it.
+ *
+ * @note This implementation uses:
+ *  - POSIX sockets and 'poll()' for non-blocking I/O on one thread
+ *  - '<charconv>' for allocation-free number formatting
+ */
+
+#include <algorithm>    ///< std::sort / std::min for the statistics
+#include <cerrno>       ///< errno after socket calls
+#include <charconv>     ///< std::to_chars for numbers
+#include <cstring>      ///< std::strerror for bind errors
+#include <stdexcept>    ///< std::runtime_error when the port cannot be bound
+#include <arpa/inet.h>  ///< htons / htonl
+#include <fcntl.h>      ///< O_NONBLOCK
+#include <netinet/in.h> ///< sockaddr_in, INADDR_LOOPBACK
+#include <poll.h>       ///< poll()
+#include <sys/socket.h> ///< socket / bind / listen / accept / send / recv
+#include <unistd.h>     ///< close()
+
+#if defined(MSG_NOSIGNAL)
+/** @brief Report EPIPE instead of raising SIGPIPE when a viewer disconnects. */
+static constexpr int kSendFlags = MSG_NOSIGNAL;
+#else
+static constexpr int kSendFlags = 0; // macOS: SO_NOSIGPIPE is set per socket
+#endif
+
+/** @brief Viewer page served at '/'. */
+static constexpr std::string_view kViewerHtml = R"html(<!DOCTYPE html>
+<html><head><meta charset="utf-8"><title>ChronoProfiler Live</title>
+<style>
+body{font:12px monospace;background:#1e1e1e;color:#ddd;margin:8px}
+canvas{display:block;background:#252526;width:100%;margin-bottom:8px}
+table{border-collapse:collapse}
+td,th{padding:1px 8px;text-align:right}
+td:first-child,th:first-child{text-align:left}
+#status{margin-bottom:8px;color:#8c8}
+</style></head><body>
+<div id="status">connecting...</div>
+<canvas id="graph" height="80"></canvas>
+<canvas id="timeline" height="40"></canvas>
+<div style="display:flex;gap:32px"><table id="stats"></table><table id="counters"></table></div>
+<script>
+const $ = id => document.getElementById(id);
+const graph = $('graph'), timeline = $('timeline'), history = [];
+let latest = null;
+
+const esc = s => String(s).replace(/[&<>"]/g, c => ({'&':'&amp;','<':'&lt;','>':'&gt;','"':'&quot;'}[c]));
+function color(name) {
+  let h = 0;
+  for (const c of name) h = (h * 31 + c.charCodeAt(0)) >>> 0;
+  return 'hsl(' + (h % 360) + ',55%,55%)';
+}
+function table(el, head, rows) {
+  el.innerHTML = '<tr>' + head.map(h => '<th>' + h + '</th>').join('') + '</tr>' +
+    rows.map(r => '<tr>' + r.map(c => '<td>' + esc(c) + '</td>').join('') + '</tr>').join('');
+}
+
+function drawGraph() {
+  graph.width = graph.clientWidth;
+  const g = graph.getContext('2d'), w = graph.width, h = graph.height;
+  const max = Math.max(33.4, ...history), bw = w / 300;
+  history.forEach((ms, i) => {
+    const bh = ms / max * h;
+    g.fillStyle = ms > 16.7 ? '#d66' : '#6a6';
+    g.fillRect(i * bw, h - bh, Math.max(bw - 1, 1), bh);
+  });
+  const y = h - 16.7 / max * h;
+  g.strokeStyle = '#888';
+  g.beginPath(); g.moveTo(0, y); g.lineTo(w, y); g.stroke();
+}
+
+function drawTimeline(f) {
+  const rowH = 14, labelW = 100;
+  let lo = 0, hi = f.ms;
+  const depth = {};
+  for (const z of f.zones) {
+    lo = Math.min(lo, z[2]); hi = Math.max(hi, z[2] + z[3]);
+    depth[z[0]] = Math.max(depth[z[0]] || 0, z[1] + 1);
+  }
+  const top = {};
+  let y = 0;
+  for (const [id] of f.threads) {
+    if (!depth[id]) continue;
+    top[id] = y; y += depth[id] * rowH + 6;
+  }
+  timeline.width = timeline.clientWidth;
+  timeline.height = Math.max(y, 40);
+  const t = timeline.getContext('2d'), sx = (timeline.width - labelW) / Math.max(hi - lo, 1e-3);
+  t.font = '11px monospace'; t.textBaseline = 'middle';
+  for (const [id, name] of f.threads) {
+    if (top[id] === undefined) continue;
+    t.fillStyle = '#aaa'; t.fillText(name, 2, top[id] + rowH / 2);
+  }
+  for (const z of f.zones) {
+    const x = labelW + (z[2] - lo) * sx, zw = Math.max(z[3] * sx, 1), zy = top[z[0]] + z[1] * rowH;
+    t.fillStyle = color(z[4]); t.fillRect(x, zy, zw, rowH - 1);
+    if (zw > 40) {
+      t.save(); t.beginPath(); t.rect(x, zy, zw, rowH); t.clip();
+      t.fillStyle = '#000'; t.fillText(z[4] + ' ' + z[3].toFixed(2), x + 2, zy + rowH / 2);
+      t.restore();
+    }
+  }
+}
+
+function show(f) {
+  $('status').textContent = 'frame ' + f.frame + ' | ' + f.ms.toFixed(2) + ' ms | dropped ' + f.dropped;
+  drawGraph();
+  drawTimeline(f);
+  const n = Math.max(f.statsFrames, 1);
+  table($('stats'), ['Zone', 'Calls/frame', 'Avg(ms)', 'ms/frame', 'Max(ms)'],
+    f.stats.map(s => [s[0], (s[1] / n).toFixed(1), (s[2] / Math.max(s[1], 1)).toFixed(3),
+                      (s[2] / n).toFixed(3), s[3].toFixed(3)]));
+  table($('counters'), ['Counter', 'Value'], f.counters.map(c => [c[0], c[1]]));
+}
+
+const source = new EventSource('/events');
+source.onopen = () => $('status').textContent = 'connected, waiting for frames...';
+source.onerror = () => $('status').textContent = 'disconnected, retrying...';
+source.addEventListener('frame', e => {
+  latest = JSON.parse(e.data);
+  history.push(latest.ms);
+  if (history.length > 300) history.shift();
+});
+(function tick() {
+  if (latest) { show(latest); latest = null; }
+  requestAnimationFrame(tick);
+})();
+</script></body></html>
+)html";
+
+// ------------- //
+// Formatting    //
+// ------------- //
+
+/**
+ * @brief Append an integer in decimal.
+ * @param out Destination
+ * @param value Value to format
+ */
+static void appendInt(std::string &out, uint64_t value) {
+  char buffer[24];
+  auto [end, ec] = std::to_chars(buffer, buffer + sizeof(buffer), value);
+  out.append(buffer, end);
+}
+
+/**
+ * @brief Append a fixed-point number (non-finite values as 0).
+ * @param out Destination
+ * @param value Value to format
+ * @param precision Digits after the decimal point
+ */
+static void appendFixed(std::string &out, double value, int precision = 3) {
+  char buffer[64];
+  auto [end, ec] =
+      std::to_chars(buffer, buffer + sizeof(buffer), value,
+                    std::chars_format::fixed, precision);
+  if (ec != std::errc() || value != value)
+    out += '0'; // Out of range or NaN
+  else
+    out.append(buffer, end);
+}
+
+// ------------------- //
+// Lifetime            //
+// ------------------- //
+
+/**
+ * @brief Bind 127.0.0.1:port and start the server thread.
+ * @param port TCP port to listen on, or 0 for an ephemeral port
+ */
+ChronoLiveServer::ChronoLiveServer(uint16_t port) {
+  listenFd = ::socket(AF_INET, SOCK_STREAM, 0);
+  if (listenFd < 0)
+    throw std::runtime_error("live server: socket() failed");
+
+  const int reuse = 1;
+  ::setsockopt(listenFd, SOL_SOCKET, SO_REUSEADDR, &reuse, sizeof(reuse));
+
+  sockaddr_in address{};
+  address.sin_family = AF_INET;
+  address.sin_port = htons(port);
+  address.sin_addr.s_addr = htonl(INADDR_LOOPBACK); // Never reachable remotely
+  if (::bind(listenFd, reinterpret_cast<sockaddr *>(&address),
+             sizeof(address)) < 0 ||
+      ::listen(listenFd, static_cast<int>(kMaxClients)) < 0) {
+    const std::string reason = std::strerror(errno);
+    ::close(listenFd);
+    throw std::runtime_error("live server: cannot listen on 127.0.0.1:" +
+                             std::to_string(port) + " (" + reason + ")");
+  }
+  ::fcntl(listenFd, F_SETFL, ::fcntl(listenFd, F_GETFL) | O_NONBLOCK);
+
+  socklen_t length = sizeof(address);
+  ::getsockname(listenFd, reinterpret_cast<sockaddr *>(&address), &length);
+  listenPort = ntohs(address.sin_port); // The system's choice for port 0
+
+  if (::pipe(wakeFds) < 0) {
+    ::close(listenFd);
+    throw std::runtime_error("live server: pipe() failed");
+  }
+  for (const int fd : wakeFds)
+    ::fcntl(fd, F_SETFL, ::fcntl(fd, F_GETFL) | O_NONBLOCK);
+
+  clients.reserve(kMaxClients);
+  serverThread = std::thread(&ChronoLiveServer::run, this);
+}
+
+/**
+ * @brief Stop the server thread and close every socket.
+ */
+ChronoLiveServer::~ChronoLiveServer() {
+  stopping.store(true, std::memory_order_relaxed);
+  wake();
+  serverThread.join();
+
+  for (auto &client : clients)
+    ::close(client.fd);
+  ::close(listenFd);
+  ::close(wakeFds[0]);
+  ::close(wakeFds[1]);
+}
+
+/**
+ * @brief Make the server thread's poll() return.
+ *
+ * @details A full pipe already guarantees a pending wake-up, so a failed
+ * write is ignored.
+ */
+void ChronoLiveServer::wake() {
+  const char byte = 0;
+  [[maybe_unused]] const ssize_t written = ::write(wakeFds[1], &byte, 1);
+}
+
+/**
+ * @brief Put a frame in the mailbox, replacing one not yet picked up.
+ *
+ * @param events Frame events to copy
+ * @param threadNames Names of the frame's threads when it was merged
+ * @param frameStartTicks Tick at which the frame began
+ *
+ * @details Like ChronoTraceWriter::submit(), the caller only pays for a
+ * memcpy under a briefly held mutex. The mailbox keeps its capacity, so the
+ * steady state does not allocate.
+ */
+void ChronoLiveServer::submit(
+    std::span<const ChronoProfiler::Event> events,
+    std::span<const ChronoProfiler::ThreadName> threadNames,
+    uint64_t frameStartTicks) {
+  bool wasEmpty = false;
+  {
+    std::lock_guard<std::mutex> lock(mailboxMutex);
+    wasEmpty = !mailboxFull;
+    if (!wasEmpty)
+      ++dropped; // The server is behind: keep only the newest frame
+    mailbox.assign(events.begin(), events.end());
+    mailboxNames.assign(threadNames.begin(), threadNames.end());
+    mailboxStartTicks = frameStartTicks;
+    mailboxIndex = nextFrameIndex++;
+    mailboxFull = true;
+  }
+  if (wasEmpty)
+    wake(); // A pending frame already has a wake-up queued
+}
+
+/**
+ * @brief Number of frames replaced before the server picked them up.
+ * @return Dropped frame count
+ */
+uint64_t ChronoLiveServer::droppedFrames() const {
+  std::lock_guard<std::mutex> lock(mailboxMutex);
+  return dropped;
+}
+
+// ------------------- //
+// Server thread       //
+// ------------------- //
+
+/**
+ * @brief Server thread main loop.
+ *
+ * @details Waits for socket activity or a wake-up from submit(), services
+ * connections, then picks up the mailbox frame (swapping vectors, so the lock
+ * is held only for the swap). Every frame feeds the statistics; it is only
+ * serialized when a viewer is subscribed.
+ */
+void ChronoLiveServer::run() {
+  std::vector<pollfd> fds;
+  fds.reserve(kMaxClients + 2);
+
+  while (!stopping.load(std::memory_order_relaxed)) {
+    fds.clear();
+    fds.push_back({listenFd, POLLIN, 0});
+    fds.push_back({wakeFds[0], POLLIN, 0});
+    for (const auto &client : clients) {
+      const short events =
+          client.sent < client.output.size() ? POLLIN | POLLOUT : POLLIN;
+      fds.push_back({client.fd, events, 0});
+    }
+
+    if (::poll(fds.data(), fds.size(), kPollTimeoutMs) > 0) {
+      if (fds[0].revents & POLLIN)
+        acceptClients();
+      if (fds[1].revents & POLLIN) {
+        char drain[64];
+        while (::read(wakeFds[0], drain, sizeof(drain)) > 0) {
+        }
+      }
+      for (size_t i = 2; i < fds.size(); ++i) {
+        Client &client = clients[i - 2];
+        if (fds[i].revents & (POLLIN | POLLHUP | POLLERR))
+          readClient(client);
+        if (!client.closed && (fds[i].revents & POLLOUT))
+          writeClient(client);
+      }
+    }
+
+    bool haveFrame = false;
+    {
+      std::lock_guard<std::mutex> lock(mailboxMutex);
+      if (mailboxFull) {
+        frame.swap(mailbox);
+        frameNames.swap(mailboxNames);
+        frameStartTicks = mailboxStartTicks;
+        frameIndex = mailboxIndex;
+        mailboxFull = false;
+        haveFrame = true;
+      }
+    }
+
+    if (haveFrame) {
+      aggregateFrame();
+      const bool anyViewer =
+          std::any_of(clients.begin(), clients.end(),
+                      [](const Client &c) { return c.streaming && !c.closed; });
+      if (anyViewer) {
+        formatFrame();
+        for (auto &client : clients) {
+          if (!client.streaming || client.closed)
+            continue;
+          if (client.output.size() - client.sent > kMaxClientBacklog)
+            continue; // Slow viewer: skip this frame for it only
+          client.output += message;
+          writeClient(client);
+        }
+      }
+    }
+
+    std::erase_if(clients, [](const Client &client) {
+      if (client.closed)
+        ::close(client.fd);
+      return client.closed;
+    });
+  }
+}
+
+/**
+ * @brief Accept every pending connection; refuse those beyond kMaxClients.
+ */
+void ChronoLiveServer::acceptClients() {
+  for (;;) {
+    const int fd = ::accept(listenFd, nullptr, nullptr);
+    if (fd < 0)
+      return;
+    if (clients.size() >= kMaxClients) {
+      ::close(fd);
+      continue;
+    }
+    ::fcntl(fd, F_SETFL, ::fcntl(fd, F_GETFL) | O_NONBLOCK);
+#if defined(SO_NOSIGPIPE)
+    const int noSigPipe = 1;
+    ::setsockopt(fd, SOL_SOCKET, SO_NOSIGPIPE, &noSigPipe, sizeof(noSigPipe));
+#endif
+    Client client;
+    client.fd = fd;
+    clients.push_back(std::move(client));
+  }
+}
+
+/**
+ * @brief Read what the client sent; answer once the header is complete.
+ * @param client Connection with pending input
+ *
+ * @details Streaming clients are not expected to send anything more, so any
+ * further input is discarded; end of stream or an error closes the
+ * connection.
+ */
+void ChronoLiveServer::readClient(Client &client) {
+  char buffer[2048];
+  for (;;) {
+    const ssize_t received = ::recv(client.fd, buffer, sizeof(buffer), 0);
+    if (received == 0) {
+      client.closed = true; // Viewer went away
+      return;
+    }
+    if (received < 0) {
+      if (errno != EAGAIN && errno != EWOULDBLOCK && errno != EINTR)
+        client.closed = true;
+      return;
+    }
+    if (client.streaming || client.closing)
+      continue;
+
+    client.request.append(buffer, static_cast<size_t>(received));
+    if (client.request.find("\r\n\r\n") != std::string::npos) {
+      respond(client);
+    } else if (client.request.size() > kMaxRequestBytes) {
+      client.closed = true;
+      return;
+    }
+  }
+}
+
+/**
+ * @brief Queue the response for a complete request.
+ * @param client Connection whose request header has been received
+ *
+ * @details '/' and '/index.html' return the viewer and close; '/events'
+ * switches the connection to an SSE stream; anything else is a 404.
+ */
+void ChronoLiveServer::respond(Client &client) {
+  std::string_view request = client.request;
+  std::string_view path;
+  if (request.starts_with("GET ")) {
+    request.remove_prefix(4);
+    path = request.substr(0, request.find(' '));
+    path = path.substr(0, path.find('?'));
+  }
+
+  if (path == "/events") {
+    client.output += "HTTP/1.1 200 OK\r\n"
+                     "Content-Type: text/event-stream\r\n"
+                     "Cache-Control: no-cache\r\n"
+                     "Connection: keep-alive\r\n"
+                     "\r\n"
+                     "retry: 1000\n\n";
+    client.streaming = true;
+  } else if (path == "/" || path == "/index.html") {
+    client.output += "HTTP/1.1 200 OK\r\n"
+                     "Content-Type: text/html; charset=utf-8\r\n"
+                     "Content-Length: ";
+    appendInt(client.output, kViewerHtml.size());
+    client.output += "\r\nConnection: close\r\n\r\n";
+    client.output += kViewerHtml;
+    client.closing = true;
+  } else {
+    client.output += "HTTP/1.1 404 Not Found\r\n"
+                     "Content-Length: 0\r\n"
+                     "Connection: close\r\n\r\n";
+    client.closing = true;
+  }
+  client.request.clear();
+  client.request.shrink_to_fit();
+  writeClient(client);
+}
+
+/**
+ * @brief Send queued output without blocking.
+ * @param client Connection with output pending
+ */
+void ChronoLiveServer::writeClient(Client &client) {
+  while (client.sent < client.output.size()) {
+    const ssize_t written =
+        ::send(client.fd, client.output.data() + client.sent,
+               client.output.size() - client.sent, kSendFlags);
+    if (written < 0) {
+      if (errno != EAGAIN && errno != EWOULDBLOCK && errno != EINTR)
+        client.closed = true;
+      return; // Socket buffer full: resume on POLLOUT
+    }
+    client.sent += static_cast<size_t>(written);
+  }
+  client.output.clear(); // Keeps capacity for the next frame
+  client.sent = 0;
+  if (client.closing)
+    client.closed = true;
+}
+
+// ------------------- //
+// Serialization       //
+// ------------------- //
+
+/**
+ * @brief Add the frame's zones to the per-name statistics.
+ */
+void ChronoLiveServer::aggregateFrame() {
+  for (const auto &evt : frame) {
+    if (evt.isValue())
+      continue;
+    const double ms = evt.durationMs();
+    ZoneStats &stats = zoneStats[evt.nameId];
+    ++stats.calls;
+    stats.totalMs += ms;
+    stats.maxMs = std::max(stats.maxMs, ms);
+  }
+  ++framesAggregated;
+}
+
+/**
+ * @brief Serialize the frame, its counters and the top zones as an SSE
+ * message.
+ *
+ * @details The frame duration is the latest end of a CPU zone, measured from
+ * the frame start; GPU zones are excluded because they belong to an earlier
+ * frame.
+ */
+void ChronoLiveServer::formatFrame() {
+  uint64_t droppedSoFar = 0;
+  {
+    std::lock_guard<std::mutex> lock(mailboxMutex);
+    droppedSoFar = dropped;
+  }
+
+  uint64_t frameEndTicks = frameStartTicks;
+  for (const auto &evt : frame) {
+    if (!evt.isValue() && evt.threadId != ChronoProfiler::kGpuThreadId)
+      frameEndTicks = std::max(frameEndTicks, evt.endTicks);
+  }
+
+  message.clear();
+  message += "event: frame\ndata: {\"frame\":";
+  appendInt(message, frameIndex);
+  message += ",\"ms\":";
+  appendFixed(message, ChronoProfiler::ticksToMs(frameEndTicks - frameStartTicks));
+  message += ",\"dropped\":";
+  appendInt(message, droppedSoFar);
+
+  message += ",\"threads\":[";
+  for (size_t i = 0; i < frameNames.size(); ++i) {
+    message += i ? ",[" : "[";
+    appendInt(message, frameNames[i].threadId);
+    message += ',';
+    chronocap::appendJsonString(
+        message, ChronoProfiler::findThreadName(frameNames,
+                                                frameNames[i].threadId));
+    message += ']';
+  }
+
+  message += "],\"zones\":[";
+  bool first = true;
+  for (const auto &evt : frame) {
+    if (evt.isValue())
+      continue;
+    message += first ? "[" : ",[";
+    first = false;
+    appendInt(message, evt.threadId);
+    message += ',';
+    appendInt(message, evt.depth);
+    message += ',';
+    appendFixed(message,
+                ChronoProfiler::ticksToMs(static_cast<int64_t>(
+                    evt.startTicks - frameStartTicks)));
+    message += ',';
+    appendFixed(message, evt.durationMs());
+    message += ',';
+    chronocap::appendJsonString(message, ChronoProfiler::getString(evt.nameId));
+    message += ']';
+  }
+
+  message += "],\"counters\":[";
+  first = true;
+  for (const auto &evt : frame) {
+    if (!evt.isValue())
+      continue;
+    message += first ? "[" : ",[";
+    first = false;
+    chronocap::appendJsonString(message, ChronoProfiler::getString(evt.nameId));
+    message += ',';
+    appendFixed(message, evt.value(),
+                (evt.flags & ChronoProfiler::Event::kFlagPlot) ? 3 : 0);
+    message += ']';
+  }
+
+  topZones.assign(zoneStats.begin(), zoneStats.end());
+  const size_t shown = std::min(topZones.size(), kMaxStatsZones);
+  std::partial_sort(topZones.begin(), topZones.begin() + shown, topZones.end(),
+                    [](const auto &a, const auto &b) {
+                      return a.second.totalMs > b.second.totalMs;
+                    });
+
+  message += "],\"statsFrames\":";
+  appendInt(message, framesAggregated);
+  message += ",\"stats\":[";
+  for (size_t i = 0; i < shown; ++i) {
+    const auto &[nameId, stats] = topZones[i];
+    message += i ? ",[" : "[";
+    chronocap::appendJsonString(message, ChronoProfiler::getString(nameId));
+    message += ',';
+    appendInt(message, stats.calls);
+    message += ',';
+    appendFixed(message, stats.totalMs);
+    message += ',';
+    appendFixed(message, stats.maxMs);
+    message += ']';
+  }
+  message += "]}\n\n";
+}
+
+#endif // defined(PROFILER)
@@ -1,4 +1,6 @@
 #include "ChronoProfiler.hpp"
+#include "ChronoLiveServer.hpp"
+#include "ChronoTraceWriter.hpp"
 
 /**
  * @file ChronoProfiler.cpp
@@ -11,73 +13,316 @@
  * Optional features implemented here include:
  *  - Thread names for UI labeling
  *  - Event colors and categories for visualization
- *  - Per-thread ring buffers to limit memory usage
+ *  - Lock-free per-thread SPSC ring buffers with overflow counters
+ *  - Compact 32-byte POD events with interned names and categories
+ *  - Raw TSC/steady_clock tick capture with deferred millisecond conversion
+ *  - Per-frame counters and gauge samples recorded through the same rings
+ *  - Optional attribution of heap allocations to the innermost open zone
  *  - JSON export for offline analysis
+ *  - Streaming Chrome Trace Event / binary '.chrono' capture via ChronoTraceWriter
+ *  - Live browser viewer on localhost via ChronoLiveServer
  *  - Runaway event prevention and total event tracking
  *
  * @note This implementation uses standard C++ libraries:
- *  - '<chrono>' for high-resolution timing
+ *  - '<chrono>' for monotonic tick timestamps and TSC calibration
+ *  - '<x86intrin.h>'/'<cpuid.h>' (x86-64 only) to read and validate the TSC
  *  - '<vector>' and '<unordered_map>' for storage
- *  - '<thread>' and '<mutex>' for thread safety
+ *  - '<mutex>' and thread_local storage for thread safety
  *  - '<atomic>' for atomic counters
  *  - '<fstream>' and '<iomanip>' for JSON export
  *  - 'nlohmann/json.hpp' (external) for JSON serialization
  */
 
+#include <algorithm>         ///< std::sort to order drained events by start
+#include <charconv>          ///< std::from_chars for capture policy specs
 #include <fstream>           ///< std::ofstream for file output
 #include <iomanip>           ///< std::setw for pretty JSON formatting
 #include <nlohmann/json.hpp> ///< External library for JSON export
+#include <iostream>          ///< std::cerr when a trace cannot be started
+#include <random>            ///< std::minstd_rand for random frame sampling
 #include <sstream>           ///< std::stringstream for string formatting
 
+#if defined(__x86_64__) && (defined(__GNUC__) || defined(__clang__))
+#include <cpuid.h>      ///< __get_cpuid to check for an invariant TSC
+#include <x86intrin.h>  ///< __rdtsc for raw timestamp counter reads
+#define CHRONO_HAS_TSC 1
+#else
+#define CHRONO_HAS_TSC 0
+#endif
+
 // -------------- //
 // Static storage //
 // -------------- //
 
-/** @brief Thread-local event list for each thread. Each thread writes to its
- * own vector to avoid locks. */
-thread_local std::vector<ChronoProfiler::Event> ChronoProfiler::threadEvents;
-
 /** @brief Merged event list for the completed frame. */
 std::vector<ChronoProfiler::Event> ChronoProfiler::frameEvents;
 
-/** @brief Mapping from thread IDs to human-readable names. */
-std::unordered_map<uint32_t, std::string> ChronoProfiler::threadNames;
+/** @brief Thread names of 'frameEvents', as of its merge. */
+std::vector<ChronoProfiler::ThreadName> ChronoProfiler::frameThreadNames;
+
+/** @brief Dense thread ID of the next newly allocated ring. */
+uint32_t ChronoProfiler::nextThreadId = 0;
+
+/** @brief Interned thread name per dense thread ID; written by setThreadName(). */
+std::array<std::atomic<uint16_t>, ChronoProfiler::kMaxNamedThreads>
+    ChronoProfiler::threadNameIds{};
 
-/** @brief Mutex protecting access to the threadNames map. */
-std::mutex ChronoProfiler::threadNamesMutex;
+/** @brief Interned names of the GPU and counter pseudo-threads. */
+std::atomic<uint16_t> ChronoProfiler::gpuThreadNameId{0};
+std::atomic<uint16_t> ChronoProfiler::counterThreadNameId{0};
 
-/** @brief Mutex protecting merging of thread-local buffers into the frameEvents
- * vector. */
+/** @brief Mutex serializing consumers of the thread rings and registration of
+ * new rings. Producers never take it after registering. */
 std::mutex ChronoProfiler::mergeMutex;
 
-/** @brief Timestamp indicating the start of the current frame. */
-std::chrono::high_resolution_clock::time_point ChronoProfiler::frameStart;
+/** @brief Tick value indicating the start of the current frame. */
+uint64_t ChronoProfiler::frameStartTicks = 0;
+
+/** @brief Start tick of the frame held in 'frameEvents'. */
+uint64_t ChronoProfiler::capturedFrameStartTicks = 0;
+
+/** @brief Policy selecting which frames are captured. */
+ChronoProfiler::CapturePolicy ChronoProfiler::capturePolicy;
+
+/** @brief Frames ended since the capture policy was last set. */
+uint64_t ChronoProfiler::policyFrameCount = 0;
+
+/** @brief Flight recorder used by the Triggered capture policy. */
+std::vector<ChronoProfiler::RecordedFrame> ChronoProfiler::flightRecorder;
+
+/** @brief Next slot to overwrite in 'flightRecorder'. */
+size_t ChronoProfiler::flightRecorderNext = 0;
+
+/** @brief Number of frames currently held by 'flightRecorder'. */
+size_t ChronoProfiler::flightRecorderCount = 0;
+
+/** @brief Whether the last 'endFrame()' captured its frame. */
+std::atomic<bool> ChronoProfiler::frameCaptured{false};
+
+/** @brief Counter and gauge samples drained during the current merge. */
+std::vector<ChronoProfiler::Event> ChronoProfiler::valueEvents;
+
+/** @brief Allocation counter IDs per zone name ID (0 = not interned yet). */
+std::vector<std::array<uint16_t, 2>> ChronoProfiler::allocCounterNames;
 
-/** @brief Global atomic counter for total number of events recorded. */
-std::atomic<size_t> ChronoProfiler::totalEventCount{0};
+/** @brief Whether operator new charges allocations to zones. */
+std::atomic<bool> ChronoProfiler::allocationTracking{false};
 
-/** @brief Registry of all thread-local buffers for multi-thread merging. */
-std::vector<std::vector<ChronoProfiler::Event> *>
+/** @brief Calling thread's ring (null until its first zone or after exit). */
+thread_local ChronoProfiler::ThreadBuffer *ChronoProfiler::threadBuffer =
+    nullptr;
+
+/** @brief Every counter name seen so far, sorted by ID. */
+std::vector<uint16_t> ChronoProfiler::counterIds;
+
+/** @brief Current frame's total for each entry of 'counterIds'. */
+std::vector<int64_t> ChronoProfiler::counterTotals;
+
+/** @brief Events handed in by 'submitEvents()' for the next frame. */
+std::vector<ChronoProfiler::Event> ChronoProfiler::submittedEvents;
+
+/** @brief Active streaming trace writer (null when not tracing). */
+std::unique_ptr<ChronoTraceWriter> ChronoProfiler::traceWriter;
+
+/** @brief Live viewer server (null when not running). */
+std::unique_ptr<ChronoLiveServer> ChronoProfiler::liveServer;
+
+namespace {
+
+/**
+ * @brief Check whether the CPU exposes an invariant TSC.
+ * @return True if the TSC ticks at a constant rate across P/C-states
+ *
+ * @details CPUID leaf 0x80000007, EDX bit 8. Without it the TSC can change
+ * frequency or stop, so steady_clock is used instead.
+ */
+bool detectInvariantTsc() {
+#if CHRONO_HAS_TSC
+  unsigned int eax = 0, ebx = 0, ecx = 0, edx = 0;
+  if (__get_cpuid(0x80000000, &eax, &ebx, &ecx, &edx) == 0 ||
+      eax < 0x80000007) {
+    return false;
+  }
+  __get_cpuid(0x80000007, &eax, &ebx, &ecx, &edx);
+  return (edx & (1u << 8)) != 0;
+#else
+  return false;
+#endif
+}
+
+/** @brief Read the raw TSC (0 on targets without one). */
+uint64_t readTsc() {
+#if CHRONO_HAS_TSC
+  return __rdtsc();
+#else
+  return 0;
+#endif
+}
+
+/** @brief Random source for the Random capture policy (guarded by mergeMutex). */
+std::minstd_rand captureRng{std::random_device{}()};
+
+/** @brief Parse a whole string_view as a number. */
+template <typename T> bool parseNumber(std::string_view text, T &value) {
+  const auto result =
+      std::from_chars(text.data(), text.data() + text.size(), value);
+  return result.ec == std::errc() && result.ptr == text.data() + text.size();
+}
+
+/** @brief Milliseconds per steady_clock period. */
+constexpr double kSteadyMsPerTick =
+    1000.0 * static_cast<double>(std::chrono::steady_clock::period::num) /
+    static_cast<double>(std::chrono::steady_clock::period::den);
+
+} // namespace
+
+/** @brief Milliseconds-per-tick estimate used by 'ticksToMs()'. */
+constinit std::atomic<double> ChronoProfiler::msPerTick{0.0};
+
+/** @brief True once the TSC calibration baseline has reached one second. */
+constinit std::atomic<bool> ChronoProfiler::tickCalibrationFrozen{false};
+
+/** @brief Registry owning every thread ring for multi-thread merging. */
+std::vector<std::unique_ptr<ChronoProfiler::ThreadBuffer>>
     ChronoProfiler::allThreadBuffers;
 
-// ------------------------------------- //
-// Utility: current time in milliseconds //
-// ------------------------------------- //
+/** @brief Drained rings of exited threads, reused by new threads. */
+std::vector<std::unique_ptr<ChronoProfiler::ThreadBuffer>>
+    ChronoProfiler::freeThreadBuffers;
+
+/** @brief Lock-free view of the string-table pages (null until allocated). */
+std::array<std::atomic<ChronoProfiler::StringPage *>,
+           ChronoProfiler::kMaxStrings / ChronoProfiler::kStringPageSize>
+    ChronoProfiler::stringPages{};
+
+/** @brief Storage owning the string-table pages. */
+std::vector<std::unique_ptr<ChronoProfiler::StringPage>>
+    ChronoProfiler::ownedStringPages;
+
+/** @brief Text -> ID lookup used when interning. */
+std::unordered_map<std::string_view, uint16_t> ChronoProfiler::stringIds;
+
+/** @brief Number of interned strings; ID 0 is reserved for "". */
+size_t ChronoProfiler::stringCount = 0;
+
+/** @brief Mutex serializing string-table insertions. */
+std::mutex ChronoProfiler::stringTableMutex;
+
+// ------------------------------ //
+// Utility: current time in ticks //
+// ------------------------------ //
+
+/**
+ * @brief Select the tick source and take the calibration baseline.
+ * @return Baseline shared by nowTicks() and calibrateTicks()
+ *
+ * @details Initialized on the first call from any thread, including zones
+ * that run during static initialization.
+ */
+const ChronoProfiler::TickBaseline &ChronoProfiler::tickBaseline() {
+  static const TickBaseline baseline{detectInvariantTsc(), readTsc(),
+                                     std::chrono::steady_clock::now()};
+  return baseline;
+}
 
 /**
- * @brief Get the current timestamp in milliseconds since the epoch.
- * @return High-resolution timestamp in milliseconds (double-precision)
+ * @brief Get the current timestamp in raw clock ticks.
+ * @return TSC cycles when the invariant TSC is available, otherwise
+ * 'std::chrono::steady_clock' periods
  *
- * @details Uses 'std::chrono::high_resolution_clock' to provide accurate timing
- *          for profiling events. This is used internally to compute event
- * durations.
+ * @details No floating-point conversion happens on the hot path; durations
+ *          are converted to milliseconds by 'ticksToMs()' when displayed.
  */
-double ChronoProfiler::nowMs() {
+uint64_t ChronoProfiler::nowTicks() {
+  static const bool tsc = tickBaseline().tsc; // Inline guard check, no call
+  if (tsc)
+    return readTsc();
+  return static_cast<uint64_t>(
+      std::chrono::steady_clock::now().time_since_epoch().count());
+}
+
+/**
+ * @brief Prepare the clock and take the first tick-period estimate.
+ *
+ * @details Taking the baseline here also keeps the first zone from paying
+ * for CPUID. The spin (up to 10 ms after the baseline) happens only here or,
+ * if init() was never called, in the first getMsPerTick().
+ */
+void ChronoProfiler::init() {
+  if (msPerTick.load(std::memory_order_relaxed) == 0.0)
+    calibrateTicks(true);
+}
+
+/**
+ * @brief Measure the tick period against steady_clock.
+ * @param wait Spin until the baseline reaches 10 ms instead of skipping
+ *
+ * @details Compares the TSC and steady_clock deltas since the baseline. The
+ * longer the baseline the smaller the error, so the estimate is refreshed on
+ * every call until one second has elapsed and then frozen. Without 'wait' a
+ * baseline under 10 ms keeps the previous estimate.
+ */
+void ChronoProfiler::calibrateTicks(bool wait) {
   using namespace std::chrono;
-  // Return current time in milliseconds
-  return duration<double, std::milli>(
-             high_resolution_clock::now().time_since_epoch())
-      .count();
+
+  const TickBaseline &baseline = tickBaseline();
+  if (!baseline.tsc) {
+    msPerTick.store(kSteadyMsPerTick, std::memory_order_relaxed);
+    tickCalibrationFrozen.store(true, std::memory_order_relaxed);
+    return;
+  }
+
+  if (tickCalibrationFrozen.load(std::memory_order_relaxed))
+    return;
+
+  steady_clock::time_point now = steady_clock::now();
+  uint64_t tsc = readTsc();
+  if (now - baseline.steady < milliseconds(10)) {
+    if (!wait)
+      return;
+    do {
+      now = steady_clock::now();
+      tsc = readTsc();
+    } while (now - baseline.steady < milliseconds(10));
+  }
+
+  const double elapsedMs =
+      duration<double, std::milli>(now - baseline.steady).count();
+  msPerTick.store(elapsedMs / static_cast<double>(tsc - baseline.tscTicks),
+                  std::memory_order_relaxed);
+
+  if (now - baseline.steady >= seconds(1)) {
+    tickCalibrationFrozen.store(true, std::memory_order_relaxed);
+  }
+}
+
+/**
+ * @brief Length of one tick in milliseconds, calibrating on first use.
+ * @return Milliseconds per tick
+ */
+double ChronoProfiler::getMsPerTick() {
+  double period = msPerTick.load(std::memory_order_relaxed);
+  if (period == 0.0) {
+    calibrateTicks(true); // init() was not called
+    period = msPerTick.load(std::memory_order_relaxed);
+  }
+  return period;
+}
+
+/**
+ * @brief Report which clock backs the raw ticks.
+ * @return True for the invariant TSC, false for steady_clock
+ */
+bool ChronoProfiler::usesTsc() { return tickBaseline().tsc; }
+
+/**
+ * @brief Convert a tick delta into milliseconds.
+ * @param ticks Tick difference (may be negative for zones that started before
+ * the frame)
+ * @return Duration in milliseconds
+ */
+double ChronoProfiler::ticksToMs(int64_t ticks) {
+  return static_cast<double>(ticks) * getMsPerTick();
 }
 
 // --------------- //
@@ -89,34 +334,377 @@ double ChronoProfiler::nowMs() {
  *
  * @details
  * This should be called at the start of each frame (e.g., game/render loop).
- * Clears previous frame events and resets the total event counter.
- *
- * @note Locks are used here to safely clear the shared frameEvents vector.
+ * The previous captured frame stays readable through 'getEvents()' until
+ * the next frame is captured.
  */
 void ChronoProfiler::beginFrame() {
-  frameStart =
-      std::chrono::high_resolution_clock::now(); // Record frame start time
-
-  std::lock_guard<std::mutex> lock(mergeMutex); // Protect shared frameEvents
-  frameEvents.clear();
-  totalEventCount = 0;
+  frameStartTicks = nowTicks(); // Record frame start time
 }
 
 /**
  * @brief End the current profiling frame.
  *
  * @details
- * Merges thread-local buffers from all threads into 'frameEvents' for the
- * current frame. Each thread-local buffer is cleared after merging.
+ * Drains the ring buffers of all threads for the current frame. Draining only
+ * advances each ring's tail, so producers keep recording while the merge runs.
+ *
+ * The capture policy decides where the events go. A captured frame replaces
+ * 'frameEvents' and is handed to the active trace. Under the Triggered policy
+ * a frame below the threshold is merged into the flight recorder instead, and
+ * a slow frame flushes the recorder to the trace ahead of itself. Any other
+ * frame is drained and discarded without being copied or sorted.
  *
- * @note Locking occurs here to ensure thread-safe merging.
+ * @note mergeMutex is held only against other consumers and registration.
  */
 void ChronoProfiler::endFrame() {
-  std::lock_guard<std::mutex> lock(mergeMutex); // Ensure thread-safe merge
+  const uint64_t frameEndTicks = nowTicks();
+  std::lock_guard<std::mutex> lock(mergeMutex); // Serialize consumers
+
+  calibrateTicks(false); // Refine the tick period; never waits (see init())
+
+  const bool triggered = capturePolicy.mode == CapturePolicy::Mode::Triggered;
+  const bool captured = shouldCapture(frameEndTicks);
+  ++policyFrameCount;
+  frameCaptured.store(captured, std::memory_order_relaxed);
+
+  if (!captured) {
+    if (triggered && !flightRecorder.empty()) {
+      // Keep the frame for a later trigger, reusing the slot's capacity
+      RecordedFrame &slot = flightRecorder[flightRecorderNext];
+      slot.startTicks = frameStartTicks;
+      mergeFrame(slot.events, slot.threadNames);
+      flightRecorderNext = (flightRecorderNext + 1) % flightRecorder.size();
+      flightRecorderCount =
+          std::min(flightRecorderCount + 1, flightRecorder.size());
+    } else {
+      // Free the ring slots; nothing is copied or sorted
+      for (auto &buffer : allThreadBuffers)
+        buffer->drain([](const Event &) {});
+      recycleThreadBuffers();
+      submittedEvents.clear();
+    }
+    return;
+  }
+
+  capturedFrameStartTicks = frameStartTicks;
+  mergeFrame(frameEvents, frameThreadNames);
 
-  for (auto *buffer : allThreadBuffers) {
-    frameEvents.insert(frameEvents.end(), buffer->begin(), buffer->end());
-    buffer->clear(); ///< Clear thread-local buffer for next frame
+  if (traceWriter && flightRecorderCount > 0) {
+    // Oldest first, so the capture reads as a contiguous lead-up
+    const size_t oldest = (flightRecorderNext + flightRecorder.size() -
+                           flightRecorderCount) %
+                          flightRecorder.size();
+    for (size_t i = 0; i < flightRecorderCount; ++i) {
+      const RecordedFrame &frame =
+          flightRecorder[(oldest + i) % flightRecorder.size()];
+      traceWriter->submit(frame.events, frame.threadNames, frame.startTicks);
+    }
+  }
+  flightRecorderCount = 0; // Recorded frames belong to this trigger
+
+  if (traceWriter) // Copy only; encoding is off-thread
+    traceWriter->submit(frameEvents, frameThreadNames, frameStartTicks);
+  if (liveServer) // Replaces an unsent frame
+    liveServer->submit(frameEvents, frameThreadNames, frameStartTicks);
+}
+
+/**
+ * @brief Drain every ring and the submitted events into one frame.
+ *
+ * @param events Destination, cleared first (its capacity is reused)
+ * @param threadNames Receives the names of the frame's threads
+ *
+ * @details The names are captured here, under mergeMutex, because a ring
+ * recycled by this merge can be registered by a new thread (which clears
+ * and then replaces the name behind its ID) as soon as the lock is released.
+ *
+ * @note Called with mergeMutex held.
+ */
+void ChronoProfiler::mergeFrame(std::vector<Event> &events,
+                                std::vector<ThreadName> &threadNames) {
+  events.clear();
+
+  for (auto &buffer : allThreadBuffers) {
+    const size_t first = events.size();
+    buffer->drain([&events](const Event &evt) {
+      if (evt.flags & (Event::kFlagAllocCount | Event::kFlagAllocBytes))
+        [[unlikely]] {
+        valueEvents.push_back(renameAllocation(evt));
+        return;
+      }
+      // Samples share the ring but are not part of the zone hierarchy
+      (evt.isValue() ? valueEvents : events).push_back(evt);
+    });
+    linkZones(events, first);
+  }
+  recycleThreadBuffers(); // Rings of exited threads are empty now
+
+  if (!submittedEvents.empty()) {
+    const size_t first = events.size();
+    events.insert(events.end(), submittedEvents.begin(),
+                  submittedEvents.end());
+    submittedEvents.clear();
+    linkZones(events, first);
+  }
+
+  appendValues(events);
+  snapshotThreadNames(events, threadNames);
+}
+
+/**
+ * @brief Record the name behind every thread ID of a merged frame.
+ *
+ * @param events Merged frame
+ * @param threadNames Destination, cleared first (its capacity is reused)
+ *
+ * @details Events are grouped by thread, so the registry is read once per
+ * group; the few distinct IDs are then sorted for findThreadName().
+ */
+void ChronoProfiler::snapshotThreadNames(std::span<const Event> events,
+                                         std::vector<ThreadName> &threadNames) {
+  threadNames.clear();
+  for (const Event &evt : events) {
+    if (!threadNames.empty() && threadNames.back().threadId == evt.threadId)
+      continue;
+    if (std::any_of(threadNames.begin(), threadNames.end(),
+                    [&](const ThreadName &known) {
+                      return known.threadId == evt.threadId;
+                    }))
+      continue;
+    const std::atomic<uint16_t> *slot = threadNameSlot(evt.threadId);
+    threadNames.push_back(
+        {evt.threadId, slot ? slot->load(std::memory_order_acquire)
+                            : uint16_t{0}});
+  }
+  std::sort(threadNames.begin(), threadNames.end(),
+            [](const ThreadName &a, const ThreadName &b) {
+              return a.threadId < b.threadId;
+            });
+}
+
+/**
+ * @brief Append counter totals and gauge samples after the frame's zones.
+ *
+ * @param events Frame being merged
+ *
+ * @details Counter increments are summed per name into one sample stamped
+ * with the frame start, and every known counter reports a sample so a frame
+ * without increments reads as 0 rather than holding the previous value.
+ * Gauge samples are kept individually in time order. All samples move to
+ * the kCounterThreadId track.
+ *
+ * @note Called with mergeMutex held.
+ */
+void ChronoProfiler::appendValues(std::vector<Event> &events) {
+  std::fill(counterTotals.begin(), counterTotals.end(), 0);
+
+  const size_t firstPlot = events.size();
+  for (const Event &evt : valueEvents) {
+    if (evt.flags & Event::kFlagPlot) {
+      Event &sample = events.emplace_back(evt);
+      sample.threadId = kCounterThreadId;
+      continue;
+    }
+
+    auto it = std::lower_bound(counterIds.begin(), counterIds.end(), evt.nameId);
+    const size_t index = static_cast<size_t>(it - counterIds.begin());
+    if (it == counterIds.end() || *it != evt.nameId) {
+      // First use of this counter: only happens once per name
+      if (counterIds.empty())
+        setThreadName(kCounterThreadId, "Counters");
+      counterIds.insert(it, evt.nameId);
+      counterTotals.insert(counterTotals.begin() + static_cast<std::ptrdiff_t>(index), 0);
+    }
+    counterTotals[index] += static_cast<int64_t>(evt.endTicks);
+  }
+  valueEvents.clear();
+
+  std::sort(events.begin() + static_cast<std::ptrdiff_t>(firstPlot), events.end(),
+            [](const Event &a, const Event &b) { return a.startTicks < b.startTicks; });
+
+  for (size_t i = 0; i < counterIds.size(); ++i) {
+    Event &sample = events.emplace_back();
+    sample.startTicks = frameStartTicks;
+    sample.endTicks = static_cast<uint64_t>(counterTotals[i]);
+    sample.threadId = kCounterThreadId;
+    sample.parentIndex = -1;
+    sample.nameId = counterIds[i];
+    sample.flags = Event::kFlagCounter;
+  }
+}
+
+// -------------- //
+// Capture policy //
+// -------------- //
+
+/**
+ * @brief Apply the capture policy to the frame being ended.
+ * @param frameEndTicks Tick at which endFrame() was entered
+ * @return True if the frame should be published
+ *
+ * @note Called with mergeMutex held, before policyFrameCount is advanced.
+ */
+bool ChronoProfiler::shouldCapture(uint64_t frameEndTicks) {
+  switch (capturePolicy.mode) {
+  case CapturePolicy::Mode::Continuous:
+    return true;
+  case CapturePolicy::Mode::EveryNth:
+    return policyFrameCount % capturePolicy.interval == 0;
+  case CapturePolicy::Mode::Random:
+    return std::uniform_real_distribution<double>(0.0, 1.0)(captureRng) <
+           capturePolicy.sampleRate;
+  case CapturePolicy::Mode::Triggered:
+    return ticksToMs(static_cast<int64_t>(frameEndTicks - frameStartTicks)) >
+           capturePolicy.triggerMs;
+  }
+  return true;
+}
+
+/**
+ * @brief Replace the capture policy.
+ * @param policy New policy
+ *
+ * @details The flight recorder keeps its slots (and their event capacity)
+ * when K is unchanged, so switching policies at runtime does not reallocate.
+ */
+void ChronoProfiler::setCapturePolicy(const CapturePolicy &policy) {
+  std::lock_guard<std::mutex> lock(mergeMutex);
+  capturePolicy = policy;
+  if (capturePolicy.interval == 0)
+    capturePolicy.interval = 1;
+  policyFrameCount = 0;
+
+  const size_t slots = capturePolicy.mode == CapturePolicy::Mode::Triggered
+                           ? capturePolicy.preTriggerFrames
+                           : 0;
+  flightRecorder.resize(slots);
+  flightRecorderNext = 0;
+  flightRecorderCount = 0;
+}
+
+/**
+ * @brief Return a copy of the active capture policy.
+ * @return Capture policy
+ */
+ChronoProfiler::CapturePolicy ChronoProfiler::getCapturePolicy() {
+  std::lock_guard<std::mutex> lock(mergeMutex);
+  return capturePolicy;
+}
+
+/**
+ * @brief Report whether the last endFrame() published its frame.
+ * @return True if the frame was captured
+ */
+bool ChronoProfiler::isFrameCaptured() {
+  return frameCaptured.load(std::memory_order_relaxed);
+}
+
+/**
+ * @brief Parse a textual capture policy.
+ * @param spec "continuous", "every:N", "random:RATE" or "trigger:MS[:K]"
+ * @param policy Receives the policy on success
+ * @return False if 'spec' is not one of the accepted forms
+ */
+bool ChronoProfiler::CapturePolicy::parse(std::string_view spec,
+                                          CapturePolicy &policy) {
+  const size_t colon = spec.find(':');
+  const std::string_view kind = spec.substr(0, colon);
+  const std::string_view args =
+      colon == std::string_view::npos ? std::string_view() : spec.substr(colon + 1);
+
+  if (kind == "continuous" && args.empty()) {
+    policy = continuous();
+    return true;
+  }
+  if (kind == "every") {
+    uint32_t n = 0;
+    if (!parseNumber(args, n) || n == 0)
+      return false;
+    policy = everyNth(n);
+    return true;
+  }
+  if (kind == "random") {
+    double rate = 0.0;
+    if (!parseNumber(args, rate) || rate < 0.0 || rate > 1.0)
+      return false;
+    policy = random(rate);
+    return true;
+  }
+  if (kind == "trigger") {
+    const size_t split = args.find(':');
+    double thresholdMs = 0.0;
+    uint32_t framesBefore = 0;
+    if (!parseNumber(args.substr(0, split), thresholdMs) || thresholdMs < 0.0)
+      return false;
+    if (split != std::string_view::npos &&
+        !parseNumber(args.substr(split + 1), framesBefore))
+      return false;
+    policy = triggered(thresholdMs, framesBefore);
+    return true;
+  }
+  return false;
+}
+
+/**
+ * @brief Order one thread's drained events and resolve their nesting.
+ *
+ * @param events Frame being merged
+ * @param first Index in 'events' of the thread's first drained event
+ *
+ * @details
+ * Zones are published when they end, so children arrive before their parent.
+ * Sorting by start tick (and depth for ties) restores pre-order; after that the
+ * parent of a zone at depth d is the most recent zone seen at depth d - 1,
+ * provided it actually encloses the child. Zones whose parent ended in another
+ * frame keep 'parentIndex' at -1.
+ */
+void ChronoProfiler::linkZones(std::vector<Event> &events, size_t first) {
+  auto begin = events.begin() + static_cast<std::ptrdiff_t>(first);
+  std::sort(begin, events.end(), [](const Event &a, const Event &b) {
+    return a.startTicks != b.startTicks ? a.startTicks < b.startTicks
+                                        : a.depth < b.depth;
+  });
+
+  std::array<int32_t, kMaxZoneDepth> lastAtDepth;
+  lastAtDepth.fill(-1);
+
+  for (size_t i = first; i < events.size(); ++i) {
+    Event &evt = events[i];
+    evt.parentIndex = -1;
+
+    if (evt.depth > 0 && lastAtDepth[evt.depth - 1] >= 0) {
+      const Event &parent = events[lastAtDepth[evt.depth - 1]];
+      if (parent.startTicks <= evt.startTicks &&
+          evt.endTicks <= parent.endTicks) {
+        evt.parentIndex = lastAtDepth[evt.depth - 1];
+      }
+    }
+
+    lastAtDepth[evt.depth] = static_cast<int32_t>(i);
+  }
+}
+
+/**
+ * @brief Compute exclusive (self) ticks for every event of a merged frame.
+ *
+ * @param events Frame events with resolved 'parentIndex'
+ * @param selfTicks Output vector, one entry per event
+ *
+ * @details Starts from each event's inclusive duration and subtracts it from
+ * its parent's entry. Runs in O(n) and reuses the caller's storage.
+ */
+void ChronoProfiler::computeSelfTicks(std::span<const Event> events,
+                                      std::vector<uint64_t> &selfTicks) {
+  selfTicks.resize(events.size());
+  for (size_t i = 0; i < events.size(); ++i) {
+    selfTicks[i] =
+        events[i].isValue() ? 0 : events[i].endTicks - events[i].startTicks;
+  }
+  for (const Event &evt : events) {
+    if (evt.parentIndex >= 0 &&
+        static_cast<size_t>(evt.parentIndex) < events.size()) {
+      selfTicks[evt.parentIndex] -= evt.endTicks - evt.startTicks;
+    }
   }
 }
 
@@ -124,68 +712,394 @@ void ChronoProfiler::endFrame() {
 // Zone instrumentation //
 // -------------------- //
 
+/**
+ * @brief Return the calling thread's ring buffer.
+ *
+ * @details Small enough to inline into the zone functions: after the first
+ * zone it is a single TLS load and branch.
+ */
+ChronoProfiler::ThreadBuffer *ChronoProfiler::localBuffer() {
+  // threadBuffer is constant-initialized: the hot path is a plain TLS load
+  if (ThreadBuffer *buffer = threadBuffer) [[likely]]
+    return buffer;
+  return registerThreadBuffer();
+}
+
+/**
+ * @brief Give the calling thread a ring on its first zone.
+ *
+ * @details
+ * Takes a ring from 'freeThreadBuffers' (or allocates one with the next
+ * dense ID), registers it in 'allThreadBuffers' and caches its address in a
+ * thread-local pointer. This is the only time a producer takes 'mergeMutex'.
+ * A recycled ring brings its thread ID along; the previous owner's name is
+ * cleared, since the ID now denotes this thread.
+ *
+ * A thread_local ThreadExitHook retires the ring when the thread exits; from
+ * then on this returns nullptr for the thread, since the ring may be handed
+ * to another one.
+ */
+ChronoProfiler::ThreadBuffer *ChronoProfiler::registerThreadBuffer() {
+  ThreadBuffer *&buffer = threadBuffer;
+  static thread_local bool exited = false;
+  if (exited)
+    return nullptr;
+
+  {
+    std::lock_guard<std::mutex> lock(mergeMutex);
+    std::unique_ptr<ThreadBuffer> owned;
+    if (!freeThreadBuffers.empty()) {
+      owned = std::move(freeThreadBuffers.back());
+      freeThreadBuffers.pop_back();
+      owned->reset();
+      if (std::atomic<uint16_t> *slot = threadNameSlot(owned->threadId))
+        slot->store(0, std::memory_order_release);
+    } else {
+      owned = std::make_unique<ThreadBuffer>(nextThreadId++);
+    }
+    buffer = owned.get();
+    allThreadBuffers.push_back(std::move(owned));
+  }
+
+  // First use constructs the hook; its destructor runs at thread exit
+  static thread_local ThreadExitHook exitHook;
+  exitHook.buffer = &buffer;
+  exitHook.exited = &exited;
+  return buffer;
+}
+
+/**
+ * @brief Retire the exiting thread's ring.
+ *
+ * @details Everything the thread published happens-before the release store,
+ * so the consumer that observes 'retired' drains the ring completely and can
+ * then recycle it. Zones still open at exit are discarded.
+ */
+ChronoProfiler::ThreadExitHook::~ThreadExitHook() {
+  if (buffer && *buffer) {
+    (*buffer)->retired.store(true, std::memory_order_release);
+    *buffer = nullptr;
+  }
+  if (exited)
+    *exited = true;
+}
+
+/**
+ * @brief Move rings of exited threads from the registry to the free pool.
+ *
+ * @details Keeps the relative order of live threads, so merged frames list
+ * threads in a stable order.
+ */
+void ChronoProfiler::recycleThreadBuffers() {
+  size_t kept = 0;
+  for (size_t i = 0; i < allThreadBuffers.size(); ++i) {
+    if (allThreadBuffers[i]->reclaimable)
+      freeThreadBuffers.push_back(std::move(allThreadBuffers[i]));
+    else if (kept++ != i)
+      allThreadBuffers[kept - 1] = std::move(allThreadBuffers[i]);
+  }
+  allThreadBuffers.resize(kept);
+}
+
+/**
+ * @brief Intern a string through the calling thread's name cache.
+ *
+ * @param text String to intern
+ * @param color Zone color to register with a newly interned name
+ * @return Interned string ID
+ *
+ * @details Zone names are almost always string literals, so the cache is keyed
+ * by the string's address. A hit is confirmed by comparing against the
+ * interned text, which keeps reused (non-literal) buffers correct.
+ */
+uint16_t ChronoProfiler::ThreadBuffer::intern(std::string_view text,
+                                              uint32_t color) {
+  if (text.empty())
+    return 0;
+
+  const auto addr = reinterpret_cast<uintptr_t>(text.data());
+  NameCacheEntry &entry =
+      nameCache[((addr >> 3) ^ (addr >> 11)) & (kNameCacheSize - 1)];
+
+  if (entry.data == text.data() && entry.size == text.size() &&
+      getString(entry.id) == text) {
+    return entry.id;
+  }
+
+  entry = {text.data(), text.size(), internString(text, color)};
+  return entry.id;
+}
+
 /**
  * @brief Start a profiling zone for the current thread.
  *
- * @param name Zone name (caller-owned string)
+ * @param name Zone name (interned on first use)
  * @param color Optional RGBA color for visualization (default 0x64C8FFFF)
  * @param category Optional string category for grouping zones in UI
  *
  * @details
- * Creates an Event object and pushes it onto the thread-local vector. Duration
- * is calculated later when 'pushEventEnd()' is called.
+ * Fills the next slot of the thread's open-zone stack and records the current
+ * stack depth, which endFrame() uses to rebuild the zone hierarchy. The event
+ * is only
+ * published to the ring buffer once 'pushEventEnd()' completes it, so the
+ * consumer never observes a half-written event.
  *
- * @note Each thread registers its local buffer only once using a thread-local
- * static lambda.
- * @note Prevents runaway growth using 'kMaxEventsPerThread'.
+ * @note Zones nested deeper than 'kMaxZoneDepth' are counted as dropped.
  */
 void ChronoProfiler::pushEventStart(std::string_view name, uint32_t color,
-                                    const std::string &category) {
-  // Register this thread's buffer once
-  static thread_local bool registered = []() -> bool {
-    std::lock_guard<std::mutex> lock(mergeMutex);
-    allThreadBuffers.push_back(&threadEvents);
-    return true;
-  }();
+                                    std::string_view category) {
+  ThreadBuffer *buffer = localBuffer();
+  if (!buffer) [[unlikely]]
+    return; // Called while the thread is exiting
 
-  if (threadEvents.size() >= kMaxEventsPerThread) {
-    return; ///< Prevent runaway growth
+  openZone(*buffer, buffer->intern(name, color), buffer->intern(category, 0));
+}
+
+/**
+ * @brief Start a zone registered at compile time by PROFILE_SCOPE.
+ *
+ * @param site Registration slot of the call site
+ *
+ * @details
+ * After the first call the IDs come from a relaxed load of the site, so no
+ * string is hashed or compared. Racing first calls intern the same strings
+ * and store the same IDs. A site whose name and category both resolved to ID
+ * 0 (table full) simply registers again, which stays correct.
+ */
+void ChronoProfiler::pushEventStart(ZoneSite &site) {
+  ThreadBuffer *buffer = localBuffer();
+  if (!buffer) [[unlikely]]
+    return; // Called while the thread is exiting
+
+  uint32_t ids = site.ids.load(std::memory_order_relaxed);
+  if (ids == 0) [[unlikely]]
+    ids = registerZone(site);
+
+  openZone(*buffer, static_cast<uint16_t>(ids & 0xFFFF),
+           static_cast<uint16_t>(ids >> 16));
+}
+
+/**
+ * @brief Push an open zone onto a thread's stack of open zones.
+ * @param buffer Calling thread's ring
+ * @param nameId Interned zone name
+ * @param categoryId Interned category (0 = none)
+ *
+ * @details Zones deeper than kMaxZoneDepth are counted as overflow but still
+ * tracked in 'openCount' so the matching pushEventEnd() stays balanced.
+ */
+void ChronoProfiler::openZone(ThreadBuffer &buffer, uint16_t nameId,
+                              uint16_t categoryId) {
+  if (buffer.openCount < kMaxZoneDepth) {
+    Event &evt = buffer.openZones[buffer.openCount];
+    evt.nameId = nameId;
+    evt.categoryId = categoryId;
+    evt.threadId = buffer.threadId;
+    evt.parentIndex = -1;
+    evt.depth = static_cast<uint16_t>(buffer.openCount);
+    evt.flags = 0;
+    evt.endTicks = 0; ///< Unknown until pushEventEnd()
+    buffer.openAllocs[buffer.openCount] = {};
+    evt.startTicks = nowTicks();
+  } else {
+    buffer.overflowCount.fetch_add(1, std::memory_order_relaxed);
   }
 
-  Event evt{};
-  evt.name = name;
-  evt.startMs = nowMs();
-  evt.durationMs = -1.0; ///< Duration unknown until pushEventEnd()
-  evt.threadId = static_cast<uint32_t>(
-      std::hash<std::thread::id>{}(std::this_thread::get_id()));
-  evt.color = color;
-  evt.category = category;
+  ++buffer.openCount; // Still track depth so ends stay balanced
+}
+
+/**
+ * @brief Resolve a PROFILE_SCOPE site's IDs on its first use.
+ * @param site Registration slot of the call site
+ * @return (categoryId << 16) | nameId, also stored in the site
+ *
+ * @details The first site registered under a name becomes its source (see
+ * getZoneSource()); the descriptor is a static constexpr object, so the
+ * pointer stays valid for the lifetime of the process.
+ */
+uint32_t ChronoProfiler::registerZone(ZoneSite &site) {
+  const ZoneDescriptor &desc = site.desc;
+  const uint16_t nameId = internString(desc.name, desc.color);
+  const uint16_t categoryId = internString(desc.category);
+
+  if (nameId != 0) {
+    StringPage *page =
+        stringPages[nameId / kStringPageSize].load(std::memory_order_acquire);
+    const ZoneDescriptor *expected = nullptr;
+    page->entries[nameId % kStringPageSize].source.compare_exchange_strong(
+        expected, &desc, std::memory_order_release, std::memory_order_relaxed);
+  }
 
-  threadEvents.push_back(evt); // Store event in thread-local buffer
-  totalEventCount++;           // Increment global event counter
+  const uint32_t ids = (static_cast<uint32_t>(categoryId) << 16) | nameId;
+  site.ids.store(ids, std::memory_order_relaxed);
+  return ids;
 }
 
 /**
  * @brief End the most recent profiling zone for the current thread.
  *
  * @details
- * Calculates the duration of the zone and converts the start time to be
- * relative to 'frameStart'.
+ * Pops the innermost open zone, stamps its end tick and publishes it to the
+ * ring buffer. Because the stack is LIFO, a parent ScopedZone always closes its
+ * own event even after children have been pushed.
  *
- * @note Does nothing if there are no events in the thread-local buffer.
+ * @note Does nothing if the thread has no open zone.
  */
 void ChronoProfiler::pushEventEnd() {
-  if (threadEvents.empty())
+  ThreadBuffer *buffer = localBuffer();
+  if (!buffer) [[unlikely]]
+    return; // Called while the thread is exiting
+  if (buffer->openCount == 0)
     return;
 
-  Event &evt = threadEvents.back();
-  double endTimeMs = nowMs();
-  evt.durationMs = endTimeMs - evt.startMs; // Compute how long the event lasted
+  if (--buffer->openCount >= kMaxZoneDepth)
+    return; // Start was dropped for exceeding the depth limit
 
-  // Adjust start time to be relative to the beginning of the frame
-  evt.startMs -=
-      std::chrono::duration<double, std::milli>(frameStart.time_since_epoch())
-          .count();
+  Event &evt = buffer->openZones[buffer->openCount];
+  evt.endTicks = nowTicks();
+
+  buffer->push(evt); // Publish the finished event
+
+  const ThreadBuffer::AllocTally &allocs = buffer->openAllocs[buffer->openCount];
+  if (allocs.count != 0) [[unlikely]] {
+    // Two counter increments keyed by the zone; endFrame() renames them
+    Event tally{};
+    tally.startTicks = evt.endTicks;
+    tally.threadId = evt.threadId;
+    tally.parentIndex = -1;
+    tally.nameId = evt.nameId;
+    tally.endTicks = allocs.count;
+    tally.flags = Event::kFlagCounter | Event::kFlagAllocCount;
+    buffer->push(tally);
+    tally.endTicks = allocs.bytes;
+    tally.flags = Event::kFlagCounter | Event::kFlagAllocBytes;
+    buffer->push(tally);
+  }
+}
+
+// ------------------------ //
+// Counter and gauge tracks //
+// ------------------------ //
+
+/**
+ * @brief Publish a counter or gauge sample for the current thread.
+ * @param name Counter or gauge name
+ * @param flags Event::kFlagCounter or Event::kFlagPlot
+ * @param bits Value stored in 'endTicks'
+ */
+void ChronoProfiler::pushValue(std::string_view name, uint16_t flags,
+                               uint64_t bits) {
+  ThreadBuffer *buffer = localBuffer();
+  if (!buffer) [[unlikely]]
+    return; // Called while the thread is exiting
+
+  Event evt{};
+  evt.startTicks = nowTicks();
+  evt.endTicks = bits;
+  evt.threadId = buffer->threadId;
+  evt.parentIndex = -1;
+  evt.nameId = buffer->intern(name, 0);
+  evt.flags = flags;
+  buffer->push(evt);
+}
+
+/**
+ * @brief Add to a counter summed per frame.
+ * @param name Counter name
+ * @param delta Amount to add
+ */
+void ChronoProfiler::counter(std::string_view name, int64_t delta) {
+  pushValue(name, Event::kFlagCounter, static_cast<uint64_t>(delta));
+}
+
+/**
+ * @brief Record a gauge sample.
+ * @param name Gauge name
+ * @param value Current value
+ */
+void ChronoProfiler::plot(std::string_view name, double value) {
+  pushValue(name, Event::kFlagPlot, std::bit_cast<uint64_t>(value));
+}
+
+// ------------------- //
+// Allocation tracking //
+// ------------------- //
+
+/**
+ * @brief Enable or disable charging allocations to zones.
+ * @param enabled New state
+ */
+void ChronoProfiler::setAllocationTracking(bool enabled) {
+  allocationTracking.store(enabled, std::memory_order_relaxed);
+}
+
+/**
+ * @brief Report whether allocations are charged to zones.
+ * @return True while tracking is on
+ */
+bool ChronoProfiler::isAllocationTracking() {
+  return allocationTracking.load(std::memory_order_relaxed);
+}
+
+/**
+ * @brief Charge an allocation to the innermost open zone of this thread.
+ * @param bytes Requested size
+ *
+ * @details Runs inside operator new, so it only reads the constant-initialized
+ * thread-local ring pointer and bumps producer-only counters; it never
+ * registers a ring. Zones nested past kMaxZoneDepth are not recorded, so
+ * their allocations go to the deepest recorded zone.
+ */
+void ChronoProfiler::recordAllocation(size_t bytes) {
+  if (!allocationTracking.load(std::memory_order_relaxed)) [[likely]]
+    return;
+  ThreadBuffer *buffer = threadBuffer;
+  if (!buffer || buffer->openCount == 0)
+    return; // Not inside a zone
+
+  ThreadBuffer::AllocTally &tally =
+      buffer->openAllocs[std::min(buffer->openCount, kMaxZoneDepth) - 1];
+  ++tally.count;
+  tally.bytes += bytes;
+}
+
+/**
+ * @brief Total the allocation counters of the last captured frame.
+ * @return Allocations made inside zones during that frame
+ */
+int64_t ChronoProfiler::frameAllocationCount() {
+  int64_t count = 0;
+  for (const Event &evt : frameEvents) {
+    if ((evt.flags & Event::kFlagCounter) &&
+        getString(evt.nameId).starts_with(kAllocCountPrefix))
+      count += static_cast<int64_t>(evt.endTicks);
+  }
+  return count;
+}
+
+/**
+ * @brief Rename an allocation tally to its zone's counter.
+ * @param evt Tally drained from a ring
+ * @return Plain counter sample
+ *
+ * @note Called with mergeMutex held. Interning allocates only the first time
+ * a zone reports allocations.
+ */
+ChronoProfiler::Event ChronoProfiler::renameAllocation(Event evt) {
+  if (allocCounterNames.size() <= evt.nameId)
+    allocCounterNames.resize(evt.nameId + 1u, {0, 0});
+
+  const bool bytes = (evt.flags & Event::kFlagAllocBytes) != 0;
+  uint16_t &counterId = allocCounterNames[evt.nameId][bytes ? 1 : 0];
+  if (counterId == 0) {
+    std::string name(bytes ? kAllocBytesPrefix : kAllocCountPrefix);
+    name += getString(evt.nameId);
+    counterId = internString(name);
+  }
+
+  evt.nameId = counterId;
+  evt.flags = Event::kFlagCounter;
+  return evt;
 }
 
 // --------- //
@@ -202,36 +1116,219 @@ const std::vector<ChronoProfiler::Event> &ChronoProfiler::getEvents() {
   return frameEvents;
 }
 
+/**
+ * @brief Thread names of the last completed frame, captured when it was merged.
+ * @return Sorted (threadId, nameId) pairs
+ *
+ * @note Valid only until the next frame.
+ */
+std::span<const ChronoProfiler::ThreadName> ChronoProfiler::getThreadNames() {
+  return frameThreadNames;
+}
+
+/**
+ * @brief Look a thread up in a frame's name snapshot.
+ * @param names Sorted snapshot of the frame
+ * @param threadId Thread ID of one of its events
+ * @return Name the thread had in that frame, or "<unnamed>"
+ */
+std::string_view
+ChronoProfiler::findThreadName(std::span<const ThreadName> names,
+                               uint32_t threadId) {
+  auto it = std::lower_bound(names.begin(), names.end(), threadId,
+                             [](const ThreadName &name, uint32_t id) {
+                               return name.threadId < id;
+                             });
+  if (it == names.end() || it->threadId != threadId || it->nameId == 0)
+    return "<unnamed>";
+  return getString(it->nameId);
+}
+
+/**
+ * @brief Queue events from another timeline for the next 'endFrame()'.
+ * @param events Completed events in profiler ticks
+ *
+ * @details Called once per frame by GpuProfiler, so taking 'mergeMutex' here
+ * does not affect the per-zone hot path.
+ */
+void ChronoProfiler::submitEvents(std::span<const Event> events) {
+  std::lock_guard<std::mutex> lock(mergeMutex);
+  submittedEvents.insert(submittedEvents.end(), events.begin(), events.end());
+}
+
+/**
+ * @brief Tick value recorded by the most recent 'beginFrame()'.
+ * @return Frame start in raw ticks
+ */
+uint64_t ChronoProfiler::getFrameStartTicks() { return frameStartTicks; }
+
+// ------------ //
+// String table //
+// ------------ //
+
+/**
+ * @brief Intern a string into the global table.
+ * @param text String to intern
+ * @param color Zone color stored with a newly created entry
+ * @return 16-bit ID of the string (0 for "" or when the table is full)
+ *
+ * @details Entries live in fixed pages that are published through atomics, so
+ * 'getString()' can read them without taking 'stringTableMutex'.
+ */
+uint16_t ChronoProfiler::internString(std::string_view text, uint32_t color) {
+  if (text.empty())
+    return 0;
+
+  std::lock_guard<std::mutex> lock(stringTableMutex);
+
+  if (stringCount == 0) {
+    stringCount = 1; // Reserve ID 0 for the empty string
+  }
+
+  auto it = stringIds.find(text);
+  if (it != stringIds.end())
+    return it->second;
+
+  if (stringCount >= kMaxStrings)
+    return 0; // Table full: fall back to the empty name
+
+  const size_t id = stringCount;
+  const size_t pageIndex = id / kStringPageSize;
+  StringPage *page = stringPages[pageIndex].load(std::memory_order_relaxed);
+  if (!page) {
+    ownedStringPages.push_back(std::make_unique<StringPage>());
+    page = ownedStringPages.back().get();
+  }
+
+  InternedString &entry = page->entries[id % kStringPageSize];
+  entry.text = std::string(text);
+  entry.color = color;
+
+  // Publish the page after the entry is written so lock-free readers see it
+  stringPages[pageIndex].store(page, std::memory_order_release);
+
+  stringIds.emplace(entry.text, static_cast<uint16_t>(id));
+  ++stringCount;
+  return static_cast<uint16_t>(id);
+}
+
+/**
+ * @brief Look up an interned string without locking.
+ * @param id ID returned by 'internString()'
+ * @return View of the interned text, or "" for unknown IDs
+ */
+std::string_view ChronoProfiler::getString(uint16_t id) {
+  const StringPage *page =
+      stringPages[id / kStringPageSize].load(std::memory_order_acquire);
+  return page ? std::string_view(page->entries[id % kStringPageSize].text)
+              : std::string_view();
+}
+
+/**
+ * @brief Color registered with an interned zone name.
+ * @param id ID returned by 'internString()'
+ * @return RGBA color, or 0 if none was registered
+ */
+uint32_t ChronoProfiler::getZoneColor(uint16_t id) {
+  const StringPage *page =
+      stringPages[id / kStringPageSize].load(std::memory_order_acquire);
+  return page ? page->entries[id % kStringPageSize].color : 0;
+}
+
+/**
+ * @brief Look up the PROFILE_SCOPE call site first registered under a name.
+ * @param id ID returned by 'internString()'
+ * @return Descriptor of the call site, or nullptr if there is none
+ */
+const ChronoProfiler::ZoneDescriptor *
+ChronoProfiler::getZoneSource(uint16_t id) {
+  const StringPage *page =
+      stringPages[id / kStringPageSize].load(std::memory_order_acquire);
+  return page ? page->entries[id % kStringPageSize].source.load(
+                    std::memory_order_acquire)
+              : nullptr;
+}
+
 // ------------- //
 // Thread naming //
 // ------------- //
 
+/**
+ * @brief Return the calling thread's dense ID, registering its ring on first use.
+ * @return Dense thread ID, or kExitedThreadId while the thread is exiting
+ *
+ * @details The ID is the ring's, so it is taken over from an exited thread
+ * whenever registration recycles that thread's ring.
+ */
+uint32_t ChronoProfiler::currentThreadId() {
+  const ThreadBuffer *buffer = localBuffer();
+  return buffer ? buffer->threadId : kExitedThreadId;
+}
+
+/**
+ * @brief Locate the registry slot for a thread's name.
+ * @param threadId Dense thread ID or one of the pseudo-thread IDs
+ * @return Slot, or nullptr for IDs that cannot be named
+ */
+std::atomic<uint16_t> *ChronoProfiler::threadNameSlot(uint32_t threadId) {
+  if (threadId < kMaxNamedThreads)
+    return &threadNameIds[threadId];
+  if (threadId == kGpuThreadId)
+    return &gpuThreadNameId;
+  if (threadId == kCounterThreadId)
+    return &counterThreadNameId;
+  return nullptr;
+}
+
 /**
  * @brief Assign a human-readable name to the current thread.
  * @param name Thread name string
  *
- * @details Useful for labeling timeline tracks in visualizations.
- *          Stores mapping from thread ID to name in a thread-safe way.
+ * @details Useful for labeling timeline tracks in visualizations. The name is
+ * interned and its ID published with a release store, so readers never lock.
  */
 void ChronoProfiler::setThreadName(const std::string &name) {
-  uint32_t id = static_cast<uint32_t>(
-      std::hash<std::thread::id>{}(std::this_thread::get_id()));
-  std::lock_guard<std::mutex> lock(threadNamesMutex);
-  threadNames[id] = name; // Map thread ID to name
+  setThreadName(currentThreadId(), name);
+}
+
+/**
+ * @brief Assign a human-readable name to an arbitrary thread ID.
+ * @param threadId Numeric thread ID (e.g. 'kGpuThreadId')
+ * @param name Thread name string
+ *
+ * @details Renaming replaces the published ID; the old name stays in the
+ * string table, so views handed out earlier remain valid.
+ */
+void ChronoProfiler::setThreadName(uint32_t threadId, const std::string &name) {
+  if (std::atomic<uint16_t> *slot = threadNameSlot(threadId))
+    slot->store(internString(name), std::memory_order_release);
 }
 
 /**
  * @brief Retrieve a human-readable name for a given thread ID.
  * @param threadId Numeric thread ID
- * @return Thread name string if set, otherwise "<unnamed>"
+ * @return Thread name if set, otherwise "<unnamed>"
+ */
+std::string_view ChronoProfiler::getThreadName(uint32_t threadId) {
+  const std::atomic<uint16_t> *slot = threadNameSlot(threadId);
+  const uint16_t nameId = slot ? slot->load(std::memory_order_acquire) : 0;
+  return nameId != 0 ? getString(nameId) : std::string_view("<unnamed>");
+}
+
+/**
+ * @brief Report how many events each registered thread has dropped.
+ * @return One entry per registered thread, in registration order
  */
-std::string ChronoProfiler::getThreadName(uint32_t threadId) {
-  // Ensure thread-safe access to threadNames map
-  std::lock_guard<std::mutex> lock(threadNamesMutex);
-  auto it = threadNames.find(threadId); // Look up the thread ID
-  return (it != threadNames.end())
-             ? it->second
-             : "<unnamed>"; // Return name if found, else "<unnamed>"
+std::vector<ChronoProfiler::ThreadOverflow>
+ChronoProfiler::getOverflowCounts() {
+  std::lock_guard<std::mutex> lock(mergeMutex);
+  std::vector<ThreadOverflow> counts;
+  counts.reserve(allThreadBuffers.size());
+  for (const auto &buffer : allThreadBuffers) {
+    counts.push_back({buffer->threadId,
+                      buffer->overflowCount.load(std::memory_order_relaxed)});
+  }
+  return counts;
 }
 
 // ----------- //
@@ -242,21 +1339,47 @@ std::string ChronoProfiler::getThreadName(uint32_t threadId) {
  * @brief Export current frame events to a JSON file.
  * @param filename Path to output JSON file
  *
- * @details Each Event object is serialized with name, timestamps, duration,
- *          thread ID, thread name, color, and category.
+ * @details Each Event object is serialized with name, timestamps, inclusive
+ *          and self duration, nesting (depth/parent), thread ID, thread name,
+ *          color, and category. Ticks are converted to milliseconds here.
+ *          Counter and gauge samples are serialized as name, start, type
+ *          ("counter" or "plot") and value.
  */
 void ChronoProfiler::exportToJSON(const std::string &filename) {
   nlohmann::json j; // JSON array to store all frame events
 
-  for (const auto &evt : frameEvents) {
+  std::vector<uint64_t> selfTicks;
+  computeSelfTicks(frameEvents, selfTicks);
+
+  for (size_t i = 0; i < frameEvents.size(); ++i) {
+    const Event &evt = frameEvents[i];
+    const int64_t startFromFrame =
+        static_cast<int64_t>(evt.startTicks - capturedFrameStartTicks);
+
+    if (evt.isValue()) {
+      j.push_back({{"name", getString(evt.nameId)},
+                   {"startMs", ticksToMs(startFromFrame)},
+                   {"type", (evt.flags & Event::kFlagPlot) ? "plot" : "counter"},
+                   {"value", evt.value()}});
+      continue;
+    }
+
     // Add event details to the JSON array
-    j.push_back({{"name", evt.name},
-                 {"startMs", evt.startMs},
-                 {"durationMs", evt.durationMs},
-                 {"threadId", evt.threadId},
-                 {"threadName", getThreadName(evt.threadId)},
-                 {"color", evt.color},
-                 {"category", evt.category}});
+    nlohmann::json zone = {{"name", getString(evt.nameId)},
+                           {"startMs", ticksToMs(startFromFrame)},
+                           {"durationMs", evt.durationMs()},
+                           {"selfMs", ticksToMs(selfTicks[i])},
+                           {"depth", evt.depth},
+                           {"parent", evt.parentIndex},
+                           {"threadId", evt.threadId},
+                           {"threadName", findThreadName(frameThreadNames, evt.threadId)},
+                           {"color", getZoneColor(evt.nameId)},
+                           {"category", getString(evt.categoryId)}};
+    if (const ZoneDescriptor *source = getZoneSource(evt.nameId)) {
+      zone["file"] = std::string(source->file);
+      zone["line"] = source->line;
+    }
+    j.push_back(zone);
   }
 
   std::ofstream ofs(filename); // Open the file for writing
@@ -264,3 +1387,84 @@ void ChronoProfiler::exportToJSON(const std::string &filename) {
     ofs << std::setw(2) << j << std::endl; // Write formatted JSON to file
   }
 }
+
+/**
+ * @brief Start streaming frames to a capture file.
+ * @param filename Output path; '.chrono' selects the binary format
+ * @return False if the file could not be opened
+ *
+ * @details Timestamps in the trace are relative to this call.
+ */
+bool ChronoProfiler::beginTrace(const std::string &filename) {
+  endTrace(); // Finish a previous trace before truncating a new file
+
+  const bool binary = filename.ends_with(".chrono");
+  std::unique_ptr<ChronoTraceWriter> writer;
+  try {
+    writer = std::make_unique<ChronoTraceWriter>(
+        filename, nowTicks(),
+        binary ? ChronoTraceWriter::Format::Binary
+               : ChronoTraceWriter::Format::ChromeJson);
+  } catch (const std::exception &e) {
+    std::cerr << "ChronoProfiler: " << e.what() << std::endl;
+    return false;
+  }
+
+  std::lock_guard<std::mutex> lock(mergeMutex);
+  traceWriter = std::move(writer);
+  return true;
+}
+
+/**
+ * @brief Flush and close the active trace.
+ *
+ * @details The writer is detached under mergeMutex and destroyed outside it,
+ * so endFrame() on other threads is not blocked by the final flush.
+ */
+void ChronoProfiler::endTrace() {
+  std::unique_ptr<ChronoTraceWriter> writer;
+  {
+    std::lock_guard<std::mutex> lock(mergeMutex);
+    writer = std::move(traceWriter);
+  }
+
+  if (writer && writer->droppedEvents() > 0) {
+    std::cerr << "ChronoProfiler: trace dropped " << writer->droppedEvents()
+              << " events (writer queue full)" << std::endl;
+  }
+}
+
+/**
+ * @brief Start the live viewer server.
+ * @param port Port to listen on (127.0.0.1 only)
+ * @return False if the port could not be bound
+ */
+bool ChronoProfiler::startLiveServer(uint16_t port) {
+  stopLiveServer(); // Release the previous port first
+
+  std::unique_ptr<ChronoLiveServer> server;
+  try {
+    server = std::make_unique<ChronoLiveServer>(port);
+  } catch (const std::exception &e) {
+    std::cerr << "ChronoProfiler: " << e.what() << std::endl;
+    return false;
+  }
+
+  std::lock_guard<std::mutex> lock(mergeMutex);
+  liveServer = std::move(server);
+  return true;
+}
+
+/**
+ * @brief Stop the live viewer server.
+ *
+ * @details Detached under mergeMutex and destroyed outside it, like
+ * endTrace(), so endFrame() never waits for the server thread to exit.
+ */
+void ChronoProfiler::stopLiveServer() {
+  std::unique_ptr<ChronoLiveServer> server;
+  {
+    std::lock_guard<std::mutex> lock(mergeMutex);
+    server = std::move(liveServer);
+  }
+}
@@ -0,0 +1,342 @@
+#if defined(PROFILER)
+
+#include "ChronoTraceWriter.hpp"
+
+/**
+ * @file ChronoTraceWriter.cpp
+ * @brief Implementation of the streaming capture writer.
+ *
+ * @details
+ * The JSON document is written as
+ * '{"traceEvents":[ <event>, <event>, ... ]}'. Events are appended as soon as
+ * the flush thread has formatted them, so a capture that is cut short can
+ * still be repaired by appending ']}' (chrome://tracing accepts it as is).
+ *
+ * Binary captures are a header followed by self-delimiting chunks (see
+ * ChronoCapture.hpp); readers stop cleanly at a truncated final chunk.
+ *
+ * @note This implementation uses standard C++ libraries:
+ *  - '<charconv>' for allocation-free number formatting
+ *  - '<thread>', '<mutex>' and '<condition_variable>' for the flush thread
+ *  - '<unistd.h>' for the process ID reported in every event
+ */
+
+#include <charconv>  ///< std::to_chars for numbers
+#include <cmath>     ///< std::isfinite for counter values
+#include <stdexcept> ///< std::runtime_error when the file cannot be opened
+#include <unistd.h>  ///< getpid()
+
+/** @brief Flush to disk once this many bytes of JSON are buffered. */
+static constexpr size_t kFlushBytes = 256 * 1024;
+
+/**
+ * @brief Open the trace file, write the document header and start flushing.
+ *
+ * @param filename Output path
+ * @param originTicks Tick value mapped to ts = 0
+ * @param format On-disk encoding
+ * @param maxPendingEvents Maximum number of queued events
+ */
+ChronoTraceWriter::ChronoTraceWriter(const std::string &filename,
+                                     uint64_t originTicks, Format format,
+                                     size_t maxPendingEvents)
+    : format(format), maxPendingEvents(maxPendingEvents),
+      originTicks(originTicks),
+      processId(static_cast<long>(getpid())) {
+  file = std::fopen(filename.c_str(), "wb");
+  if (!file) {
+    throw std::runtime_error("failed to open trace file: " + filename);
+  }
+
+  pending.reserve(maxPendingEvents);
+  batch.reserve(maxPendingEvents);
+  pendingFrames.reserve(kMaxPendingFrames);
+  batchFrames.reserve(kMaxPendingFrames);
+  pendingNames.reserve(kMaxPendingFrames);
+  batchNames.reserve(kMaxPendingFrames);
+  output.reserve(kFlushBytes * 2);
+
+  if (format == Format::Binary)
+    chronocap::writeHeader(output, originTicks, ChronoProfiler::usesTsc());
+  else
+    output += "{\"traceEvents\":[\n";
+  flushThread = std::thread(&ChronoTraceWriter::run, this);
+}
+
+/**
+ * @brief Stop the flush thread after it has written everything queued, then
+ * close the JSON array and the file.
+ */
+ChronoTraceWriter::~ChronoTraceWriter() {
+  {
+    std::lock_guard<std::mutex> lock(queueMutex);
+    stopping = true;
+  }
+  queueCondition.notify_one();
+  flushThread.join();
+
+  if (format == Format::ChromeJson)
+    output += "\n],\"displayTimeUnit\":\"ms\"}\n";
+  flushOutput();
+  std::fclose(file);
+}
+
+/**
+ * @brief Queue a frame's events for the flush thread.
+ *
+ * @param events Frame events to copy
+ * @param threadNames Names of the frame's threads when it was merged
+ * @param frameStartTicks Tick at which the frame began
+ * @return True if queued, false if dropped because the queue was full
+ *
+ * @details The caller only pays for a memcpy of 32-byte records under a
+ * briefly held mutex; all formatting and I/O happen on the flush thread.
+ * The names travel with the frame because its thread IDs may belong to other
+ * threads by the time the flush thread gets to it.
+ */
+bool ChronoTraceWriter::submit(
+    std::span<const ChronoProfiler::Event> events,
+    std::span<const ChronoProfiler::ThreadName> threadNames,
+    uint64_t frameStartTicks) {
+  {
+    std::lock_guard<std::mutex> lock(queueMutex);
+    const uint64_t index = nextFrameIndex++;
+    if (pending.size() + events.size() > maxPendingEvents ||
+        pendingFrames.size() >= kMaxPendingFrames) {
+      dropped += events.size(); // Never stall the frame thread
+      return false;
+    }
+    pending.insert(pending.end(), events.begin(), events.end());
+    pendingNames.insert(pendingNames.end(), threadNames.begin(),
+                        threadNames.end());
+    pendingFrames.push_back(
+        {index, frameStartTicks, events.size(), threadNames.size()});
+  }
+  queueCondition.notify_one();
+  return true;
+}
+
+/**
+ * @brief Number of events discarded because the queue was full.
+ * @return Dropped event count
+ */
+uint64_t ChronoTraceWriter::droppedEvents() const {
+  std::lock_guard<std::mutex> lock(queueMutex);
+  return dropped;
+}
+
+/**
+ * @brief Flush thread main loop.
+ *
+ * @details Swaps the pending queue with an empty, pre-reserved batch so the
+ * lock is held only for the swap, then formats the batch without locking.
+ */
+void ChronoTraceWriter::run() {
+  for (;;) {
+    {
+      std::unique_lock<std::mutex> lock(queueMutex);
+      queueCondition.wait(
+          lock, [this] { return stopping || !pendingFrames.empty(); });
+      if (pendingFrames.empty() && stopping)
+        break;
+      batch.swap(pending);
+      batchNames.swap(pendingNames);
+      batchFrames.swap(pendingFrames);
+    }
+
+    size_t first = 0;
+    size_t firstName = 0;
+    for (const auto &frame : batchFrames) {
+      std::span<const ChronoProfiler::Event> events(batch.data() + first,
+                                                    frame.eventCount);
+      std::span<const ChronoProfiler::ThreadName> threadNames(
+          batchNames.data() + firstName, frame.nameCount);
+      first += frame.eventCount;
+      firstName += frame.nameCount;
+
+      if (format == Format::Binary) {
+        encodeFrame(frame, events, threadNames);
+      } else {
+        for (const auto &evt : events)
+          formatEvent(evt, threadNames);
+      }
+      if (output.size() >= kFlushBytes)
+        flushOutput();
+    }
+    batch.clear();
+    batchNames.clear();
+    batchFrames.clear();
+    flushOutput(); // Make every frame visible on disk incrementally
+  }
+}
+
+/**
+ * @brief Check whether a thread's name needs (re)writing.
+ * @param threadId Thread ID of the event about to be written
+ * @param threadNames Names of the event's frame, captured when it was merged
+ * @param name Receives the thread's name in that frame
+ * @return True if the name was never written for this ID or has changed
+ */
+bool ChronoTraceWriter::threadNameChanged(
+    uint32_t threadId, std::span<const ChronoProfiler::ThreadName> threadNames,
+    std::string_view &name) {
+  name = ChronoProfiler::findThreadName(threadNames, threadId);
+  const auto [written, inserted] = writtenNames.try_emplace(threadId, name);
+  if (!inserted && written->second == name)
+    return false;
+  written->second = name;
+  return true;
+}
+
+/**
+ * @brief Format one event as a Chrome 'X' (complete) event.
+ *
+ * @param evt Event to format
+ * @param threadNames Names of the event's frame
+ *
+ * @details The first event seen from a thread is preceded by a 'thread_name'
+ * metadata record so trace viewers label the track, and so is the first
+ * event after the name behind a thread ID changed (a renamed thread, or an
+ * exited thread's ID reused by a new one). Counter and gauge samples
+ * become 'C' events, which viewers draw as one counter track per name.
+ */
+void ChronoTraceWriter::formatEvent(
+    const ChronoProfiler::Event &evt,
+    std::span<const ChronoProfiler::ThreadName> threadNames) {
+  if (evt.isValue()) {
+    output += firstRecord ? "" : ",\n";
+    firstRecord = false;
+    output += "{\"name\":";
+    chronocap::appendJsonString(output, ChronoProfiler::getString(evt.nameId));
+    output += ",\"ph\":\"C\",\"ts\":";
+    appendMicros(static_cast<int64_t>(evt.startTicks - originTicks));
+    output += ",\"pid\":";
+    output += std::to_string(processId);
+    output += ",\"args\":{\"value\":";
+    appendValue(evt.value());
+    output += "}}";
+    return;
+  }
+
+  if (std::string_view name; threadNameChanged(evt.threadId, threadNames, name)) {
+    output += firstRecord ? "" : ",\n";
+    firstRecord = false;
+    output += "{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":";
+    output += std::to_string(processId);
+    output += ",\"tid\":";
+    output += std::to_string(evt.threadId);
+    output += ",\"args\":{\"name\":";
+    chronocap::appendJsonString(output, name);
+    output += "}}";
+  }
+
+  output += firstRecord ? "" : ",\n";
+  firstRecord = false;
+
+  output += "{\"name\":";
+  chronocap::appendJsonString(output, ChronoProfiler::getString(evt.nameId));
+  if (evt.categoryId != 0) {
+    output += ",\"cat\":";
+    chronocap::appendJsonString(output, ChronoProfiler::getString(evt.categoryId));
+  }
+  output += ",\"ph\":\"X\",\"ts\":";
+  appendMicros(static_cast<int64_t>(evt.startTicks - originTicks));
+  output += ",\"dur\":";
+  appendMicros(static_cast<int64_t>(evt.endTicks - evt.startTicks));
+  output += ",\"pid\":";
+  output += std::to_string(processId);
+  output += ",\"tid\":";
+  output += std::to_string(evt.threadId);
+  output += "}";
+}
+
+/**
+ * @brief Append one frame to a binary capture.
+ *
+ * @param frame Frame boundary and index
+ * @param events The frame's events
+ * @param threadNames The frame's thread names
+ *
+ * @details Strings are written the first time an event references them, a
+ * thread's name whenever it differs from the one last written for its ID,
+ * and a clock chunk whenever the calibrated tick period has changed, so
+ * every frame chunk can be decoded with what precedes it.
+ */
+void ChronoTraceWriter::encodeFrame(
+    const PendingFrame &frame, std::span<const ChronoProfiler::Event> events,
+    std::span<const ChronoProfiler::ThreadName> threadNames) {
+  auto writeString = [this](uint16_t id) {
+    if (writtenStrings.test(id))
+      return;
+    writtenStrings.set(id);
+    const std::string_view text = ChronoProfiler::getString(id);
+    chunk.clear();
+    chronocap::putVarint(chunk, id);
+    chronocap::putFixed<uint32_t>(chunk, ChronoProfiler::getZoneColor(id));
+    chronocap::putVarint(chunk, text.size());
+    chunk.append(text);
+    chronocap::writeChunk(output, chronocap::ChunkType::String, chunk);
+  };
+
+  for (const auto &evt : events) {
+    writeString(evt.nameId);
+    writeString(evt.categoryId);
+
+    if (std::string_view name; threadNameChanged(evt.threadId, threadNames, name)) {
+      chunk.clear();
+      chronocap::putVarint(chunk, evt.threadId);
+      chronocap::putVarint(chunk, name.size());
+      chunk.append(name);
+      chronocap::writeChunk(output, chronocap::ChunkType::Thread, chunk);
+    }
+  }
+
+  const double msPerTick = ChronoProfiler::getMsPerTick();
+  if (msPerTick != writtenMsPerTick) {
+    writtenMsPerTick = msPerTick;
+    chunk.clear();
+    chronocap::putDouble(chunk, msPerTick);
+    chronocap::writeChunk(output, chronocap::ChunkType::Clock, chunk);
+  }
+
+  chunk.clear();
+  chronocap::encodeFrame(chunk, frame.index, frame.startTicks, events);
+  chronocap::writeChunk(output, chronocap::ChunkType::Frame, chunk);
+}
+
+/**
+ * @brief Append a tick count converted to microseconds (3 decimals).
+ * @param ticks Tick value relative to the trace origin or a duration
+ */
+void ChronoTraceWriter::appendMicros(int64_t ticks) {
+  char digits[32];
+  const double micros = ChronoProfiler::ticksToMs(ticks) * 1000.0;
+  auto result = std::to_chars(digits, digits + sizeof(digits), micros,
+                              std::chars_format::fixed, 3);
+  output.append(digits, result.ptr);
+}
+
+/**
+ * @brief Append a counter or gauge value (shortest round-trip form).
+ * @param value Sample value
+ */
+void ChronoTraceWriter::appendValue(double value) {
+  if (!std::isfinite(value))
+    value = 0.0; // JSON has no NaN or infinity
+  char digits[32];
+  auto result = std::to_chars(digits, digits + sizeof(digits), value);
+  output.append(digits, result.ptr);
+}
+
+/**
+ * @brief Write buffered JSON to disk.
+ */
+void ChronoTraceWriter::flushOutput() {
+  if (output.empty())
+    return;
+  std::fwrite(output.data(), 1, output.size(), file);
+  std::fflush(file);
+  output.clear();
+}
+
+#endif // PROFILER
@@ -0,0 +1,153 @@
+#include "FramePacer.hpp"
+
+/**
+ * @file FramePacer.cpp
+ * @brief Frame pacing histograms, hitch detection and the end-of-run report.
+ */
+
+#include <algorithm> ///< std::min for the worst-hitch list
+#include <iomanip>   ///< std::setw / std::setprecision for the report table
+
+namespace {
+
+/** @brief Report labels, indexed by FramePacer::Metric. */
+constexpr const char *kMetricNames[FramePacer::kMetricCount] = {
+    "CPU frame", "Fence wait", "Acquire", "Present"};
+
+} // namespace
+
+/**
+ * @brief Create an empty monitor.
+ * @param hitchFactor Multiple of the rolling median above which a frame is a
+ * hitch
+ */
+FramePacer::FramePacer(double hitchFactor)
+    : hitchFactor(hitchFactor), frameStart(Clock::now()) {}
+
+/**
+ * @brief Start timing a frame and clear the per-frame wait times.
+ */
+void FramePacer::beginFrame() {
+  frameMs.fill(0.0);
+  touchedMetrics = 0;
+  frameStart = Clock::now();
+}
+
+/**
+ * @brief Add time to a metric of the current frame.
+ * @param metric Wait metric
+ * @param ms Duration in milliseconds
+ */
+void FramePacer::addTime(Metric metric, double ms) {
+  const size_t index = static_cast<size_t>(metric);
+  frameMs[index] += ms;
+  touchedMetrics |= 1u << index;
+}
+
+/**
+ * @brief Record the frame, timed since beginFrame().
+ * @return True if the frame was a hitch
+ */
+bool FramePacer::endFrame() { return endFrame(msSince(frameStart)); }
+
+/**
+ * @brief Record the frame and compare it against the rolling median.
+ * @param cpuMs CPU frame time in milliseconds
+ * @return True if the frame was a hitch
+ *
+ * @details The median is taken before the frame is added, so one slow frame
+ * cannot raise its own threshold. Detection starts after kWarmupFrames, when
+ * start-up frames (shader compilation, first uploads) no longer dominate.
+ */
+bool FramePacer::endFrame(double cpuMs) {
+  addTime(Metric::CpuFrame, cpuMs);
+
+  for (size_t i = 0; i < kMetricCount; ++i) {
+    if (touchedMetrics & (1u << i))
+      histograms[i].add(frameMs[i]);
+  }
+
+  bool hitch = false;
+  if (frames >= kWarmupFrames) {
+    const double medianMs = recentFrames.window(frames).quantile(0.5);
+    if (cpuMs > hitchFactor * medianMs) {
+      hitch = true;
+      ++hitches;
+      rememberHitch({frames, cpuMs, medianMs});
+    }
+  }
+
+  recentFrames.add(cpuMs, frames);
+  ++frames;
+  return hitch;
+}
+
+/**
+ * @brief Insert a hitch into the descending list of the worst ones.
+ * @param hitch Detected hitch
+ */
+void FramePacer::rememberHitch(const Hitch &hitch) {
+  size_t pos = worstCount;
+  while (pos > 0 && worst[pos - 1].ms < hitch.ms)
+    --pos;
+  if (pos >= kWorstHitches)
+    return;
+
+  const size_t last = std::min(worstCount, kWorstHitches - 1);
+  for (size_t i = last; i > pos; --i)
+    worst[i] = worst[i - 1];
+  worst[pos] = hitch;
+  worstCount = std::min(worstCount + 1, kWorstHitches);
+}
+
+/**
+ * @brief Print the pacing summary.
+ * @param out Destination stream
+ *
+ * @details Example:
+ * '''
+ * -- Frame Pacing (3600 frames) --
+ * Metric       Avg(ms)   p50(ms)   p99(ms)   p99.9(ms) Max(ms)
+ * CPU frame    16.67     16.64     17.92     33.10     41.37
+ * Fence wait   14.91     14.95     16.20     31.48     39.80
+ * Acquire      0.02      0.02      0.05      0.31      0.44
+ * Present      0.09      0.08      0.21      0.90      1.12
+ * Hitches (> 2.0x median): 3 (0.08%)
+ *   frame 1207: 41.37 ms (median 16.64 ms)
+ * '''
+ */
+void FramePacer::report(std::ostream &out) const {
+  const std::ios_base::fmtflags flags = out.flags();
+  const std::streamsize precision = out.precision();
+
+  out << "\n-- Frame Pacing (" << frames << " frames) --\n";
+  out << std::left << std::setw(13) << "Metric" << std::setw(10) << "Avg(ms)"
+      << std::setw(10) << "p50(ms)" << std::setw(10) << "p99(ms)"
+      << std::setw(10) << "p99.9(ms)" << "Max(ms)\n";
+
+  out << std::fixed << std::setprecision(2);
+  for (size_t i = 0; i < kMetricCount; ++i) {
+    const LogHistogram &h = histograms[i];
+    if (h.count() == 0)
+      continue;
+    out << std::setw(13) << kMetricNames[i] << std::setw(10) << h.mean()
+        << std::setw(10) << h.quantile(0.50) << std::setw(10)
+        << h.quantile(0.99) << std::setw(10) << h.quantile(0.999) << h.max()
+        << "\n";
+  }
+
+  const double rate =
+      frames ? 100.0 * static_cast<double>(hitches) / static_cast<double>(frames)
+             : 0.0;
+  out << std::setprecision(1) << "Hitches (> " << hitchFactor
+      << "x median): " << hitches << " (" << std::setprecision(2) << rate
+      << "%)\n";
+  for (size_t i = 0; i < worstCount; ++i) {
+    out << "  frame " << worst[i].frame << ": " << worst[i].ms << " ms (median "
+        << worst[i].medianMs << " ms)\n";
+  }
+  out << std::flush;
+
+  out.flags(flags); // The caller's std::left / std::fixed settings
+  out.precision(precision);
+}
@@ -0,0 +1,377 @@
+#if defined(PROFILER)
+
+#include "GpuProfiler.hpp"
+
+/**
+ * @file GpuProfiler.cpp
+ * @brief Implementation of GPU timestamp zones for ChronoProfiler.
+ *
+ * @details
+ * Every frame in flight records into its own query pool, which is reset at
+ * the start of that slot's command buffer. By the time the renderer waits on
+ * the slot's fence again, the previous submission of the slot has completed,
+ * so its timestamps are read with 'vkGetQueryPoolResults' and no wait flag.
+ *
+ * GPU ticks are converted to profiler ticks through an anchor pair
+ * (GPU timestamp, profiler tick) taken at the same instant:
+ *  - with VK_EXT_calibrated_timestamps the pair comes from
+ *    'vkGetCalibratedTimestampsEXT' (device + CLOCK_MONOTONIC), refreshed
+ *    every 'kCalibrationInterval' frames;
+ *  - otherwise the frame's first timestamp is paired with the CPU tick of its
+ *    submission. The anchor moves whenever a frame would otherwise appear to
+ *    start before it was submitted, and is refreshed periodically to follow
+ *    drift.
+ *
+ * @note This implementation uses:
+ *  - '<chrono>' to relate CLOCK_MONOTONIC to profiler ticks
+ *  - 'vulkan_raii.hpp' for query pools and calibrated timestamps
+ */
+
+#include <algorithm> ///< std::any_of over extensions and time domains
+#include <chrono>    ///< steady_clock (CLOCK_MONOTONIC on Linux)
+#include <cstring>   ///< strcmp on extension names
+#include <iostream>  ///< std::cerr when timestamps are unsupported
+
+namespace {
+
+/** @brief Marks a dropped zone on the open-zone stack. */
+constexpr uint32_t kNoZone = UINT32_MAX;
+
+/** @brief Name of the root zone spanning a whole command buffer. */
+constexpr std::string_view kFrameZoneName = "GPU Frame";
+
+/** @brief Color of the root zone. */
+constexpr uint32_t kFrameZoneColor = 0x76B900FF;
+
+} // namespace
+
+// ----------------- //
+// Setup             //
+// ----------------- //
+
+/**
+ * @brief Report the device extension needed for calibrated timestamps.
+ * @param physicalDevice Selected physical GPU
+ * @return Extension name, or nullptr when calibration is not possible
+ *
+ * @details The host time domain must be the clock behind
+ * 'std::chrono::steady_clock', which is CLOCK_MONOTONIC on Linux. Other
+ * platforms use submit anchoring.
+ */
+const char *
+GpuProfiler::calibrationExtension(const vk::raii::PhysicalDevice &physicalDevice) {
+#if defined(__linux__)
+  const auto extensions = physicalDevice.enumerateDeviceExtensionProperties();
+  const bool supported = std::any_of(
+      extensions.begin(), extensions.end(), [](auto const &ext) {
+        return strcmp(ext.extensionName,
+                      VK_EXT_CALIBRATED_TIMESTAMPS_EXTENSION_NAME) == 0;
+      });
+  if (!supported)
+    return nullptr;
+
+  const auto domains = physicalDevice.getCalibrateableTimeDomainsEXT();
+  auto hasDomain = [&domains](vk::TimeDomainEXT domain) {
+    return std::find(domains.begin(), domains.end(), domain) != domains.end();
+  };
+  if (hasDomain(vk::TimeDomainEXT::eDevice) &&
+      hasDomain(vk::TimeDomainEXT::eClockMonotonic)) {
+    return VK_EXT_CALIBRATED_TIMESTAMPS_EXTENSION_NAME;
+  }
+#else
+  (void)physicalDevice;
+#endif
+  return nullptr;
+}
+
+/**
+ * @brief Create the per-slot query pools and register the GPU track.
+ * @param physicalDevice Physical GPU the device was created from
+ * @param device Logical device
+ * @param queueFamilyIndex Queue family the frames are submitted to
+ * @param framesInFlight Number of frame slots
+ * @param calibrationEnabled Whether VK_EXT_calibrated_timestamps is enabled
+ */
+void GpuProfiler::init(const vk::raii::PhysicalDevice &physicalDevice,
+                       const vk::raii::Device &device,
+                       uint32_t queueFamilyIndex, uint32_t framesInFlight,
+                       bool calibrationEnabled) {
+  const auto families = physicalDevice.getQueueFamilyProperties();
+  const uint32_t validBits = families.at(queueFamilyIndex).timestampValidBits;
+  if (validBits == 0) {
+    std::cerr << "GpuProfiler: queue family " << queueFamilyIndex
+              << " does not support timestamps, GPU zones disabled"
+              << std::endl;
+    return;
+  }
+
+  this->device = &device;
+  gpuNsPerTick = physicalDevice.getProperties().limits.timestampPeriod;
+  validMask = validBits >= 64 ? ~0ull : (1ull << validBits) - 1;
+  calibrated = calibrationEnabled;
+  anchored = false;
+
+  slots.clear();
+  slots.resize(framesInFlight);
+  for (FrameSlot &slot : slots) {
+    slot.pool = vk::raii::QueryPool(
+        device, vk::QueryPoolCreateInfo({}, vk::QueryType::eTimestamp,
+                                        kMaxQueriesPerFrame));
+    slot.zones.reserve(kMaxQueriesPerFrame / 2);
+  }
+  results.resize(kMaxQueriesPerFrame);
+  events.reserve(kMaxQueriesPerFrame / 2);
+
+  frameNameId = ChronoProfiler::internString(kFrameZoneName, kFrameZoneColor);
+  categoryId = ChronoProfiler::internString("gpu");
+  ChronoProfiler::setThreadName(ChronoProfiler::kGpuThreadId, "GPU");
+
+  enabled = true;
+}
+
+// ----------------- //
+// Recording         //
+// ----------------- //
+
+/**
+ * @brief Reset the slot's queries and open the root frame zone.
+ * @param cmd Command buffer being recorded
+ * @param frameSlot Frame-in-flight index
+ *
+ * @details The whole pool is reset because the number of zones this frame
+ * will record is not known yet; resetting 64 queries is negligible.
+ */
+void GpuProfiler::beginFrame(const vk::raii::CommandBuffer &cmd,
+                             uint32_t frameSlot) {
+  if (!enabled)
+    return;
+
+  FrameSlot &slot = slots[frameSlot];
+  cmd.resetQueryPool(*slot.pool, 0, kMaxQueriesPerFrame);
+  slot.zones.clear();
+  slot.openCount = 0;
+  slot.pendingEnds = 0;
+  slot.queryCount = 0;
+  slot.submitted = false;
+  recording = &slot;
+
+  openZone(cmd, frameNameId);
+}
+
+/**
+ * @brief Close every zone still open, including the root frame zone.
+ * @param cmd Command buffer being recorded
+ */
+void GpuProfiler::endFrame(const vk::raii::CommandBuffer &cmd) {
+  if (!recording)
+    return;
+
+  while (recording->openCount > 0)
+    endZone(cmd);
+  recording = nullptr;
+}
+
+/**
+ * @brief Open a named zone.
+ * @param cmd Command buffer being recorded
+ * @param name Zone name
+ * @param color Zone color registered with a newly interned name
+ */
+void GpuProfiler::beginZone(const vk::raii::CommandBuffer &cmd,
+                            std::string_view name, uint32_t color) {
+  if (!recording)
+    return;
+  openZone(cmd, ChronoProfiler::internString(name, color));
+}
+
+/**
+ * @brief Write the begin timestamp of a zone.
+ * @param cmd Command buffer being recorded
+ * @param nameId Interned zone name
+ *
+ * @details A zone is only started if its begin query and the end queries of
+ * every open zone (itself included) still fit in the pool, so open zones can
+ * always be closed.
+ */
+void GpuProfiler::openZone(const vk::raii::CommandBuffer &cmd,
+                           uint16_t nameId) {
+  FrameSlot &slot = *recording;
+
+  uint32_t zoneIndex = kNoZone;
+  if (slot.openCount < kMaxZoneDepth &&
+      slot.queryCount + slot.pendingEnds + 2 <= kMaxQueriesPerFrame) {
+    zoneIndex = static_cast<uint32_t>(slot.zones.size());
+    slot.zones.push_back({slot.queryCount, kNoZone, nameId,
+                          static_cast<uint16_t>(slot.openCount)});
+    cmd.writeTimestamp(vk::PipelineStageFlagBits::eTopOfPipe, *slot.pool,
+                       slot.queryCount++);
+    ++slot.pendingEnds;
+  } else {
+    ++dropped;
+  }
+
+  if (slot.openCount < kMaxZoneDepth)
+    slot.openZones[slot.openCount] = zoneIndex;
+  ++slot.openCount; // Still track depth so ends stay balanced
+}
+
+/**
+ * @brief Write the end timestamp of the innermost open zone.
+ * @param cmd Command buffer being recorded
+ */
+void GpuProfiler::endZone(const vk::raii::CommandBuffer &cmd) {
+  if (!recording || recording->openCount == 0)
+    return;
+
+  FrameSlot &slot = *recording;
+  if (--slot.openCount >= kMaxZoneDepth)
+    return; // Start was dropped for exceeding the depth limit
+
+  const uint32_t zoneIndex = slot.openZones[slot.openCount];
+  if (zoneIndex == kNoZone)
+    return; // Start was dropped for lack of queries
+
+  slot.zones[zoneIndex].endQuery = slot.queryCount;
+  cmd.writeTimestamp(vk::PipelineStageFlagBits::eBottomOfPipe, *slot.pool,
+                     slot.queryCount++);
+  --slot.pendingEnds;
+}
+
+/**
+ * @brief Remember when the slot's command buffer was handed to the queue.
+ * @param frameSlot Frame-in-flight index
+ */
+void GpuProfiler::markSubmitted(uint32_t frameSlot) {
+  if (!enabled)
+    return;
+
+  FrameSlot &slot = slots[frameSlot];
+  slot.submitTicks = ChronoProfiler::nowTicks();
+  slot.submitted = slot.queryCount > 0;
+}
+
+// ----------------- //
+// Readback          //
+// ----------------- //
+
+/**
+ * @brief Read a completed slot's timestamps and forward them as events.
+ * @param frameSlot Frame-in-flight index whose fence has signalled
+ */
+void GpuProfiler::collect(uint32_t frameSlot) {
+  if (!enabled)
+    return;
+
+  FrameSlot &slot = slots[frameSlot];
+  if (!slot.submitted)
+    return;
+  slot.submitted = false;
+
+  // Raw call: the RAII wrapper returns a freshly allocated vector per call
+  const VkResult result = device->getDispatcher()->vkGetQueryPoolResults(
+      static_cast<VkDevice>(**device), static_cast<VkQueryPool>(*slot.pool), 0,
+      slot.queryCount, slot.queryCount * sizeof(uint64_t), results.data(),
+      sizeof(uint64_t), VK_QUERY_RESULT_64_BIT);
+  if (result != VK_SUCCESS)
+    return; // Not available (e.g. device lost); skip rather than wait
+
+  const uint64_t frameBegin = results[slot.zones.front().beginQuery] & validMask;
+  if (calibrated) {
+    if (!anchored || ++framesSinceAnchor >= kCalibrationInterval)
+      calibrate();
+  }
+  if (!calibrated) {
+    if (!anchored || ++framesSinceAnchor >= kCalibrationInterval ||
+        toProfilerTicks(frameBegin) < slot.submitTicks) {
+      anchorGpuTicks = frameBegin;
+      anchorCpuTicks = slot.submitTicks;
+      anchored = true;
+      framesSinceAnchor = 0;
+    }
+  }
+
+  events.clear();
+  for (const Zone &zone : slot.zones) {
+    if (zone.endQuery == kNoZone)
+      continue;
+
+    ChronoProfiler::Event evt{};
+    evt.startTicks = toProfilerTicks(results[zone.beginQuery] & validMask);
+    evt.endTicks = toProfilerTicks(results[zone.endQuery] & validMask);
+    evt.threadId = ChronoProfiler::kGpuThreadId;
+    evt.parentIndex = -1;
+    evt.nameId = zone.nameId;
+    evt.categoryId = categoryId;
+    evt.depth = zone.depth;
+    evt.flags = 0;
+    events.push_back(evt);
+  }
+
+  ChronoProfiler::submitEvents(events);
+}
+
+/**
+ * @brief Take a fresh (GPU, profiler) anchor from calibrated timestamps.
+ *
+ * @details The host sample is CLOCK_MONOTONIC nanoseconds. It is moved onto
+ * the profiler clock by reading steady_clock and nowTicks() back to back,
+ * which works for both TSC and steady_clock ticks. Falls back to submit
+ * anchoring if the call fails.
+ */
+void GpuProfiler::calibrate() {
+  using namespace std::chrono;
+
+  const std::array<vk::CalibratedTimestampInfoEXT, 2> infos = {
+      vk::CalibratedTimestampInfoEXT(vk::TimeDomainEXT::eDevice),
+      vk::CalibratedTimestampInfoEXT(vk::TimeDomainEXT::eClockMonotonic)};
+
+  // Raw call, as in collect(): the RAII wrapper allocates the result vector
+  std::array<uint64_t, 2> timestamps{};
+  uint64_t maxDeviation = 0;
+  const VkResult result = device->getDispatcher()->vkGetCalibratedTimestampsEXT(
+      static_cast<VkDevice>(**device), static_cast<uint32_t>(infos.size()),
+      reinterpret_cast<const VkCalibratedTimestampInfoEXT *>(infos.data()),
+      timestamps.data(), &maxDeviation);
+  if (result != VK_SUCCESS) {
+    std::cerr << "GpuProfiler: calibrated timestamps failed ("
+              << vk::to_string(static_cast<vk::Result>(result))
+              << "), anchoring to submissions instead" << std::endl;
+    calibrated = false;
+    return;
+  }
+
+  const uint64_t cpuNow = ChronoProfiler::nowTicks();
+  const int64_t hostNowNs =
+      duration_cast<nanoseconds>(steady_clock::now().time_since_epoch())
+          .count();
+  const double nsPerCpuTick = ChronoProfiler::getMsPerTick() * 1e6;
+  const int64_t hostAgoNs = hostNowNs - static_cast<int64_t>(timestamps[1]);
+
+  anchorGpuTicks = timestamps[0] & validMask;
+  anchorCpuTicks =
+      cpuNow - static_cast<uint64_t>(static_cast<double>(hostAgoNs) / nsPerCpuTick);
+  anchored = true;
+  framesSinceAnchor = 0;
+}
+
+/**
+ * @brief Convert a masked GPU timestamp to profiler ticks.
+ * @param gpuTicks Timestamp masked to the valid bits
+ * @return Profiler tick of the same instant
+ *
+ * @details Deltas are taken modulo the valid bits, so counters narrower than
+ * 64 bits that wrapped since the anchor still convert correctly.
+ */
+uint64_t GpuProfiler::toProfilerTicks(uint64_t gpuTicks) const {
+  int64_t delta = static_cast<int64_t>((gpuTicks - anchorGpuTicks) & validMask);
+  if (validMask != ~0ull && static_cast<uint64_t>(delta) > validMask / 2)
+    delta -= static_cast<int64_t>(validMask) + 1; // Before the anchor
+
+  const double cpuTicksPerGpuTick =
+      gpuNsPerTick / (ChronoProfiler::getMsPerTick() * 1e6);
+  return anchorCpuTicks +
+         static_cast<uint64_t>(static_cast<int64_t>(
+             static_cast<double>(delta) * cpuTicksPerGpuTick));
+}
+
+#endif // PROFILER
@@ -0,0 +1,314 @@
+#include "MeshCache.hpp"
+
+/**
+ * @file MeshCache.cpp
+ * @brief '.amesh' cache writing, validation and memory mapping.
+ */
+
+#include "Xxh64.hpp" ///< Content hash of the source
+
+#include <algorithm>  ///< std::min / std::max for the bounds
+#include <array>      ///< Header magic
+#include <chrono>     ///< Modification time in nanoseconds
+#include <cstdlib>    ///< mkstemp for the temporary file
+#include <cstddef>    ///< offsetof for the stamp refresh
+#include <cstring>    ///< std::memcpy / std::memcmp
+#include <filesystem> ///< Source size, modification time and atomic rename
+#include <fstream>    ///< Writing the cache
+#include <stdexcept>  ///< std::runtime_error on write failures
+
+#include <fcntl.h>    ///< ::open
+#include <sys/mman.h> ///< mmap / munmap / posix_madvise
+#include <sys/stat.h> ///< fstat / fchmod
+#include <unistd.h>   ///< close / pwrite
+
+namespace {
+
+/** @brief File signature at offset 0. */
+constexpr std::array<char, 8> kMagic = {'A', 'M', 'E', 'S', 'H', '\0', '\r', '\n'};
+
+/**
+ * @struct Header
+ * @brief On-disk header, followed by the vertex and index arrays.
+ */
+struct Header {
+  std::array<char, 8> magic;  ///< kMagic
+  uint32_t version;           ///< MeshCache::kVersion
+  uint32_t vertexStride;      ///< sizeof(Vertex) when written
+  uint64_t vertexCount;       ///< Number of Vertex records
+  uint64_t indexCount;        ///< Number of uint32_t indices
+  uint64_t sourceSize;        ///< Size of the source file in bytes
+  int64_t sourceMtimeNs;      ///< Source modification time (file clock, ns)
+  uint64_t sourceHash;        ///< XXH64 of the source file's contents
+  std::array<float, 3> boundsMin; ///< Smallest position components
+  std::array<float, 3> boundsMax; ///< Largest position components
+};
+
+static_assert(sizeof(Header) == 80, "Header layout is part of the file format");
+static_assert(sizeof(Header) % alignof(Vertex) == 0, "Vertices follow the header");
+static_assert(sizeof(Vertex) % alignof(uint32_t) == 0, "Indices follow the vertices");
+
+/** @brief Closes a file descriptor when leaving scope. */
+struct FileHandle {
+  int fd = -1;
+  explicit FileHandle(int fd) : fd(fd) {}
+  ~FileHandle() {
+    if (fd >= 0)
+      ::close(fd);
+  }
+  FileHandle(const FileHandle &) = delete;
+  FileHandle &operator=(const FileHandle &) = delete;
+};
+
+/**
+ * @brief XXH64 of a whole file, read through a temporary mapping.
+ * @param path File to hash
+ * @param hash Receives the hash
+ * @return False if the file cannot be opened or mapped
+ */
+bool hashFile(const std::string &path, uint64_t &hash) {
+  FileHandle file(::open(path.c_str(), O_RDONLY | O_CLOEXEC));
+  struct stat info {};
+  if (file.fd < 0 || ::fstat(file.fd, &info) != 0)
+    return false;
+
+  const auto size = static_cast<size_t>(info.st_size);
+  if (size == 0) {
+    hash = Xxh64::hash(nullptr, 0);
+    return true;
+  }
+
+  void *mapping = ::mmap(nullptr, size, PROT_READ, MAP_PRIVATE, file.fd, 0);
+  if (mapping == MAP_FAILED)
+    return false;
+  ::posix_madvise(mapping, size, POSIX_MADV_SEQUENTIAL);
+  hash = Xxh64::hash(mapping, size);
+  ::munmap(mapping, size);
+  return true;
+}
+
+} // namespace
+
+// ------------ //
+// Construction //
+// ------------ //
+
+/**
+ * @brief Adopt a read-only mapping of a cache file.
+ * @param mapping Base address returned by mmap
+ * @param size Length of the mapping
+ */
+MeshCache::MeshCache(void *mapping, size_t size)
+    : mapping(mapping), mappingSize(size) {}
+
+/**
+ * @brief Unmap the cache file.
+ */
+MeshCache::~MeshCache() {
+  if (mapping)
+    ::munmap(mapping, mappingSize);
+}
+
+/**
+ * @brief Source file size and modification time.
+ * @param sourcePath Source file
+ * @param stamp Receives the size and modification time ('hash' is zeroed)
+ * @return False if the file does not exist or cannot be inspected
+ */
+bool MeshCache::statSource(const std::string &sourcePath, SourceStamp &stamp) {
+  std::error_code ec;
+  stamp.size = std::filesystem::file_size(sourcePath, ec);
+  if (ec)
+    return false;
+  const auto mtime = std::filesystem::last_write_time(sourcePath, ec);
+  if (ec)
+    return false;
+  stamp.mtimeNs = std::chrono::duration_cast<std::chrono::nanoseconds>(
+                      mtime.time_since_epoch())
+                      .count();
+  stamp.hash = 0;
+  return true;
+}
+
+/**
+ * @brief Hash a whole source file.
+ * @param sourcePath Source file
+ * @param hash Receives its XXH64
+ * @return False if the file cannot be read
+ */
+bool MeshCache::hashSource(const std::string &sourcePath, uint64_t &hash) {
+  return hashFile(sourcePath, hash);
+}
+
+/**
+ * @brief Replace a source path's extension with '.amesh'.
+ * @param sourcePath Source mesh path
+ * @return Cache path next to the source
+ */
+std::string MeshCache::cachePathFor(const std::string &sourcePath) {
+  return std::filesystem::path(sourcePath).replace_extension(".amesh").string();
+}
+
+// ------- //
+// Loading //
+// ------- //
+
+/**
+ * @brief Map a cache and check it against its source.
+ * @param cachePath '.amesh' file
+ * @param sourcePath Mesh the cache was built from
+ * @return Mapped cache, or nullptr when it cannot be used
+ *
+ * @details The header must carry the current magic, version and Vertex
+ * stride, the file size must match the array sizes exactly, and every index
+ * must be below the vertex count (one pass over the indices, which also
+ * faults them in ahead of the upload). If the source
+ * still exists, an equal size and modification time accept the cache without
+ * reading the source; a different modification time (e.g. after a checkout)
+ * hashes the source and accepts the cache only if the content is unchanged,
+ * then refreshes the stored time so the next launch takes the fast path. A
+ * missing source leaves the cache as the only copy of the mesh, so it is used.
+ */
+std::unique_ptr<MeshCache> MeshCache::open(const std::string &cachePath,
+                                           const std::string &sourcePath) {
+  FileHandle file(::open(cachePath.c_str(), O_RDONLY | O_CLOEXEC));
+  struct stat info {};
+  if (file.fd < 0 || ::fstat(file.fd, &info) != 0)
+    return nullptr;
+
+  const auto size = static_cast<size_t>(info.st_size);
+  if (size < sizeof(Header))
+    return nullptr;
+
+  void *mapping = ::mmap(nullptr, size, PROT_READ, MAP_PRIVATE, file.fd, 0);
+  if (mapping == MAP_FAILED)
+    return nullptr;
+  std::unique_ptr<MeshCache> cache(new MeshCache(mapping, size));
+
+  Header header;
+  std::memcpy(&header, mapping, sizeof(header));
+  if (header.magic != kMagic || header.version != kVersion ||
+      header.vertexStride != sizeof(Vertex))
+    return nullptr;
+
+  // Exact size check, written to rule out overflow in the products
+  const size_t payload = size - sizeof(Header);
+  if (header.vertexCount > payload / sizeof(Vertex) ||
+      header.indexCount != (payload - header.vertexCount * sizeof(Vertex)) /
+                               sizeof(uint32_t) ||
+      (payload - header.vertexCount * sizeof(Vertex)) % sizeof(uint32_t) != 0)
+    return nullptr;
+
+  const auto *bytes = static_cast<const unsigned char *>(mapping);
+  const auto *vertexData =
+      reinterpret_cast<const Vertex *>(bytes + sizeof(Header));
+  const auto *indexData = reinterpret_cast<const uint32_t *>(
+      bytes + sizeof(Header) + header.vertexCount * sizeof(Vertex));
+
+  // Every index must address a cached vertex (branch-free, so it vectorizes)
+  uint32_t maxIndex = 0;
+  for (size_t i = 0; i < header.indexCount; ++i)
+    maxIndex = std::max(maxIndex, indexData[i]);
+  if (header.indexCount > 0 && maxIndex >= header.vertexCount)
+    return nullptr;
+
+  SourceStamp source;
+  if (statSource(sourcePath, source)) {
+    if (source.size != header.sourceSize)
+      return nullptr;
+    if (source.mtimeNs != header.sourceMtimeNs) {
+      uint64_t sourceHash = 0;
+      if (!hashFile(sourcePath, sourceHash) || sourceHash != header.sourceHash)
+        return nullptr;
+
+      // Content unchanged: refresh the stamp (best effort)
+      FileHandle update(::open(cachePath.c_str(), O_WRONLY | O_CLOEXEC));
+      if (update.fd >= 0) {
+        [[maybe_unused]] ssize_t written =
+            ::pwrite(update.fd, &source.mtimeNs, sizeof(source.mtimeNs),
+                     offsetof(Header, sourceMtimeNs));
+      }
+    }
+  }
+
+  ::posix_madvise(mapping, size, POSIX_MADV_WILLNEED);
+
+  cache->vertexSpan = {vertexData, static_cast<size_t>(header.vertexCount)};
+  cache->indexSpan = {indexData, static_cast<size_t>(header.indexCount)};
+  cache->meshBounds.min = {header.boundsMin[0], header.boundsMin[1],
+                           header.boundsMin[2]};
+  cache->meshBounds.max = {header.boundsMax[0], header.boundsMax[1],
+                           header.boundsMax[2]};
+  return cache;
+}
+
+// ------- //
+// Writing //
+// ------- //
+
+/**
+ * @brief Write a cache atomically (unique temporary file, then rename).
+ * @param cachePath '.amesh' file to create or replace
+ * @param source Stamp of the source taken before the import
+ * @param vertices Deduplicated vertices
+ * @param indices Index buffer
+ * @throws std::runtime_error if the cache cannot be written
+ */
+void MeshCache::write(const std::string &cachePath, const SourceStamp &source,
+                      std::span<const Vertex> vertices,
+                      std::span<const uint32_t> indices) {
+  Header header{};
+  header.magic = kMagic;
+  header.version = kVersion;
+  header.vertexStride = sizeof(Vertex);
+  header.vertexCount = vertices.size();
+  header.indexCount = indices.size();
+  header.sourceSize = source.size;
+  header.sourceMtimeNs = source.mtimeNs;
+  header.sourceHash = source.hash;
+
+  if (!vertices.empty()) {
+    const glm::vec3 first = vertices[0].position;
+    header.boundsMin = {first.x, first.y, first.z};
+    header.boundsMax = header.boundsMin;
+  }
+  for (const Vertex &vertex : vertices) {
+    const float p[3] = {vertex.position.x, vertex.position.y,
+                        vertex.position.z};
+    for (int axis = 0; axis < 3; ++axis) {
+      header.boundsMin[axis] = std::min(header.boundsMin[axis], p[axis]);
+      header.boundsMax[axis] = std::max(header.boundsMax[axis], p[axis]);
+    }
+  }
+
+  // A unique name next to the cache, so concurrent writers of the same cache
+  // (two instances importing one model) never share a temporary file
+  std::string tempPath = cachePath + ".XXXXXX";
+  {
+    const FileHandle temp(::mkstemp(tempPath.data()));
+    if (temp.fd < 0)
+      throw std::runtime_error("Failed to create mesh cache: " + tempPath);
+    ::fchmod(temp.fd, 0644); // mkstemp() makes the file private to its owner
+  }
+  {
+    std::ofstream out(tempPath, std::ios::binary | std::ios::trunc);
+    out.write(reinterpret_cast<const char *>(&header), sizeof(header));
+    out.write(reinterpret_cast<const char *>(vertices.data()),
+              static_cast<std::streamsize>(vertices.size_bytes()));
+    out.write(reinterpret_cast<const char *>(indices.data()),
+              static_cast<std::streamsize>(indices.size_bytes()));
+    out.close();
+    if (!out) {
+      std::error_code ignored;
+      std::filesystem::remove(tempPath, ignored);
+      throw std::runtime_error("Failed to write mesh cache: " + tempPath);
+    }
+  }
+
+  std::error_code ec;
+  std::filesystem::rename(tempPath, cachePath, ec);
+  if (ec) {
+    std::filesystem::remove(tempPath, ec);
+    throw std::runtime_error("Failed to replace mesh cache: " + cachePath);
+  }
+}
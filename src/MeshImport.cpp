@@ -0,0 +1,206 @@
+#include "MeshImport.hpp"
+
+/**
+ * @file MeshImport.cpp
+ * @brief Worker pool and chunk merging for parallel vertex deduplication.
+ */
+
+#include <algorithm> ///< std::min for the chunk count
+
+namespace meshimport {
+
+/**
+ * @brief Resolve a thread limit.
+ * @param threadCount Thread limit (0 = hardware concurrency)
+ * @return Thread count, at least 1
+ */
+unsigned resolveThreadCount(unsigned threadCount) {
+  if (threadCount == 0)
+    threadCount = std::thread::hardware_concurrency();
+  return std::max(1u, threadCount);
+}
+
+/**
+ * @brief Number of chunks to split a corner stream into.
+ * @param cornerCount Number of corners in the stream
+ * @param threadCount Thread limit (0 = hardware concurrency)
+ * @return Chunk count in [1, threads]
+ */
+size_t chunkCountFor(size_t cornerCount, unsigned threadCount) {
+  const size_t byWork = std::max<size_t>(1, cornerCount / kMinCornersPerChunk);
+  return std::min<size_t>(resolveThreadCount(threadCount), byWork);
+}
+
+// ----------- //
+// Worker pool //
+// ----------- //
+
+/**
+ * @brief Start the workers.
+ * @param threadCount Threads taking part in 'run()', including the caller
+ */
+WorkerPool::WorkerPool(unsigned threadCount) {
+  workers.reserve(threadCount > 1 ? threadCount - 1 : 0);
+  for (unsigned i = 1; i < threadCount; ++i)
+    workers.emplace_back(&WorkerPool::work, this);
+}
+
+/**
+ * @brief Wake every worker with the stop flag set and join them.
+ */
+WorkerPool::~WorkerPool() {
+  {
+    std::lock_guard lock(mutex);
+    stopping = true;
+  }
+  wake.notify_all();
+  for (std::thread &worker : workers)
+    worker.join();
+}
+
+/**
+ * @brief Run 'count' tasks on the pool and wait for all of them.
+ * @param count Number of tasks
+ * @param task Work to run, given the task index
+ *
+ * @details The calling thread claims tasks too. An exception thrown by a task
+ * is captured and the lowest-index one is rethrown once every worker has left
+ * the run, so 'task' is never referenced after this returns.
+ */
+void WorkerPool::run(size_t count, const std::function<void(size_t)> &task) {
+  if (count == 0)
+    return;
+
+  {
+    std::lock_guard lock(mutex);
+    this->task = &task;
+    taskCount = count;
+    nextTask.store(0, std::memory_order_relaxed);
+    errors.assign(count, nullptr);
+    activeWorkers = workers.size();
+    ++generation;
+  }
+  wake.notify_all();
+
+  runTasks();
+
+  std::unique_lock lock(mutex);
+  finished.wait(lock, [&] { return activeWorkers == 0; });
+  this->task = nullptr;
+
+  for (const std::exception_ptr &error : errors) {
+    if (error)
+      std::rethrow_exception(error);
+  }
+}
+
+/**
+ * @brief Sleep until a run starts, help with it, repeat until stopped.
+ */
+void WorkerPool::work() {
+  uint64_t seen = 0;
+  for (;;) {
+    {
+      std::unique_lock lock(mutex);
+      wake.wait(lock, [&] { return stopping || generation != seen; });
+      if (stopping)
+        return;
+      seen = generation;
+    }
+
+    runTasks();
+
+    std::lock_guard lock(mutex);
+    if (--activeWorkers == 0)
+      finished.notify_one();
+  }
+}
+
+/**
+ * @brief Claim task indices until the current run has none left.
+ *
+ * @details 'task', 'taskCount' and 'errors' are only written by 'run()' while
+ * no thread is inside a run, and published through the mutex.
+ */
+void WorkerPool::runTasks() {
+  for (;;) {
+    const size_t i = nextTask.fetch_add(1, std::memory_order_relaxed);
+    if (i >= taskCount)
+      return;
+    try {
+      (*task)(i);
+    } catch (...) {
+      errors[i] = std::current_exception();
+    }
+  }
+}
+
+// ------------ //
+// Deduplicator //
+// ------------ //
+
+/**
+ * @brief Start an empty mesh.
+ * @param vertices Receives the unique vertices
+ * @param indices Receives one index per corner
+ * @param expectedVertices Unique vertex count to size the table for
+ * @param threadCount Thread limit (0 = hardware concurrency)
+ */
+Deduplicator::Deduplicator(std::vector<Vertex> &vertices,
+                           std::vector<uint32_t> &indices,
+                           size_t expectedVertices, unsigned threadCount)
+    : indices(indices), table(vertices, expectedVertices),
+      threadCount(resolveThreadCount(threadCount)) {
+  vertices.clear(); // The table only indexes what it appends itself
+  indices.clear();
+}
+
+/**
+ * @brief Hash a chunk's unique vertices and resolve those already indexed.
+ * @param chunk Chunk whose 'vertices' were just filled
+ *
+ * @details Runs concurrently for every chunk while 'table' is only read, so
+ * the serial merge neither hashes nor probes for vertices of earlier batches.
+ */
+void Deduplicator::findKnown(Chunk &chunk) const {
+  const size_t count = chunk.vertices.size();
+  chunk.hashes.resize(count);
+  chunk.remap.resize(count);
+
+  for (size_t j = 0; j < count; ++j) {
+    const uint64_t hash = vertexHash64(chunk.vertices[j]);
+    chunk.hashes[j] = hash;
+    chunk.remap[j] = table.find(chunk.vertices[j], hash);
+  }
+}
+
+/**
+ * @brief Merge chunk-local vertices in stream order and remap the indices.
+ * @param chunkCount Number of chunks used by the batch
+ * @param chunkBegins First corner of each chunk, plus the batch corner count
+ * @param base Position of the batch's first corner in 'indices'
+ *
+ * @details The merge is serial so global indices follow first occurrence
+ * across the whole stream. It only inserts the chunk-local vertices that
+ * findKnown() did not resolve, reusing their hashes. Remapping the corners is
+ * the expensive half and runs on the pool.
+ */
+void Deduplicator::mergeChunks(size_t chunkCount,
+                               std::span<const size_t> chunkBegins,
+                               size_t base) {
+  for (size_t c = 0; c < chunkCount; ++c) {
+    Chunk &chunk = chunks[c];
+    for (size_t j = 0; j < chunk.vertices.size(); ++j) {
+      if (chunk.remap[j] == VertexDedupTable::kEmpty)
+        chunk.remap[j] = table.insert(chunk.vertices[j], chunk.hashes[j]).first;
+    }
+  }
+
+  pool->run(chunkCount, [&](size_t c) {
+    const std::vector<uint32_t> &chunkRemap = chunks[c].remap;
+    for (size_t i = base + chunkBegins[c]; i < base + chunkBegins[c + 1]; ++i)
+      indices[i] = chunkRemap[indices[i]];
+  });
+}
+
+} // namespace meshimport
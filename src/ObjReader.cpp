@@ -0,0 +1,375 @@
+#include "ObjReader.hpp"
+
+/**
+ * @file ObjReader.cpp
+ * @brief Chunked OBJ parsing on a producer thread feeding incremental
+ *        deduplication.
+ */
+
+#include "MeshImport.hpp" ///< meshimport::Deduplicator for the batches
+#include "Xxh64.hpp"      ///< Hash of the bytes read, for the mesh cache
+
+#include <algorithm>          ///< std::max for the batch size
+#include <condition_variable> ///< Blocking hand-off between the two threads
+#include <cstdlib>            ///< std::strtof / std::strtol
+#include <cstring>            ///< std::memchr / std::memmove
+#include <deque>              ///< Batches waiting for deduplication
+#include <exception>          ///< std::exception_ptr to forward parse errors
+#include <fstream>            ///< Reading the OBJ file
+#include <mutex>              ///< Guards the batch queue
+#include <stdexcept>          ///< std::runtime_error on malformed input
+#include <thread>             ///< Parser thread
+
+namespace {
+
+/** @brief Rough OBJ bytes per unique vertex, for presizing the dedup table. */
+constexpr size_t kObjBytesPerVertex = 96;
+
+/**
+ * @class BatchQueue
+ * @brief Bounded hand-off of corner batches from the parser to deduplication.
+ *
+ * Emptied batches go back through recycle() and are handed out again by
+ * acquire(), so the parser reuses their allocations.
+ */
+class BatchQueue {
+public:
+  /**
+   * @param depth Batches that may wait before push() blocks.
+   * @param batchCorners Capacity of each batch.
+   */
+  BatchQueue(size_t depth, size_t batchCorners)
+      : depth(depth), batchCorners(batchCorners) {}
+
+  /** @brief Capacity of each batch, in corners. */
+  size_t batchCapacity() const { return batchCorners; }
+
+  /**
+   * @brief Queues a batch, blocking while the queue is full.
+   * @return False if the queue was closed; the batch is dropped.
+   */
+  bool push(std::vector<Vertex> &&batch) {
+    std::unique_lock lock(mutex);
+    notFull.wait(lock, [&] { return closed || ready.size() < depth; });
+    if (closed)
+      return false;
+    ready.push_back(std::move(batch));
+    notEmpty.notify_one();
+    return true;
+  }
+
+  /**
+   * @brief Takes the oldest batch, blocking while the queue is empty.
+   * @return False once the queue is closed and drained.
+   */
+  bool pop(std::vector<Vertex> &batch) {
+    std::unique_lock lock(mutex);
+    notEmpty.wait(lock, [&] { return closed || !ready.empty(); });
+    if (ready.empty())
+      return false;
+    batch = std::move(ready.front());
+    ready.pop_front();
+    notFull.notify_one();
+    return true;
+  }
+
+  /** @brief Wakes both sides; pushes now fail, pops drain what is left. */
+  void close() {
+    std::lock_guard lock(mutex);
+    closed = true;
+    notFull.notify_all();
+    notEmpty.notify_all();
+  }
+
+  /** @brief Returns a consumed batch for reuse. */
+  void recycle(std::vector<Vertex> &&batch) {
+    batch.clear();
+    std::lock_guard lock(mutex);
+    spare.push_back(std::move(batch));
+  }
+
+  /** @brief An empty batch, reusing a recycled allocation when there is one. */
+  std::vector<Vertex> acquire() {
+    {
+      std::lock_guard lock(mutex);
+      if (!spare.empty()) {
+        std::vector<Vertex> batch = std::move(spare.back());
+        spare.pop_back();
+        return batch;
+      }
+    }
+    std::vector<Vertex> batch;
+    batch.reserve(batchCorners);
+    return batch;
+  }
+
+private:
+  const size_t depth;                        ///< Capacity of 'ready'
+  const size_t batchCorners;                 ///< Capacity of each batch
+  std::mutex mutex;                          ///< Guards every member below
+  std::condition_variable notFull;           ///< Signalled when 'ready' shrinks
+  std::condition_variable notEmpty;          ///< Signalled when 'ready' grows
+  std::deque<std::vector<Vertex>> ready;     ///< Batches awaiting deduplication
+  std::vector<std::vector<Vertex>> spare;    ///< Recycled, empty batches
+  bool closed = false;                       ///< Set by close()
+};
+
+/** @brief Space or tab (and '\r' from CRLF files). */
+bool isBlank(char c) { return c == ' ' || c == '\t' || c == '\r'; }
+
+/** @brief Skips blanks. */
+const char *skipBlanks(const char *p) {
+  while (isBlank(*p))
+    ++p;
+  return p;
+}
+
+/**
+ * @class ObjParser
+ * @brief Parses an OBJ stream line by line into triangulated corner batches.
+ */
+class ObjParser {
+public:
+  ObjParser(const std::string &path, std::ifstream &file, BatchQueue &queue,
+            Xxh64 *hasher)
+      : path(path), file(file), queue(queue), hasher(hasher),
+        batch(queue.acquire()) {}
+
+  /**
+   * @brief Parses the whole file, queueing corners as batches fill.
+   * @throws std::runtime_error on read errors or malformed lines
+   */
+  void run() {
+    // One spare byte so the last line can always be NUL-terminated
+    std::vector<char> buffer(meshimport::kObjReadBytes + 1);
+    size_t carry = 0; // Bytes of an unfinished line at the front of 'buffer'
+
+    while (!stopped) {
+      // A line longer than the buffer: grow until it fits
+      if (carry == buffer.size() - 1)
+        buffer.resize(2 * buffer.size() - 1);
+
+      file.read(buffer.data() + carry,
+                static_cast<std::streamsize>(buffer.size() - 1 - carry));
+      if (file.bad())
+        throw std::runtime_error("Failed to read OBJ file: " + path);
+      const size_t end = carry + static_cast<size_t>(file.gcount());
+      const bool atEnd = file.eof();
+      if (hasher) // Before parsing, which overwrites the newlines
+        hasher->update(buffer.data() + carry, end - carry);
+
+      char *line = buffer.data();
+      char *const stop = buffer.data() + end;
+      while (char *newline = static_cast<char *>(
+                 std::memchr(line, '\n', static_cast<size_t>(stop - line)))) {
+        *newline = '\0';
+        parseLine(line);
+        line = newline + 1;
+      }
+
+      carry = static_cast<size_t>(stop - line);
+      if (atEnd) {
+        *stop = '\0'; // Last line without a newline
+        if (carry > 0)
+          parseLine(line);
+        break;
+      }
+      std::memmove(buffer.data(), line, carry);
+    }
+
+    if (!stopped && !batch.empty())
+      queue.push(std::move(batch));
+  }
+
+private:
+  /** @brief Throws with the file and line number prepended. */
+  [[noreturn]] void fail(const char *what) const {
+    throw std::runtime_error(path + ":" + std::to_string(lineNumber) + ": " +
+                             what);
+  }
+
+  /** @brief Parses one NUL-terminated line. */
+  void parseLine(const char *line) {
+    ++lineNumber;
+    const char *p = skipBlanks(line);
+
+    if (p[0] == 'v' && isBlank(p[1])) {
+      p += 2;
+      const float x = parseFloat(p);
+      const float y = parseFloat(p);
+      const float z = parseFloat(p);
+      positions.push_back({x, y, z});
+    } else if (p[0] == 'v' && p[1] == 't' && isBlank(p[2])) {
+      p += 3;
+      const float u = parseFloat(p);
+      const float v = parseFloat(p);
+      texCoords.push_back({u, 1.0f - v}); // Flip V to match Vulkan
+    } else if (p[0] == 'f' && isBlank(p[1])) {
+      parseFace(p + 2);
+    }
+    // Normals, groups, materials and comments are not used by the renderer
+  }
+
+  /** @brief Parses the next number on the line and advances past it. */
+  float parseFloat(const char *&p) {
+    char *end = nullptr;
+    const float value = std::strtof(p, &end);
+    if (end == p)
+      fail("expected a number");
+    p = end;
+    return value;
+  }
+
+  /** @brief Parses the next integer of a face corner and advances past it. */
+  long parseIndex(const char *&p) {
+    if (isBlank(*p)) // strtol would skip to the next corner ('1/ 2')
+      fail("expected a face index");
+    char *end = nullptr;
+    const long value = std::strtol(p, &end, 10);
+    if (end == p)
+      fail("expected a face index");
+    p = end;
+    return value;
+  }
+
+  /**
+   * @brief Turns a 1-based or negative (relative) OBJ index into an offset.
+   * @param index Index as written in the file
+   * @param count Elements defined so far
+   */
+  size_t resolve(long index, size_t count) const {
+    if (index > 0 && static_cast<size_t>(index) <= count)
+      return static_cast<size_t>(index) - 1;
+    if (index < 0 && static_cast<size_t>(-index) <= count)
+      return count - static_cast<size_t>(-index);
+    fail("face index out of range");
+  }
+
+  /** @brief Parses an 'f' line and appends its triangle fan to the batch. */
+  void parseFace(const char *p) {
+    polygon.clear();
+    for (p = skipBlanks(p); *p != '\0'; p = skipBlanks(p)) {
+      const size_t position = resolve(parseIndex(p), positions.size());
+      glm::vec2 texCoord{0.0f, 1.0f}; // As for 'vt 0 0', V flipped
+
+      if (*p == '/') {
+        ++p;
+        if (*p != '/')
+          texCoord = texCoords[resolve(parseIndex(p), texCoords.size())];
+        if (*p == '/') {
+          ++p;
+          parseIndex(p); // Normal index, unused
+        }
+      }
+      if (*p != '\0' && !isBlank(*p))
+        fail("malformed face corner");
+
+      Vertex vertex{};
+      vertex.position = positions[position];
+      vertex.texCoord = texCoord;
+      vertex.color = {1.0f, 1.0f, 1.0f}; // Default white vertex color
+      polygon.push_back(vertex);
+    }
+    if (polygon.size() < 3)
+      fail("face with fewer than three corners");
+
+    // Hand the batch over before this face would overflow its allocation
+    const size_t corners = 3 * (polygon.size() - 2);
+    if (!batch.empty() &&
+        batch.size() + corners > queue.batchCapacity()) {
+      // A closed queue means deduplication failed; stop reading
+      if (!queue.push(std::move(batch)))
+        stopped = true;
+      batch = queue.acquire();
+    }
+
+    for (size_t k = 1; k + 1 < polygon.size(); ++k) {
+      batch.push_back(polygon[0]);
+      batch.push_back(polygon[k]);
+      batch.push_back(polygon[k + 1]);
+    }
+  }
+
+  const std::string &path;          ///< For error messages
+  std::ifstream &file;              ///< Source being read
+  BatchQueue &queue;                ///< Destination of full batches
+  Xxh64 *hasher;                    ///< Fed every byte read, if not null
+  std::vector<glm::vec3> positions; ///< 'v' records read so far
+  std::vector<glm::vec2> texCoords; ///< 'vt' records read so far, V flipped
+  std::vector<Vertex> polygon;      ///< Corners of the current face
+  std::vector<Vertex> batch;        ///< Triangulated corners being filled
+  size_t lineNumber = 0;            ///< Line being parsed (1-based)
+  bool stopped = false;             ///< Set when the consumer has gone away
+};
+
+} // namespace
+
+namespace meshimport {
+
+/**
+ * @brief Corners per batch for a deduplication thread count.
+ * @param threadCount Thread limit (0 = hardware concurrency)
+ * @return Batch capacity in corners
+ */
+size_t objBatchCorners(unsigned threadCount) {
+  return std::max(kObjBatchCorners,
+                  resolveThreadCount(threadCount) * kMinCornersPerChunk);
+}
+
+/**
+ * @brief Stream an OBJ file through a parser thread into deduplication.
+ * @param path Path of the '.obj' file
+ * @param vertices Receives the unique vertices
+ * @param indices Receives three indices per triangle
+ * @param threadCount Deduplication thread limit (0 = hardware concurrency)
+ * @param contentHash Receives the XXH64 of the file if not null
+ *
+ * @details The parser thread fills batches; this thread deduplicates them in
+ * file order, so the output matches a single pass over the whole file. If
+ * either side fails, the queue is closed so the other stops, the parser is
+ * joined, and the error is rethrown here.
+ */
+void importObj(const std::string &path, std::vector<Vertex> &vertices,
+               std::vector<uint32_t> &indices, unsigned threadCount,
+               uint64_t *contentHash) {
+  std::ifstream file(path, std::ios::binary | std::ios::ate);
+  if (!file)
+    throw std::runtime_error("Failed to open OBJ file: " + path);
+  const auto fileSize = static_cast<size_t>(file.tellg());
+  file.seekg(0);
+
+  BatchQueue queue(kObjQueueDepth, objBatchCorners(threadCount));
+  std::exception_ptr parseError;
+  Xxh64 hasher;
+  std::thread parser([&] {
+    try {
+      ObjParser(path, file, queue, contentHash ? &hasher : nullptr).run();
+    } catch (...) {
+      parseError = std::current_exception();
+    }
+    queue.close();
+  });
+
+  try {
+    Deduplicator deduplicator(vertices, indices, fileSize / kObjBytesPerVertex,
+                              threadCount);
+    std::vector<Vertex> batch;
+    while (queue.pop(batch)) {
+      deduplicator.append(batch.size(),
+                          [&](size_t corner) { return batch[corner]; });
+      queue.recycle(std::move(batch));
+    }
+  } catch (...) {
+    queue.close();
+    parser.join();
+    throw;
+  }
+
+  parser.join();
+  if (parseError)
+    std::rethrow_exception(parseError);
+  if (contentHash)
+    *contentHash = hasher.digest();
+}
+
+} // namespace meshimport
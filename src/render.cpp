@@ -11,13 +11,6 @@
 #define STB_IMAGE_IMPLEMENTATION
 #include <stb/stb_image.h>
 
-#define TINYOBJLOADER_IMPLEMENTATION
-#if __has_include(<tiny_obj_loader.h>)
-#include <tiny_obj_loader.h>
-#else
-#include "../external/tinyobjloader/tiny_obj_loader.h"
-#endif
-
 #include "../include/render.hpp"
 
 /**
@@ -25,19 +18,21 @@
  *
  * This is the primary entry point for the renderer. It performs the following
  * steps:
- * 1. Initializes the GLFW window.
- * 2. Initializes Vulkan, including instance, device, swap chain, and
+ * 1. Calibrates the profiler clock.
+ * 2. Initializes the GLFW window.
+ * 3. Initializes Vulkan, including instance, device, swap chain, and
  * pipelines.
- * 3. Enters the main render loop.
- * 4. Cleans up all Vulkan and GLFW resources when finished.
+ * 4. Enters the main render loop.
+ * 5. Cleans up all Vulkan and GLFW resources when finished.
  *
  * @throws std::runtime_error if any Vulkan or GLFW initialization fails.
  */
 void VulkanRenderer::run() {
-  initWindow(); // Create GLFW window + surface
-  initVulkan(); // Initialize Vulkan instance, device, swapchain, pipelines
-  mainLoop();   // Enter rendering loop until window closes
-  cleanup();    // Destroy all Vulkan + GLFW resources
+  ChronoProfiler::init(); // Calibrate the profiler clock before any frame
+  initWindow();           // Create GLFW window + surface
+  initVulkan();           // Initialize Vulkan instance, device, swapchain, pipelines
+  mainLoop();             // Enter rendering loop until window closes
+  cleanup();              // Destroy all Vulkan + GLFW resources
 }
 
 /**
@@ -126,57 +121,50 @@ vk::SampleCountFlagBits VulkanRenderer::getMaxUsableSampleCount() {
  * @brief Loads a 3D model from an OBJ file into vertex and index buffers.
  *
  * @details
- * Uses TinyOBJLoader to parse the OBJ file.
- * The function:
- * - Reads vertex positions and texture coordinates
+ * First tries the binary cache next to the model (see MeshCache). A valid
+ * cache is mapped and 'modelVertices'/'modelIndices' point straight into it.
+ *
+ * Otherwise streams the OBJ file through meshimport::importObj(), which:
+ * - Reads vertex positions and texture coordinates in fixed-size chunks
  * - Flips the Y-axis of texture coordinates to match Vulkan convention
  * - Assigns a default vertex color
- * - Builds a map of unique vertices to avoid duplicates
+ * - Deduplicates each batch of corners in parallel while the next is parsed
  * - Fills the 'vertices' and 'indices' vectors for use in Vulkan buffers
  *
+ * and then writes the '.amesh' cache for the next launch.
+ *
  * @throws std::runtime_error If the OBJ file cannot be loaded or parsed.
  *
  * @note Vulkan expects a single contiguous vertex buffer and an index buffer
  * for drawing, which is why duplicate vertices are eliminated.
  */
 void VulkanRenderer::loadModel() {
-  tinyobj::attrib_t attrib;
-  std::vector<tinyobj::shape_t> shapes;
-  std::vector<tinyobj::material_t> materials;
-  std::string warn, err;
-
-  // Parses OBJ file from disk
-  if (!LoadObj(&attrib, &shapes, &materials, &warn, &err, MODEL_PATH.c_str())) {
-    throw std::runtime_error(warn + err);
+  const std::string cachePath = MeshCache::cachePathFor(MODEL_PATH);
+  if ((meshCache = MeshCache::open(cachePath, MODEL_PATH))) {
+    modelVertices = meshCache->vertices();
+    modelIndices = meshCache->indices();
+    return;
   }
 
-  std::unordered_map<Vertex, uint32_t> uniqueVertices{}; // Avoid duplicates
+  // Stamp the source before reading it, so an edit made during the import
+  // leaves a cache that the next launch rejects
+  MeshCache::SourceStamp stamp;
+  const bool stamped = MeshCache::statSource(MODEL_PATH, stamp);
 
-  // Iterate over meshes / faces
-  for (const auto &shape : shapes) {
-    for (const auto &index : shape.mesh.indices) {
+  // Parse in chunks on a helper thread while this one deduplicates; the
+  // result matches a serial pass over the whole file exactly. The parser
+  // also hashes the bytes it reads for the cache stamp
+  meshimport::importObj(MODEL_PATH, vertices, indices, 0, &stamp.hash);
+  modelVertices = vertices;
+  modelIndices = indices;
 
-      Vertex vertex{};
-      // Extract vertex position from indexed OBJ arrays
-      vertex.position = {attrib.vertices[3 * index.vertex_index + 0],
-                         attrib.vertices[3 * index.vertex_index + 1],
-                         attrib.vertices[3 * index.vertex_index + 2]};
-
-      // Extract texture coordinates (flip Y axis for Vulkan)
-      vertex.texCoord = {attrib.texcoords[2 * index.texcoord_index + 0],
-                         1.0f - attrib.texcoords[2 * index.texcoord_index + 1]};
-
-      vertex.color = {1.0f, 1.0f, 1.0f}; // Default white vertex color
-
-      // Insert vertex if it's new, otherwise reuse its index
-      if (!uniqueVertices.contains(vertex)) {
-        uniqueVertices[vertex] = static_cast<uint32_t>(vertices.size());
-        vertices.push_back(vertex);
-      }
-
-      // Push final vertex index
-      indices.push_back(uniqueVertices[vertex]);
-    }
+  // A missing cache only costs the next launch another import
+  if (!stamped)
+    return;
+  try {
+    MeshCache::write(cachePath, stamp, vertices, indices);
+  } catch (const std::exception &e) {
+    std::cerr << "Mesh cache not written: " << e.what() << std::endl;
   }
 }
 
@@ -457,6 +445,7 @@ void VulkanRenderer::createTextureImage() {
   void *data = stagingBufferMemory.mapMemory(0, imageSize);
   memcpy(data, pixels, static_cast<size_t>(imageSize));
   stagingBufferMemory.unmapMemory();
+  ChronoProfiler::counter("vk.stagingBytes", static_cast<int64_t>(imageSize));
 
   stbi_image_free(pixels); // Free CPU-side image data
 
@@ -963,6 +952,7 @@ void VulkanRenderer::updateUniformBuffer(uint32_t currentImage) {
   // Copy the uniform buffer object into the mapped memory of the current frame
   // This updates the GPU-accessible buffer immediately
   memcpy(uniformBuffersMapped[currentImage], &ubo, sizeof(ubo));
+  ChronoProfiler::counter("vk.uniformBytes", sizeof(ubo));
 }
 
 /**
@@ -1163,6 +1153,10 @@ void VulkanRenderer::createBuffer(vk::DeviceSize size,
 
   // Step 5: Bind the allocated memory to the buffer
   buffer.bindMemory(*bufferMemory, 0);
+
+  ChronoProfiler::counter("vk.bufferAllocations");
+  ChronoProfiler::counter("vk.bufferBytes",
+                          static_cast<int64_t>(memRequirements.size));
 }
 
 /**
@@ -1178,7 +1172,7 @@ void VulkanRenderer::createBuffer(vk::DeviceSize size,
  * @see createBuffer()
  */
 void VulkanRenderer::createIndexBuffer() {
-  vk::DeviceSize bufferSize = sizeof(indices[0]) * indices.size();
+  vk::DeviceSize bufferSize = modelIndices.size_bytes();
 
   // Create a host-visible staging buffer
   vk::raii::Buffer stagingBuffer({});
@@ -1188,10 +1182,11 @@ void VulkanRenderer::createIndexBuffer() {
                    vk::MemoryPropertyFlagBits::eHostCoherent,
                stagingBuffer, stagingBufferMemory);
 
-  // Map memory and copy index data into the staging buffer
+  // Map memory and copy index data (possibly straight from the mapped cache)
   void *data = stagingBufferMemory.mapMemory(0, bufferSize);
-  memcpy(data, indices.data(), (size_t)bufferSize);
+  memcpy(data, modelIndices.data(), (size_t)bufferSize);
   stagingBufferMemory.unmapMemory();
+  ChronoProfiler::counter("vk.stagingBytes", static_cast<int64_t>(bufferSize));
 
   // Create a device-local buffer for efficient GPU access
   createBuffer(bufferSize,
@@ -1215,7 +1210,7 @@ void VulkanRenderer::createIndexBuffer() {
  * @warning Ensure vertex structure matches the shader input layout.
  */
 void VulkanRenderer::createVertexBuffer() {
-  vk::DeviceSize bufferSize = sizeof(vertices[0]) * vertices.size();
+  vk::DeviceSize bufferSize = modelVertices.size_bytes();
 
   // Create a host-visible staging buffer
   vk::raii::Buffer stagingBuffer = nullptr;
@@ -1225,10 +1220,11 @@ void VulkanRenderer::createVertexBuffer() {
                    vk::MemoryPropertyFlagBits::eHostCoherent,
                stagingBuffer, stagingBufferMemory);
 
-  // Map memory and copy vertex data into staging buffer
+  // Map memory and copy vertex data (possibly straight from the mapped cache)
   void *data = stagingBufferMemory.mapMemory(0, bufferSize);
-  memcpy(data, vertices.data(), (size_t)bufferSize);
+  memcpy(data, modelVertices.data(), (size_t)bufferSize);
   stagingBufferMemory.unmapMemory();
+  ChronoProfiler::counter("vk.stagingBytes", static_cast<int64_t>(bufferSize));
 
   // Create a device-local vertex buffer
   createBuffer(bufferSize,
@@ -1335,7 +1331,7 @@ void VulkanRenderer::createSyncObjects() {
  * commands, submits them, and presents the rendered image.
  *
  * Steps:
- * 1. Wait for previous frame fence
+ * 1. Wait for previous frame fence and collect its GPU timestamps
  * 2. Acquire next swapchain image
  * 3. Update uniform buffer
  * 4. Reset fence and command buffer
@@ -1343,18 +1339,32 @@ void VulkanRenderer::createSyncObjects() {
  * 6. Submit draw commands and signal semaphores
  * 7. Present the image
  *
+ * The fence wait, image acquisition and presentation are timed into
+ * framePacer on every frame.
+ *
  * @note Automatically recreates the swapchain if needed.
  */
 void VulkanRenderer::drawFrame() {
   // Wait for the current frame fence to ensure GPU has finished
-  while (
-      vk::Result::eTimeout ==
-      device.waitForFences(*inFlightFences[currentFrame], vk::True, UINT64_MAX))
-    ;
+  {
+    FramePacer::ScopedTimer fenceTimer(framePacer,
+                                       FramePacer::Metric::FenceWait);
+    while (vk::Result::eTimeout ==
+           device.waitForFences(*inFlightFences[currentFrame], vk::True,
+                                UINT64_MAX))
+      ;
+  }
+
+  // The slot's previous submission is complete: read its GPU zones
+  gpuProfiler.collect(currentFrame);
 
   // Acquire next available swapchain image
-  auto [result, imageIndex] = swapChain.acquireNextImage(
-      UINT64_MAX, *presentCompleteSemaphores[currentFrame], nullptr);
+  auto [result, imageIndex] = [&] {
+    FramePacer::ScopedTimer acquireTimer(framePacer,
+                                         FramePacer::Metric::Acquire);
+    return swapChain.acquireNextImage(
+        UINT64_MAX, *presentCompleteSemaphores[currentFrame], nullptr);
+  }();
 
   // Handle out-of-date swapchain
   if (result == vk::Result::eErrorOutOfDateKHR) {
@@ -1391,6 +1401,7 @@ void VulkanRenderer::drawFrame() {
   submitInfo.pSignalSemaphores = &*renderFinishedSemaphores[currentFrame];
 
   // Submit command buffer to graphics queue
+  gpuProfiler.markSubmitted(currentFrame);
   graphicsQueue.submit(submitInfo, *inFlightFences[currentFrame]);
 
   // Prepare presentation info
@@ -1402,7 +1413,11 @@ void VulkanRenderer::drawFrame() {
   presentInfoKHR.pImageIndices = &imageIndex;
 
   // Present rendered image to the swapchain
-  result = presentQueue.presentKHR(presentInfoKHR);
+  {
+    FramePacer::ScopedTimer presentTimer(framePacer,
+                                         FramePacer::Metric::Present);
+    result = presentQueue.presentKHR(presentInfoKHR);
+  }
 
   // Recreate swapchain if necessary
   if (result == vk::Result::eErrorOutOfDateKHR ||
@@ -1485,6 +1500,7 @@ void VulkanRenderer::transition_image_layout(
 void VulkanRenderer::recordCommandBuffer(uint32_t imageIndex) {
   // Begin recording commands for the current frame's command buffer
   commandBuffers[currentFrame].begin({});
+  gpuProfiler.beginFrame(commandBuffers[currentFrame], currentFrame);
 
   // --- COLOR IMAGE BARRIER ---
   // Prepare the multisampled color image for rendering output.
@@ -1612,6 +1628,7 @@ void VulkanRenderer::recordCommandBuffer(uint32_t imageIndex) {
   renderingInfo.pStencilAttachment = nullptr;
 
   // Start dynamic rendering
+  gpuProfiler.beginZone(commandBuffers[currentFrame], "Main Pass");
   commandBuffers[currentFrame].beginRendering(renderingInfo);
 
   // Bind the graphics pipeline to the command buffer
@@ -1638,10 +1655,12 @@ void VulkanRenderer::recordCommandBuffer(uint32_t imageIndex) {
 
   // Issue indexed draw command
   commandBuffers[currentFrame].drawIndexed(
-      static_cast<uint32_t>(indices.size()), 1, 0, 0, 0);
+      static_cast<uint32_t>(modelIndices.size()), 1, 0, 0, 0);
+  ChronoProfiler::counter("vk.drawCalls");
 
   // End dynamic rendering
   commandBuffers[currentFrame].endRendering();
+  gpuProfiler.endZone(commandBuffers[currentFrame]);
 
   // --- TRANSITION TO PRESENT ---
   // Transition swapchain image to presentable layout
@@ -1668,7 +1687,8 @@ void VulkanRenderer::recordCommandBuffer(uint32_t imageIndex) {
 
   commandBuffers[currentFrame].pipelineBarrier2(presentDependencyInfo);
 
-  // Finish recording the command buffer
+  // Close the GPU frame zone, then finish recording the command buffer
+  gpuProfiler.endFrame(commandBuffers[currentFrame]);
   commandBuffers[currentFrame].end();
 }
 
@@ -2249,6 +2269,8 @@ vk::SurfaceFormatKHR VulkanRenderer::chooseSwapSurfaceFormat(
  * - Setting up required device queues and enabling Vulkan 1.3 and extended
  * dynamic state features.
  * - Creating logical device and retrieving graphics/present queue handles.
+ * - Enabling calibrated timestamps and creating GPU query pools when
+ * profiling.
  *
  * @throws std::runtime_error if no suitable graphics or present queue
  * families are found.
@@ -2351,6 +2373,13 @@ void VulkanRenderer::pickLogicalGPU() {
       .extendedDynamicState = true;
   // Allows dynamic state changes without recreating pipeline
 
+  const char *timestampCalibration =
+      GpuProfiler::calibrationExtension(physicalGPU);
+  if (timestampCalibration) {
+    gpuExtensions.push_back(timestampCalibration);
+  }
+  // Calibrated timestamps align GPU zones with CPU zones (profiling builds)
+
   vk::DeviceCreateInfo deviceCreateInfo;
   deviceCreateInfo.pNext = &featureChain.get<vk::PhysicalDeviceFeatures2>();
   deviceCreateInfo.queueCreateInfoCount =
@@ -2367,6 +2396,10 @@ void VulkanRenderer::pickLogicalGPU() {
   graphicsQueue = vk::raii::Queue(device, graphicsIndex, 0);
   presentQueue = vk::raii::Queue(device, presentIndex, 0);
   // Acquire queue handles (0 = first queue of that family)
+
+  gpuProfiler.init(physicalGPU, device, graphicsIndex, MAX_FRAMES_IN_FLIGHT,
+                   timestampCalibration != nullptr);
+  // Per-frame timestamp query pools for the GPU track (profiling builds)
 }
 
 /**
@@ -2469,6 +2502,7 @@ void VulkanRenderer::recreateSwapChain() {
 
   device.waitIdle();  // Ensure GPU is not using old swapchain resources
   cleanupSwapChain(); // Release old swap chain resources
+  ChronoProfiler::counter("vk.swapchainRecreations");
 
   createSwapChain();      // Make new swap chain
   createImageViews();     // Create views for each swap chain image
@@ -2579,41 +2613,102 @@ void VulkanRenderer::initVulkan() {
  * @brief Runs the main application loop.
  *
  * Polls window events and continuously renders frames until the window is
- * closed. Profiles CPU time per frame and outputs live ASCII visualization
- * only on selected frames to reduce terminal/UI overload.
+ * closed. Every frame is profiled; ChronoProfiler's capture policy decides
+ * which frames are published, and only those are shown in the live ASCII
+ * visualization to reduce terminal/UI overload.
+ *
+ * The policy defaults to every 10th frame and can be changed at runtime with
+ * the CHRONO_CAPTURE environment variable ("continuous", "every:N",
+ * "random:RATE" or "trigger:MS[:K]").
  *
- * @note Exports JSON at the end of the run for offline analysis.
+ * CHRONO_ALLOCS=1 charges heap allocations to the innermost zone; they are
+ * reported per zone in the ProfilerUI "Allocations" table, and the exit
+ * report counts the captured frames after warm-up that allocated at all
+ * (steady-state frames should not).
+ *
+ * Setting CHRONO_LIVE_PORT (1-65535) in a profiling build serves captured
+ * frames to a browser at http://127.0.0.1:<port>/; without it no socket is
+ * opened.
+ *
+ * Independently of the capture policy, framePacer times every frame and
+ * flags hitches; its pacing report is printed when the loop exits.
+ *
+ * @note Captured frames are streamed to a binary capture during the run
+ *       (convert with 'chrono-convert'), and the last captured frame is also
+ *       exported as JSON at the end.
  */
 void VulkanRenderer::mainLoop() {
-  int frameCounter = 0;
-  const int profileEveryNFrames = 10;
-  // Only profile every N frames to avoid terminal spam
+  ChronoProfiler::CapturePolicy capturePolicy =
+      ChronoProfiler::CapturePolicy::everyNth(10);
+  if (const char *spec = std::getenv("CHRONO_CAPTURE")) {
+    if (!ChronoProfiler::CapturePolicy::parse(spec, capturePolicy)) {
+      std::cerr << "Ignoring invalid CHRONO_CAPTURE policy: " << spec
+                << std::endl;
+    }
+  }
+  ChronoProfiler::setCapturePolicy(capturePolicy);
+  // Choose which frames are captured (default: every 10th)
+
+  if (const char *allocs = std::getenv("CHRONO_ALLOCS"))
+    ChronoProfiler::setAllocationTracking(std::strcmp(allocs, "0") != 0);
+  // Charge heap allocations to zones (profiling builds only)
+
+  ChronoProfiler::beginTrace("profile_capture.chrono");
+  // Stream every captured frame in the compact binary format
+
+  if (const char *port = std::getenv("CHRONO_LIVE_PORT")) {
+    char *end = nullptr; // Out-of-range and negative input exceed 65535 too
+    const unsigned long livePort = std::strtoul(port, &end, 10);
+    if (end == port || *end != '\0' || livePort == 0 || livePort > 65535) {
+      std::cerr << "Ignoring invalid CHRONO_LIVE_PORT (expected 1-65535): "
+                << port << std::endl;
+    } else if (ChronoProfiler::startLiveServer(
+                   static_cast<uint16_t>(livePort))) {
+      std::cout << "Live profiler: http://127.0.0.1:" << livePort << "/"
+                << std::endl;
+    }
+  }
+  // Serve captured frames to a browser, only when asked (profiling builds only)
 
-  while (!glfwWindowShouldClose(window)) {
-    glfwPollEvents(); // Handle input + resize events
+  uint64_t checkedFrames = 0;    // Steady-state frames checked for allocations
+  uint64_t allocatingFrames = 0; // Of those, frames that allocated in a zone
 
-    bool doProfile = (frameCounter % profileEveryNFrames == 0);
-    // Enable profiling only for selected frames
+  while (!glfwWindowShouldClose(window)) {
+    framePacer.beginFrame(); // Time every frame, captured or not
+    glfwPollEvents();        // Handle input + resize events
 
-    if (doProfile) {
+    {
       ChronoProfiler::ScopedFrame frame;
       PROFILE_SCOPE("drawFrame()");
       drawFrame(); // Render + measure CPU time
-    } else {
-      drawFrame(); // No profiling this frame
     }
 
-    if (doProfile) {
+    if (ChronoProfiler::isFrameCaptured()) {
+      if (ChronoProfiler::isAllocationTracking() &&
+          framePacer.frameCount() >= FramePacer::kWarmupFrames) {
+        ++checkedFrames;
+        if (ChronoProfiler::frameAllocationCount() != 0)
+          ++allocatingFrames;
+      }
       profilerUI.update(); // Process profiler data
       profilerUI.render(); // Print profiler UI
     }
 
-    frameCounter++; // Advance frame count
+    if (framePacer.endFrame())
+      ChronoProfiler::counter("frame.hitches"); // Lands in the next frame
   }
 
   device.waitIdle(); // Wait for GPU to finish processing all frames
+  ChronoProfiler::endTrace(); // Flush and close the capture
+  ChronoProfiler::stopLiveServer(); // Disconnect live viewers
   ChronoProfiler::exportToJSON("profile_output.json");
   // Save profiling data to a JSON file
+
+  framePacer.report(std::cout); // p99 / p99.9 and hitch summary
+  if (checkedFrames != 0) {
+    std::cout << "Steady-state frames that allocated: " << allocatingFrames
+              << " of " << checkedFrames << " captured" << std::endl;
+  }
 }
 
 /**
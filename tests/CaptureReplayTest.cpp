@@ -0,0 +1,112 @@
+/**
+ * @file CaptureReplayTest.cpp
+ * @brief Replay of a capture whose thread ID is reused by a new thread.
+ *
+ * The capture holds four frames on thread ID 1: "Alpha" records frames 0
+ * and 1 and exits, then "Beta" takes over the ID for frames 2 and 3 (the
+ * writer emits a second 'Thread' chunk for the ID before frame 2). Every
+ * way of reading a frame must report the name the ID had in that frame:
+ *  - nextFrame() in file order;
+ *  - readFrame() after frameCount() indexed the whole capture;
+ *  - readFrame() in random order on a partially indexed capture.
+ */
+
+#include "ChronoCapture.hpp"
+#include "TestCheck.hpp"
+
+#include <string>      ///< Capture bytes
+#include <string_view> ///< Expected names
+
+namespace {
+
+constexpr uint32_t kThreadId = 1;  ///< ID shared by Alpha and Beta
+constexpr uint16_t kZoneName = 1;  ///< String ID of the only zone
+constexpr size_t kFrames = 4;      ///< Frames in the capture
+
+/** @brief Name thread ID 1 has in each frame. */
+constexpr std::string_view kExpected[kFrames] = {"Alpha", "Alpha", "Beta",
+                                                 "Beta"};
+
+/** @brief Appends a 'Thread' chunk. */
+void writeThread(std::string &capture, uint32_t threadId,
+                 std::string_view name) {
+  std::string chunk;
+  chronocap::putVarint(chunk, threadId);
+  chronocap::putVarint(chunk, name.size());
+  chunk.append(name);
+  chronocap::writeChunk(capture, chronocap::ChunkType::Thread, chunk);
+}
+
+/** @brief Capture bytes as ChronoTraceWriter would write them. */
+std::string buildCapture() {
+  std::string capture;
+  chronocap::writeHeader(capture, 0, false);
+
+  std::string chunk;
+  chronocap::putVarint(chunk, kZoneName);
+  chronocap::putFixed<uint32_t>(chunk, 0);
+  chronocap::putVarint(chunk, 4);
+  chunk.append("zone");
+  chronocap::writeChunk(capture, chronocap::ChunkType::String, chunk);
+
+  chunk.clear();
+  chronocap::putDouble(chunk, 1e-6);
+  chronocap::writeChunk(capture, chronocap::ChunkType::Clock, chunk);
+
+  for (size_t frame = 0; frame < kFrames; ++frame) {
+    if (frame == 0 || kExpected[frame] != kExpected[frame - 1])
+      writeThread(capture, kThreadId, kExpected[frame]);
+
+    ChronoProfiler::Event zone{};
+    zone.startTicks = frame * 1000;
+    zone.endTicks = zone.startTicks + 500;
+    zone.threadId = kThreadId;
+    zone.parentIndex = -1;
+    zone.nameId = kZoneName;
+    chunk.clear();
+    chronocap::encodeFrame(chunk, frame, frame * 1000, {&zone, 1});
+    chronocap::writeChunk(capture, chronocap::ChunkType::Frame, chunk);
+  }
+  return capture;
+}
+
+/** @brief Reads frame 'position' and checks the name of its zone's thread. */
+void checkFrame(chronocap::CaptureReader &reader, size_t position) {
+  chronocap::Frame frame;
+  CHECK(reader.readFrame(position, frame));
+  CHECK(frame.events.size() == 1 && frame.index == position);
+  CHECK(reader.getThreadName(kThreadId) == kExpected[position]);
+}
+
+} // namespace
+
+int main() {
+  const std::string capture = buildCapture();
+  const std::span<const uint8_t> bytes(
+      reinterpret_cast<const uint8_t *>(capture.data()), capture.size());
+
+  {
+    chronocap::CaptureReader reader(bytes);
+    chronocap::Frame frame;
+    size_t position = 0;
+    for (; reader.nextFrame(frame); ++position)
+      CHECK(reader.getThreadName(kThreadId) == kExpected[position]);
+    CHECK(position == kFrames);
+  }
+
+  {
+    chronocap::CaptureReader reader(bytes);
+    CHECK(reader.frameCount() == kFrames);
+    for (size_t position : {0, 3, 1, 2, 0})
+      checkFrame(reader, position);
+  }
+
+  {
+    chronocap::CaptureReader reader(bytes);
+    for (size_t position : {2, 0, 3, 1})
+      checkFrame(reader, position);
+    CHECK(reader.getThreadName(kThreadId + 1) == "<unnamed>");
+  }
+
+  return testcheck::result("CaptureReplayTest");
+}
@@ -0,0 +1,202 @@
+/**
+ * @file DedupTest.cpp
+ * @brief Parallel and streaming deduplication match a serial reference.
+ *
+ * Every path through meshimport must produce exactly the vertices and
+ * indices of one serial pass that numbers vertices by first occurrence,
+ * including which of -0.0f and +0.0f a merged vertex keeps when the two
+ * signs first appear in different chunks or batches:
+ *  - deduplicate() on one thread and split into chunks on a worker pool;
+ *  - a Deduplicator fed in batches, which reuses its pool and resolves
+ *    vertices of earlier batches in the parallel phase;
+ *  - importObj() on a file, including corners without texture coordinates.
+ * A task that throws on a pool thread must reach the caller.
+ */
+
+#include "MeshImport.hpp"
+#include "ObjReader.hpp"
+#include "TestCheck.hpp"
+#include "VertexHash.hpp" // std::hash<Vertex> for the reference
+
+#include <algorithm>     ///< std::min for the batch size
+#include <cmath>         ///< NAN, std::signbit
+#include <cstdio>        ///< std::remove for the temporary OBJ file
+#include <cstring>       ///< std::memcmp to compare vertices bitwise
+#include <fstream>       ///< Writing the OBJ file
+#include <stdexcept>     ///< std::runtime_error from a failing corner
+#include <unordered_map> ///< Reference deduplication
+
+namespace {
+
+constexpr size_t kGridSide = 300;        ///< Grid of kGridSide^2 positions
+constexpr unsigned kThreads = 4;         ///< Pool size for the parallel paths
+constexpr size_t kBatchCorners = 300000; ///< Batch size for Deduplicator
+
+/** @brief Deduplicated mesh. */
+struct Mesh {
+  std::vector<Vertex> vertices;
+  std::vector<uint32_t> indices;
+};
+
+/** @brief Grid position 'p' as a white vertex with a per-position texCoord. */
+Vertex gridVertex(size_t p, bool textured) {
+  Vertex vertex{};
+  vertex.position = {static_cast<float>(p % kGridSide),
+                     static_cast<float>(p / kGridSide), 0.0f};
+  vertex.color = {1.0f, 1.0f, 1.0f};
+  vertex.texCoord = textured ? glm::vec2{vertex.position.x / kGridSide,
+                                         1.0f - vertex.position.y / kGridSide}
+                             : glm::vec2{0.0f, 1.0f};
+  return vertex;
+}
+
+/** @brief Flips the sign of a vertex's (zero) z coordinate. */
+Vertex negateZ(Vertex vertex) {
+  vertex.position.z = -vertex.position.z;
+  return vertex;
+}
+
+/**
+ * @brief Two triangles per grid cell, as 'f a b c d' quads are fan-triangulated.
+ *
+ * Every tenth row has no texture coordinates. Unless 'plain', a few NaN
+ * vertices, which never compare equal, are mixed in as well, and the first
+ * two grid positions reappear with the other zero sign in later chunks and
+ * batches:
+ *  - position 0 is first seen as -0.0f in the first chunk, and as +0.0f in
+ *    the third chunk (first batch);
+ *  - position 1 is first seen as +0.0f in the first chunk, and as -0.0f in
+ *    the last chunk (second batch).
+ */
+std::vector<Vertex> gridCorners(bool plain = false) {
+  std::vector<Vertex> corners;
+  for (size_t y = 0; y + 1 < kGridSide; ++y) {
+    const bool textured = y % 10 != 0;
+    for (size_t x = 0; x + 1 < kGridSide; ++x) {
+      const size_t a = y * kGridSide + x, b = a + 1;
+      const size_t c = b + kGridSide, d = a + kGridSide;
+      for (size_t p : {a, b, c, a, c, d})
+        corners.push_back(gridVertex(p, textured));
+    }
+  }
+  if (plain)
+    return corners;
+
+  for (size_t i = 0; i < corners.size(); i += 40000)
+    corners[i].position.z = NAN;
+  corners[3] = negateZ(corners[3]); // Corner 0 (NaN) and 3 are position 0
+  corners[corners.size() / 2 + 1] = gridVertex(0, false);
+  corners[corners.size() - 2] = negateZ(gridVertex(1, false));
+  return corners;
+}
+
+/** @brief Serial first-occurrence numbering through std::unordered_map. */
+Mesh reference(const std::vector<Vertex> &corners) {
+  Mesh mesh;
+  std::unordered_map<Vertex, uint32_t> seen;
+  for (const Vertex &vertex : corners) {
+    auto [it, inserted] =
+        seen.try_emplace(vertex, static_cast<uint32_t>(mesh.vertices.size()));
+    if (inserted)
+      mesh.vertices.push_back(vertex);
+    mesh.indices.push_back(it->second);
+  }
+  return mesh;
+}
+
+/** @brief Same vertices (bitwise, so NaN entries compare) and indices. */
+bool sameMesh(const Mesh &a, const Mesh &b) {
+  if (a.indices != b.indices || a.vertices.size() != b.vertices.size())
+    return false;
+  for (size_t i = 0; i < a.vertices.size(); ++i) {
+    if (std::memcmp(&a.vertices[i], &b.vertices[i], sizeof(Vertex)) != 0)
+      return false;
+  }
+  return true;
+}
+
+/** @brief Writes the grid as an OBJ file producing gridCorners(true). */
+void writeGridObj(const char *path) {
+  std::ofstream obj(path);
+  obj.precision(9); // Enough digits for every float to round-trip
+  obj << "# grid\n";
+  for (size_t p = 0; p < kGridSide * kGridSide; ++p) {
+    obj << "v " << p % kGridSide << ' ' << p / kGridSide << " 0\n";
+    obj << "vt " << static_cast<float>(p % kGridSide) / kGridSide << ' '
+        << static_cast<float>(p / kGridSide) / kGridSide << '\n';
+  }
+  for (size_t y = 0; y + 1 < kGridSide; ++y) {
+    const bool textured = y % 10 != 0;
+    for (size_t x = 0; x + 1 < kGridSide; ++x) {
+      const size_t a = y * kGridSide + x + 1; // OBJ indices are 1-based
+      obj << 'f';
+      for (size_t p : {a, a + 1, a + 1 + kGridSide, a + kGridSide}) {
+        if (textured)
+          obj << ' ' << p << '/' << p;
+        else
+          obj << ' ' << p;
+      }
+      obj << '\n';
+    }
+  }
+}
+
+} // namespace
+
+int main() {
+  const std::vector<Vertex> corners = gridCorners();
+  const Mesh expected = reference(corners);
+  auto corner = [&](size_t i) { return corners[i]; };
+  CHECK(meshimport::chunkCountFor(corners.size(), kThreads) == kThreads);
+  CHECK(corners.size() - 2 >= kBatchCorners); // The last sign flip is in batch 2
+  CHECK(!std::signbit(expected.vertices[1].position.z)); // Position 1: +0.0f
+  CHECK(std::signbit(expected.vertices[3].position.z));  // Position 0: -0.0f
+
+  for (unsigned threads : {1u, kThreads}) {
+    Mesh mesh;
+    meshimport::deduplicate(corners.size(), corner, mesh.vertices, mesh.indices,
+                            threads);
+    CHECK(sameMesh(mesh, expected));
+  }
+
+  {
+    Mesh mesh;
+    meshimport::Deduplicator deduplicator(mesh.vertices, mesh.indices, 0,
+                                          kThreads);
+    for (size_t begin = 0; begin < corners.size(); begin += kBatchCorners) {
+      const size_t count = std::min(kBatchCorners, corners.size() - begin);
+      deduplicator.append(count,
+                          [&](size_t i) { return corners[begin + i]; });
+    }
+    CHECK(sameMesh(mesh, expected));
+  }
+
+  {
+    const Mesh objExpected = reference(gridCorners(true)); // No NaNs in the file
+
+    const char *path = "DedupTest.obj";
+    writeGridObj(path);
+    Mesh mesh;
+    meshimport::importObj(path, mesh.vertices, mesh.indices, kThreads);
+    std::remove(path);
+    CHECK(sameMesh(mesh, objExpected));
+  }
+
+  bool threw = false;
+  try {
+    Mesh mesh;
+    meshimport::deduplicate(
+        corners.size(),
+        [&](size_t i) {
+          if (i == corners.size() - 1) // Last chunk, usually a worker's
+            throw std::runtime_error("corner failed");
+          return corners[i];
+        },
+        mesh.vertices, mesh.indices, kThreads);
+  } catch (const std::runtime_error &) {
+    threw = true;
+  }
+  CHECK(threw);
+
+  return testcheck::result("DedupTest");
+}
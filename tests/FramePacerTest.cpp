@@ -0,0 +1,102 @@
+/**
+ * @file FramePacerTest.cpp
+ * @brief FramePacer statistics on synthetic frame times.
+ *
+ * 10000 frames: mostly 16 ms, 200 spread-out 20 ms frames (below the 2x
+ * median threshold) and 25 hitches, 20 of 40 ms and five between 100 and
+ * 140 ms. Checks:
+ *  - hitchCount() and the worst-hitch list (frames, times, median);
+ *  - p50, p99 and p99.9 of the CPU frame time, within the histogram's
+ *    bucket error;
+ *  - wait metrics only recorded in frames that touched them;
+ *  - report() leaving the caller's stream flags and precision as they were.
+ */
+
+#include "FramePacer.hpp"
+#include "TestCheck.hpp"
+
+#include <cmath>    ///< std::abs for the tolerance
+#include <iterator> ///< std::size
+#include <sstream>  ///< Report destination
+#include <string>   ///< Report text
+
+namespace {
+
+constexpr uint64_t kFrames = 10000; ///< Frames fed to the pacer
+constexpr double kSteadyMs = 16.0;  ///< Typical frame
+constexpr double kSlowMs = 20.0;    ///< Slow, but not a hitch
+constexpr double kHitchMs = 40.0;   ///< Common hitch
+constexpr double kTolerance = 0.04; ///< Histogram bucket error (about 3%)
+
+/** @brief Frames of the 140, 130, 120, 110 and 100 ms hitches. */
+constexpr uint64_t kWorstFrames[] = {9000, 3000, 7000, 1000, 5000};
+
+/** @brief Synthetic CPU frame time of frame 'f'. */
+double frameMs(uint64_t f) {
+  for (size_t i = 0; i < std::size(kWorstFrames); ++i) {
+    if (f == kWorstFrames[i])
+      return 140.0 - 10.0 * static_cast<double>(i);
+  }
+  if (f % 500 == 250)
+    return kHitchMs; // 250, 750, ... 9750
+  return f % 50 == 25 ? kSlowMs : kSteadyMs;
+}
+
+/** @brief 'value' is within kTolerance of 'expected'. */
+bool near(double value, double expected) {
+  return std::abs(value - expected) <= kTolerance * expected;
+}
+
+} // namespace
+
+int main() {
+  FramePacer pacer(2.0);
+  uint64_t reportedHitches = 0;
+  for (uint64_t f = 0; f < kFrames; ++f) {
+    pacer.beginFrame();
+    pacer.addTime(FramePacer::Metric::FenceWait, 1.0);
+    pacer.addTime(FramePacer::Metric::FenceWait, 2.0); // Accumulates to 3 ms
+    if (f % 2 == 0)
+      pacer.addTime(FramePacer::Metric::Present, 0.5);
+    if (pacer.endFrame(frameMs(f)))
+      ++reportedHitches;
+  }
+
+  const uint64_t expectedHitches = kFrames / 500 + std::size(kWorstFrames);
+  CHECK(pacer.frameCount() == kFrames);
+  CHECK(pacer.hitchCount() == expectedHitches);
+  CHECK(reportedHitches == expectedHitches);
+
+  const auto worst = pacer.worstHitches();
+  CHECK(worst.size() == FramePacer::kWorstHitches);
+  for (size_t i = 0; i < worst.size(); ++i) {
+    CHECK(worst[i].frame == kWorstFrames[i]);
+    CHECK(worst[i].ms == 140.0 - 10.0 * static_cast<double>(i));
+    CHECK(near(worst[i].medianMs, kSteadyMs));
+  }
+
+  const LogHistogram &cpu = pacer.histogram(FramePacer::Metric::CpuFrame);
+  CHECK(cpu.count() == kFrames);
+  CHECK(near(cpu.quantile(0.50), kSteadyMs));
+  CHECK(near(cpu.quantile(0.99), kSlowMs));   // Ranks 9776-9975 are 20 ms
+  CHECK(near(cpu.quantile(0.999), kHitchMs)); // Ranks 9976-9995 are 40 ms
+  CHECK(cpu.max() == 140.0);
+
+  const LogHistogram &fence = pacer.histogram(FramePacer::Metric::FenceWait);
+  CHECK(fence.count() == kFrames && near(fence.quantile(0.5), 3.0));
+  CHECK(pacer.histogram(FramePacer::Metric::Present).count() == kFrames / 2);
+  CHECK(pacer.histogram(FramePacer::Metric::Acquire).count() == 0);
+
+  std::ostringstream out;
+  out << std::scientific << std::right;
+  out.precision(7);
+  const std::ios_base::fmtflags flags = out.flags();
+  pacer.report(out);
+  CHECK(out.flags() == flags);
+  CHECK(out.precision() == 7);
+  const std::string text = out.str();
+  CHECK(text.find("-- Frame Pacing (10000 frames) --") != std::string::npos);
+  CHECK(text.find("frame 9000: 140.00 ms") != std::string::npos);
+
+  return testcheck::result("FramePacerTest");
+}
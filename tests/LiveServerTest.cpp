@@ -0,0 +1,153 @@
+/**
+ * @file LiveServerTest.cpp
+ * @brief ChronoLiveServer on an ephemeral port, with fast, stalled and
+ * reading clients.
+ *
+ * Checks that:
+ *  - port 0 binds a free port, reported by port();
+ *  - frames submitted faster than the server picks them up are dropped and
+ *    counted by droppedFrames();
+ *  - a subscriber that never reads (and a tiny receive buffer) does not make
+ *    submit() block;
+ *  - 'GET /events' streams 'frame' messages that carry the submitted zone and
+ *    the thread name captured with the frame.
+ */
+
+#include "ChronoLiveServer.hpp"
+#include "TestCheck.hpp"
+
+#include <algorithm>    ///< std::max of the submit times
+#include <arpa/inet.h>  ///< htons / htonl
+#include <chrono>       ///< Submit timing and read deadlines
+#include <netinet/in.h> ///< sockaddr_in, INADDR_LOOPBACK
+#include <poll.h>       ///< poll() on the reading client
+#include <string>       ///< Received stream
+#include <sys/socket.h> ///< socket / connect / send / recv
+#include <thread>       ///< sleep_for between frames
+#include <unistd.h>     ///< close()
+#include <vector>       ///< Frame events
+
+namespace {
+
+using Clock = std::chrono::steady_clock;
+
+constexpr uint32_t kThreadId = 3;       ///< Thread of every zone
+constexpr size_t kBigFrameZones = 4000; ///< Zones per frame for the stalled client
+constexpr double kMaxSubmitMs = 50.0;   ///< A blocked send() would take far longer
+
+/** @brief Connects to 127.0.0.1:port and sends a GET request. */
+int connectAndGet(uint16_t port, const char *path, int receiveBuffer = 0) {
+  const int fd = ::socket(AF_INET, SOCK_STREAM, 0);
+  if (receiveBuffer > 0)
+    ::setsockopt(fd, SOL_SOCKET, SO_RCVBUF, &receiveBuffer,
+                 sizeof(receiveBuffer));
+  sockaddr_in address{};
+  address.sin_family = AF_INET;
+  address.sin_port = htons(port);
+  address.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+  if (::connect(fd, reinterpret_cast<sockaddr *>(&address), sizeof(address)) <
+      0) {
+    ::close(fd);
+    return -1;
+  }
+  const std::string request =
+      std::string("GET ") + path + " HTTP/1.1\r\nHost: localhost\r\n\r\n";
+  ::send(fd, request.data(), request.size(), MSG_NOSIGNAL);
+  return fd;
+}
+
+/** @brief A frame of 'zones' sibling zones on kThreadId. */
+std::vector<ChronoProfiler::Event> makeFrame(size_t zones, uint16_t nameId,
+                                             uint64_t startTicks) {
+  std::vector<ChronoProfiler::Event> events(zones);
+  for (size_t i = 0; i < zones; ++i) {
+    ChronoProfiler::Event &evt = events[i];
+    evt.startTicks = startTicks + i * 10;
+    evt.endTicks = evt.startTicks + 5;
+    evt.threadId = kThreadId;
+    evt.parentIndex = -1;
+    evt.nameId = nameId;
+  }
+  return events;
+}
+
+/** @brief The first complete 'frame' message's data line in 'stream', or "". */
+std::string firstFrameData(const std::string &stream) {
+  const size_t event = stream.find("event: frame\ndata: ");
+  if (event == std::string::npos)
+    return "";
+  const size_t data = event + 19;
+  const size_t end = stream.find("\n\n", data);
+  return end == std::string::npos ? "" : stream.substr(data, end - data);
+}
+
+} // namespace
+
+int main() {
+  const uint16_t zoneName = ChronoProfiler::internString("live.zone");
+  const ChronoProfiler::ThreadName threadNames[] = {
+      {kThreadId, ChronoProfiler::internString("Worker")}};
+
+  ChronoLiveServer server(0);
+  CHECK(server.port() != 0);
+
+  // Producer outruns the server thread: older frames are replaced and counted
+  {
+    const auto frame = makeFrame(8, zoneName, ChronoProfiler::nowTicks());
+    for (int i = 0; i < 10000; ++i)
+      server.submit(frame, threadNames, frame.front().startTicks);
+    CHECK(server.droppedFrames() > 0);
+  }
+
+  // A subscriber that never reads: its socket fills, submit() stays quick
+  const int stalled = connectAndGet(server.port(), "/events", 4096);
+  CHECK(stalled >= 0);
+  {
+    const auto frame =
+        makeFrame(kBigFrameZones, zoneName, ChronoProfiler::nowTicks());
+    double maxSubmitMs = 0.0;
+    for (int i = 0; i < 200; ++i) {
+      const Clock::time_point start = Clock::now();
+      server.submit(frame, threadNames, frame.front().startTicks);
+      maxSubmitMs = std::max(
+          maxSubmitMs,
+          std::chrono::duration<double, std::milli>(Clock::now() - start)
+              .count());
+      std::this_thread::sleep_for(std::chrono::milliseconds(2)); // Let it send
+    }
+    CHECK(maxSubmitMs < kMaxSubmitMs);
+  }
+
+  // A reading subscriber receives whole frame messages
+  const int reader = connectAndGet(server.port(), "/events");
+  CHECK(reader >= 0);
+  std::string stream;
+  std::string data;
+  const auto frame = makeFrame(2, zoneName, ChronoProfiler::nowTicks());
+  const Clock::time_point deadline = Clock::now() + std::chrono::seconds(10);
+  while (data.empty() && Clock::now() < deadline) {
+    server.submit(frame, threadNames, frame.front().startTicks);
+    pollfd fd{reader, POLLIN, 0};
+    if (::poll(&fd, 1, 20) > 0) {
+      char buffer[4096];
+      const ssize_t received = ::recv(reader, buffer, sizeof(buffer), 0);
+      if (received <= 0)
+        break;
+      stream.append(buffer, static_cast<size_t>(received));
+      data = firstFrameData(stream);
+    }
+  }
+  CHECK(stream.starts_with("HTTP/1.1 200 OK\r\n"));
+  CHECK(stream.find("Content-Type: text/event-stream\r\n") != std::string::npos);
+  CHECK(data.starts_with("{\"frame\":"));
+  CHECK(data.ends_with("]]}") || data.ends_with("[]}"));
+  CHECK(data.find(",\"threads\":[[3,\"Worker\"]],\"zones\":[[3,0,") !=
+        std::string::npos);
+  CHECK(data.find(",\"live.zone\"]") != std::string::npos);
+  CHECK(data.find("\"statsFrames\":") != std::string::npos);
+  CHECK(data.find('\n') == std::string::npos); // One line per message
+
+  ::close(reader);
+  ::close(stalled);
+  return testcheck::result("LiveServerTest");
+}
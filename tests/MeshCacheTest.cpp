@@ -0,0 +1,202 @@
+/**
+ * @file MeshCacheTest.cpp
+ * @brief MeshCache accepts only caches that match their source and are intact.
+ *
+ * Covers:
+ *  - Xxh64 against reference values, and streaming in random pieces against
+ *    the one-shot hash;
+ *  - importObj() reporting the hash MeshCache::hashSource() computes;
+ *  - a round trip through write() and open();
+ *  - a touched but unchanged source (accepted, stamp refreshed) and a
+ *    same-size edit (rejected);
+ *  - a cache whose index addresses a missing vertex, and a truncated cache
+ *    (both rejected);
+ *  - several threads writing the same cache at once (every write succeeds,
+ *    the result is intact and no temporary file is left behind).
+ */
+
+#include "MeshCache.hpp"
+#include "ObjReader.hpp"
+#include "TestCheck.hpp"
+#include "Xxh64.hpp"
+
+#include <algorithm>  ///< std::min for the piece sizes
+#include <atomic>     ///< Failed concurrent writes
+#include <chrono>     ///< Modification time offsets
+#include <cstring>    ///< std::memcmp to compare vertices bitwise
+#include <filesystem> ///< Touching, truncating and removing the test files
+#include <fstream>    ///< Writing the OBJ and patching the cache
+#include <random>     ///< Random split points for the streaming hash
+#include <stdexcept>  ///< std::runtime_error from a failed write
+#include <string>     ///< File contents
+#include <thread>     ///< Concurrent writers
+#include <vector>     ///< Mesh arrays
+
+namespace {
+
+const char *const kSourcePath = "MeshCacheTest.obj"; ///< Temporary source
+const char *const kCachePath = "MeshCacheTest.amesh"; ///< Temporary cache
+
+/** @brief A textured quad as two triangles. */
+const char *const kQuadObj = "v 0 0 0\n"
+                             "v 1 0 0\n"
+                             "v 1 1 0\n"
+                             "v 0 1 0\n"
+                             "vt 0 0\n"
+                             "vt 1 0\n"
+                             "vt 1 1\n"
+                             "vt 0 1\n"
+                             "f 1/1 2/2 3/3 4/4\n";
+
+/** @brief Replaces a file's contents. */
+void writeFile(const char *path, const std::string &contents) {
+  std::ofstream out(path, std::ios::binary | std::ios::trunc);
+  out << contents;
+}
+
+/** @brief Moves a file's modification time by 'seconds'. */
+void touch(const char *path, int seconds) {
+  const auto mtime = std::filesystem::last_write_time(path);
+  std::filesystem::last_write_time(path, mtime + std::chrono::seconds(seconds));
+}
+
+/** @brief Imports the source and writes its cache, stamped before the import. */
+void buildCache(std::vector<Vertex> &vertices, std::vector<uint32_t> &indices) {
+  MeshCache::SourceStamp stamp;
+  CHECK(MeshCache::statSource(kSourcePath, stamp));
+  meshimport::importObj(kSourcePath, vertices, indices, 1, &stamp.hash);
+  MeshCache::write(kCachePath, stamp, vertices, indices);
+}
+
+/** @brief The cache opens and holds exactly 'vertices' and 'indices'. */
+bool cacheHolds(const std::vector<Vertex> &vertices,
+                const std::vector<uint32_t> &indices) {
+  const auto cache = MeshCache::open(kCachePath, kSourcePath);
+  return cache && cache->vertices().size() == vertices.size() &&
+         cache->indices().size() == indices.size() &&
+         std::memcmp(cache->vertices().data(), vertices.data(),
+                     vertices.size() * sizeof(Vertex)) == 0 &&
+         std::memcmp(cache->indices().data(), indices.data(),
+                     indices.size() * sizeof(uint32_t)) == 0;
+}
+
+/** @brief Known values and streaming in random pieces. */
+void checkXxh64() {
+  CHECK(Xxh64::hash(nullptr, 0) == 0xEF46DB3751D8E999ull);
+  const unsigned char zeros[32] = {};
+  CHECK(Xxh64::hash(zeros, sizeof(zeros)) == 0xF6E9BE5D70632CF5ull);
+
+  std::mt19937 rng(2024);
+  std::vector<unsigned char> data(1000);
+  for (unsigned char &byte : data)
+    byte = static_cast<unsigned char>(rng());
+
+  for (size_t length : {size_t{0}, size_t{3}, size_t{31}, size_t{32},
+                        size_t{33}, size_t{100}, data.size()}) {
+    const uint64_t expected = Xxh64::hash(data.data(), length);
+    for (int trial = 0; trial < 20; ++trial) {
+      Xxh64 hasher;
+      size_t offset = 0;
+      while (offset < length) {
+        const size_t piece = std::min<size_t>(rng() % 40, length - offset);
+        hasher.update(data.data() + offset, piece);
+        offset += piece;
+      }
+      CHECK(hasher.digest() == expected);
+    }
+  }
+}
+
+/** @brief Writers race on one cache; each must use its own temporary file. */
+void checkConcurrentWrites(const std::vector<Vertex> &vertices,
+                           const std::vector<uint32_t> &indices) {
+  MeshCache::SourceStamp stamp;
+  CHECK(MeshCache::statSource(kSourcePath, stamp));
+
+  std::atomic<int> failures{0};
+  std::vector<std::thread> writers;
+  for (int t = 0; t < 4; ++t) {
+    writers.emplace_back([&] {
+      for (int i = 0; i < 25; ++i) {
+        try {
+          MeshCache::write(kCachePath, stamp, vertices, indices);
+        } catch (const std::runtime_error &) {
+          failures.fetch_add(1);
+        }
+      }
+    });
+  }
+  for (std::thread &writer : writers)
+    writer.join();
+  CHECK(failures.load() == 0);
+  CHECK(cacheHolds(vertices, indices));
+
+  // Only the cache itself remains of the form "<cache>*"
+  int leftovers = 0;
+  for (const auto &entry : std::filesystem::directory_iterator(".")) {
+    const std::string name = entry.path().filename().string();
+    if (name.starts_with(kCachePath) && name != kCachePath)
+      ++leftovers;
+  }
+  CHECK(leftovers == 0);
+}
+
+} // namespace
+
+int main() {
+  checkXxh64();
+
+  writeFile(kSourcePath, kQuadObj);
+  std::vector<Vertex> vertices;
+  std::vector<uint32_t> indices;
+  {
+    uint64_t parsedHash = 0, fileHash = 1;
+    meshimport::importObj(kSourcePath, vertices, indices, 1, &parsedHash);
+    CHECK(MeshCache::hashSource(kSourcePath, fileHash));
+    CHECK(parsedHash == fileHash);
+  }
+
+  // Round trip
+  buildCache(vertices, indices);
+  CHECK(vertices.size() == 4 && indices.size() == 6);
+  CHECK(cacheHolds(vertices, indices));
+
+  // Touched, content unchanged: accepted, and the refreshed stamp keeps it so
+  touch(kSourcePath, 10);
+  CHECK(cacheHolds(vertices, indices));
+  CHECK(cacheHolds(vertices, indices));
+
+  // Same size, different content and time: rejected
+  std::string edited = kQuadObj;
+  edited.replace(edited.find("v 1 1 0"), 7, "v 2 2 0");
+  writeFile(kSourcePath, edited);
+  touch(kSourcePath, 20);
+  CHECK(!MeshCache::open(kCachePath, kSourcePath));
+
+  // An index equal to the vertex count: rejected
+  buildCache(vertices, indices);
+  CHECK(cacheHolds(vertices, indices));
+  {
+    const uint32_t bad = static_cast<uint32_t>(vertices.size());
+    const auto lastIndex = std::filesystem::file_size(kCachePath) - sizeof(bad);
+    std::fstream cache(kCachePath, std::ios::binary | std::ios::in | std::ios::out);
+    cache.seekp(static_cast<std::streamoff>(lastIndex));
+    cache.write(reinterpret_cast<const char *>(&bad), sizeof(bad));
+  }
+  CHECK(!MeshCache::open(kCachePath, kSourcePath));
+
+  // Truncated: rejected
+  buildCache(vertices, indices);
+  std::filesystem::resize_file(kCachePath,
+                               std::filesystem::file_size(kCachePath) - 1);
+  CHECK(!MeshCache::open(kCachePath, kSourcePath));
+
+  // Concurrent writers
+  writeFile(kSourcePath, kQuadObj);
+  buildCache(vertices, indices);
+  checkConcurrentWrites(vertices, indices);
+
+  std::filesystem::remove(kSourcePath);
+  std::filesystem::remove(kCachePath);
+  return testcheck::result("MeshCacheTest");
+}
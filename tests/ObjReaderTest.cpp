@@ -0,0 +1,149 @@
+/**
+ * @file ObjReaderTest.cpp
+ * @brief importObj() on small hand-written OBJ files.
+ *
+ * Covers:
+ *  - negative (relative) position and texture indices;
+ *  - 'p', 'p/t', 'p//n' and 'p/t/n' corners, and a quad fan;
+ *  - CRLF line endings, and a last line without a newline;
+ *  - errors naming the line for out-of-range indices and malformed corners.
+ */
+
+#include "ObjReader.hpp"
+#include "TestCheck.hpp"
+
+#include <cstdio>    ///< std::remove for the temporary OBJ file
+#include <fstream>   ///< Writing the OBJ file
+#include <stdexcept> ///< std::runtime_error from importObj()
+#include <string>    ///< File contents and error messages
+#include <vector>    ///< Mesh arrays
+
+namespace {
+
+const char *const kObjPath = "ObjReaderTest.obj"; ///< Temporary file
+
+/** @brief Imported mesh. */
+struct Mesh {
+  std::vector<Vertex> vertices;
+  std::vector<uint32_t> indices;
+};
+
+/** @brief Three positions and three texture coordinates (V flipped on import). */
+const char *const kTriangleData = "v 0 0 0\n"
+                                  "v 1 0 0\n"
+                                  "v 1 1 0\n"
+                                  "vt 0 0\n"
+                                  "vt 1 0\n"
+                                  "vt 1 1\n"
+                                  "vn 0 0 1\n";
+
+/** @brief Writes 'text' to kObjPath and imports it. */
+Mesh importText(const std::string &text) {
+  {
+    std::ofstream obj(kObjPath, std::ios::binary | std::ios::trunc);
+    obj << text;
+  }
+  Mesh mesh;
+  meshimport::importObj(kObjPath, mesh.vertices, mesh.indices, 1);
+  return mesh;
+}
+
+/** @brief The error importText() throws, or "" if it succeeds. */
+std::string importError(const std::string &text) {
+  try {
+    importText(text);
+  } catch (const std::runtime_error &e) {
+    return e.what();
+  }
+  return "";
+}
+
+/** @brief The error names 'line' and contains 'what'. */
+bool failsAt(const std::string &text, int line, const std::string &what) {
+  const std::string error = importError(text);
+  return error.find(std::string(kObjPath) + ":" + std::to_string(line) + ": " +
+                    what) != std::string::npos;
+}
+
+/** @brief Vertex 'i' has this position and texture coordinate. */
+bool vertexIs(const Mesh &mesh, size_t i, glm::vec3 position,
+              glm::vec2 texCoord) {
+  return i < mesh.vertices.size() && mesh.vertices[i].position == position &&
+         mesh.vertices[i].texCoord == texCoord;
+}
+
+/** @brief The triangle of kTriangleData, textured 0, 1, 2. */
+bool isTexturedTriangle(const Mesh &mesh) {
+  return mesh.vertices.size() == 3 &&
+         mesh.indices == std::vector<uint32_t>{0, 1, 2} &&
+         vertexIs(mesh, 0, {0, 0, 0}, {0, 1}) &&
+         vertexIs(mesh, 1, {1, 0, 0}, {1, 1}) &&
+         vertexIs(mesh, 2, {1, 1, 0}, {1, 0});
+}
+
+/** @brief The triangle of kTriangleData without texture coordinates. */
+bool isPlainTriangle(const Mesh &mesh) {
+  return mesh.vertices.size() == 3 &&
+         mesh.indices == std::vector<uint32_t>{0, 1, 2} &&
+         vertexIs(mesh, 0, {0, 0, 0}, {0, 1}) &&
+         vertexIs(mesh, 1, {1, 0, 0}, {0, 1}) &&
+         vertexIs(mesh, 2, {1, 1, 0}, {0, 1});
+}
+
+} // namespace
+
+int main() {
+  const std::string data = kTriangleData;
+
+  // Corner forms
+  CHECK(isPlainTriangle(importText(data + "f 1 2 3\n")));
+  CHECK(isTexturedTriangle(importText(data + "f 1/1 2/2 3/3\n")));
+  CHECK(isPlainTriangle(importText(data + "f 1//1 2//1 3//1\n")));
+  CHECK(isTexturedTriangle(importText(data + "f 1/1/1 2/2/1 3/3/1\n")));
+
+  // Negative indices count back from the last element defined so far
+  CHECK(isTexturedTriangle(importText(data + "f -3/-3 -2/-2/-1 -1/-1\n")));
+  {
+    const Mesh mesh = importText(data + "f 1 2 3\n"
+                                        "v 2 2 0\n"
+                                        "f -4 -1 -2\n");
+    CHECK(mesh.indices == (std::vector<uint32_t>{0, 1, 2, 0, 3, 2}));
+    CHECK(vertexIs(mesh, 3, {2, 2, 0}, {0, 1}));
+  }
+
+  // A quad is fanned from its first corner
+  {
+    const Mesh mesh = importText(data + "v 0 1 0\nf 1 2 3 4\n");
+    CHECK(mesh.indices == (std::vector<uint32_t>{0, 1, 2, 0, 2, 3}));
+  }
+
+  // CRLF endings and a missing final newline
+  CHECK(isTexturedTriangle(importText(
+      "v 0 0 0\r\nv 1 0 0\r\nv 1 1 0\r\n"
+      "vt 0 0\r\nvt 1 0\r\nvt 1 1\r\n"
+      "f 1/1 2/2 3/3\r\n")));
+  CHECK(isTexturedTriangle(importText(data + "f 1/1 2/2 3/3")));
+  CHECK(isTexturedTriangle(importText(
+      "v 0 0 0\r\nv 1 0 0\r\nv 1 1 0\r\n"
+      "vt 0 0\r\nvt 1 0\r\nvt 1 1\r\n"
+      "f 1/1 2/2 3/3")));
+
+  // Errors name the line (kTriangleData has seven)
+  CHECK(importError(data + "f 1 2 3\n").empty());
+  CHECK(failsAt(data + "f 1 2 4\n", 8, "face index out of range"));
+  CHECK(failsAt(data + "f 0 1 2\n", 8, "face index out of range"));
+  CHECK(failsAt(data + "f 1 2 -4\n", 8, "face index out of range"));
+  CHECK(failsAt(data + "f 1 2 3\nf 1/4 2 3\n", 9, "face index out of range"));
+  CHECK(failsAt(data + "\r\nf 1 2 3\r\nf 1 2 9\r\n", 10,
+                "face index out of range"));
+  CHECK(failsAt(data + "f 1a 2 3\n", 8, "malformed face corner"));
+  CHECK(failsAt(data + "f 1/1/1/1 2 3\n", 8, "malformed face corner"));
+  CHECK(failsAt(data + "f 1/x 2 3\n", 8, "expected a face index"));
+  CHECK(failsAt(data + "f 1/ 2 3\n", 8, "expected a face index"));
+  CHECK(failsAt(data + "f 1// 2 3\n", 8, "expected a face index"));
+  CHECK(failsAt(data + "f 1 2\n", 8, "face with fewer than three corners"));
+  CHECK(failsAt(data + "v 1 x 0\n", 8, "expected a number"));
+
+  std::remove(kObjPath);
+  return testcheck::result("ObjReaderTest");
+}
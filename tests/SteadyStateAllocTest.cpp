@@ -0,0 +1,101 @@
+/**
+ * @file SteadyStateAllocTest.cpp
+ * @brief Checks that a warmed-up frame makes no heap allocation.
+ *
+ * Replays the profiling work the renderer's mainLoop() does around
+ * drawFrame() (nested zones, runtime-named zones, counters, gauges, GPU
+ * timeline submission and FramePacer timers) with allocation tracking on.
+ * After a few warm-up frames have filled the interned-name caches and sized
+ * the merge buffers, ChronoProfiler::frameAllocationCount() must stay 0 for
+ * every frame. A final frame that allocates on purpose proves that the hooks
+ * actually see allocations, so the check cannot pass vacuously.
+ */
+
+#include "ChronoProfiler.hpp"
+#include "FramePacer.hpp"
+#include "TestCheck.hpp"
+
+#include <array>  ///< Fixed-size stand-ins for GPU timestamps and uniforms
+#include <string> ///< Runtime zone name
+
+namespace {
+
+constexpr int kWarmupFrames = 8;   ///< Frames allowed to fill caches
+constexpr int kSteadyFrames = 500; ///< Frames that must not allocate
+
+/**
+ * @brief Stand-in for drawFrame(): only the profiler and pacing calls.
+ * @param pacer Frame pacing monitor of the loop
+ * @param passName Zone name only known at runtime
+ * @param frame Frame number, varies the recorded values
+ */
+void drawFrame(FramePacer &pacer, const std::string &passName, int frame) {
+  {
+    PROFILE_SCOPE("waitForFences");
+    FramePacer::ScopedTimer wait(pacer, FramePacer::Metric::FenceWait);
+  }
+
+  std::array<float, 16> uniforms{};
+  {
+    PROFILE_SCOPE("updateUniformBuffer");
+    uniforms.fill(static_cast<float>(frame));
+    ChronoProfiler::plot("ubo.time", uniforms[0]);
+  }
+
+  {
+    PROFILE_SCOPE("recordCommandBuffer");
+    ChronoProfiler::ScopedZone pass(passName);
+    ChronoProfiler::counter("vk.drawCalls");
+  }
+
+  // GPU timeline for the previous frame, as GpuProfiler submits it
+  std::array<ChronoProfiler::Event, 2> gpuEvents{};
+  for (ChronoProfiler::Event &evt : gpuEvents) {
+    evt.startTicks = ChronoProfiler::getFrameStartTicks();
+    evt.endTicks = evt.startTicks + 1;
+    evt.threadId = ChronoProfiler::kGpuThreadId;
+    evt.parentIndex = -1;
+  }
+  ChronoProfiler::submitEvents(gpuEvents);
+}
+
+} // namespace
+
+int main() {
+  ChronoProfiler::init();
+  ChronoProfiler::setCapturePolicy(ChronoProfiler::CapturePolicy::continuous());
+  ChronoProfiler::setAllocationTracking(true);
+
+  FramePacer pacer;
+  const std::string passName = "mainPass"; // Built before any zone opens
+  int allocatingFrames = 0;
+
+  for (int frame = 0; frame < kWarmupFrames + kSteadyFrames; ++frame) {
+    pacer.beginFrame();
+    {
+      ChronoProfiler::ScopedFrame scopedFrame;
+      PROFILE_SCOPE("drawFrame()");
+      drawFrame(pacer, passName, frame);
+    }
+    pacer.endFrame();
+
+    if (frame >= kWarmupFrames && ChronoProfiler::frameAllocationCount() != 0)
+      ++allocatingFrames;
+  }
+  CHECK(allocatingFrames == 0);
+
+  // Negative control: one allocation inside a zone is reported. The pointer
+  // escapes through a volatile so the compiler cannot elide the new/delete.
+  static int *volatile escaped = nullptr;
+  {
+    ChronoProfiler::ScopedFrame scopedFrame;
+    PROFILE_SCOPE("drawFrame()");
+    drawFrame(pacer, passName, 0);
+    escaped = new int(42);
+  }
+  delete escaped;
+  CHECK(ChronoProfiler::frameAllocationCount() == 1);
+
+  ChronoProfiler::setAllocationTracking(false);
+  return testcheck::result("SteadyStateAllocTest");
+}
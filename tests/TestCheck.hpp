@@ -0,0 +1,44 @@
+#pragma once
+
+/**
+ * @file TestCheck.hpp
+ * @brief Minimal assertion helpers shared by the programs in tests/.
+ *
+ * Every test is a standalone executable built and run by 'make test'.
+ * CHECK() reports a failed condition with its location and keeps going;
+ * main() returns testcheck::result(), which is non-zero if any check failed.
+ */
+
+#include <cstdio> // for std::fprintf
+
+namespace testcheck {
+
+/** @brief Number of failed checks so far. */
+inline int failures = 0;
+
+/** @brief Records one check; use through CHECK(). */
+inline void check(bool ok, const char *expr, const char *file, int line) {
+  if (!ok) {
+    ++failures;
+    std::fprintf(stderr, "%s:%d: CHECK failed: %s\n", file, line, expr);
+  }
+}
+
+/**
+ * @brief Prints the verdict.
+ * @param name Test name for the summary line
+ * @return Process exit status: 0 if every check passed
+ */
+inline int result(const char *name) {
+  if (failures == 0)
+    std::printf("%s: passed\n", name);
+  else
+    std::printf("%s: %d check(s) failed\n", name, failures);
+  return failures == 0 ? 0 : 1;
+}
+
+} // namespace testcheck
+
+/** @brief Checks a condition, reporting it with file and line if false. */
+#define CHECK(expr)                                                            \
+  testcheck::check(static_cast<bool>(expr), #expr, __FILE__, __LINE__)
@@ -0,0 +1,107 @@
+/**
+ * @file ThreadChurnTest.cpp
+ * @brief Stress test: thousands of short-lived threads while frames run.
+ *
+ * More threads than ChronoProfiler::kMaxNamedThreads start in waves, name
+ * themselves, record a few zones and exit, while the main thread ends
+ * frames continuously. Checks that:
+ *  - every zone reaches a merged frame, including those of threads that
+ *    exited before the frame ended;
+ *  - retired rings are recycled, so the registry never holds more rings than
+ *    threads alive at once;
+ *  - dense IDs are reused with the rings, so every thread, including one
+ *    started after the churn, can still be named.
+ */
+
+#include "ChronoProfiler.hpp"
+#include "TestCheck.hpp"
+
+#include <algorithm> ///< std::max
+#include <atomic>    ///< Flags shared with the spawner and workers
+#include <thread>    ///< Worker threads
+#include <vector>    ///< One wave of workers
+
+namespace {
+
+constexpr int kWaves = 525;          ///< 4200 threads in total
+constexpr int kWaveThreads = 8;      ///< Threads alive at once
+constexpr int kZonesPerThread = 20;  ///< Zones recorded by each thread
+
+static_assert(kWaves * kWaveThreads > ChronoProfiler::kMaxNamedThreads,
+              "The churn must outlast the named-thread limit");
+
+} // namespace
+
+int main() {
+  ChronoProfiler::setCapturePolicy(ChronoProfiler::CapturePolicy::continuous());
+  ChronoProfiler::setThreadName("Main");
+
+  std::atomic<uint64_t> framesEnded{0};
+  std::atomic<int> misnamedWorkers{0};
+  std::atomic<bool> done{false};
+
+  std::thread spawner([&] {
+    for (int wave = 0; wave < kWaves; ++wave) {
+      std::vector<std::thread> workers;
+      for (int i = 0; i < kWaveThreads; ++i) {
+        workers.emplace_back([&] {
+          ChronoProfiler::setThreadName("Worker");
+          const uint32_t id = ChronoProfiler::currentThreadId();
+          if (ChronoProfiler::getThreadName(id) != "Worker")
+            misnamedWorkers.fetch_add(1, std::memory_order_relaxed);
+          for (int k = 0; k < kZonesPerThread; ++k) {
+            PROFILE_SCOPE("churn.zone");
+          }
+        });
+      }
+      for (std::thread &worker : workers)
+        worker.join();
+
+      // Wait for one whole frame after the exits, so their rings are recycled
+      const uint64_t target = framesEnded.load(std::memory_order_acquire) + 2;
+      while (framesEnded.load(std::memory_order_acquire) < target)
+        std::this_thread::yield();
+    }
+    done.store(true, std::memory_order_release);
+  });
+
+  size_t zones = 0;
+  uint32_t maxThreadId = 0;
+  size_t maxRegistered = 0;
+  auto runFrame = [&] {
+    ChronoProfiler::beginFrame();
+    ChronoProfiler::endFrame();
+    for (const ChronoProfiler::Event &evt : ChronoProfiler::getEvents()) {
+      if (evt.isValue())
+        continue;
+      if (ChronoProfiler::getString(evt.nameId) == "churn.zone")
+        ++zones;
+      maxThreadId = std::max(maxThreadId, evt.threadId);
+    }
+    maxRegistered =
+        std::max(maxRegistered, ChronoProfiler::getOverflowCounts().size());
+    framesEnded.fetch_add(1, std::memory_order_release);
+  };
+
+  while (!done.load(std::memory_order_acquire))
+    runFrame();
+  spawner.join();
+  runFrame();
+
+  CHECK(zones == size_t{kWaves} * kWaveThreads * kZonesPerThread);
+  CHECK(misnamedWorkers.load() == 0);
+  CHECK(maxRegistered <= kWaveThreads + 1); // Workers plus the main thread
+  CHECK(maxThreadId <= kWaveThreads);       // IDs 0 .. kWaveThreads, reused
+
+  // A thread started after the churn still gets a nameable ID
+  uint32_t lateId = ChronoProfiler::kExitedThreadId;
+  std::thread([&] {
+    ChronoProfiler::setThreadName("Late");
+    lateId = ChronoProfiler::currentThreadId();
+  }).join();
+  CHECK(lateId < ChronoProfiler::kMaxNamedThreads);
+  CHECK(ChronoProfiler::getThreadName(lateId) == "Late");
+  CHECK(ChronoProfiler::getThreadName(0) == "Main");
+
+  return testcheck::result("ThreadChurnTest");
+}
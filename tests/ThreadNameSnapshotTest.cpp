@@ -0,0 +1,75 @@
+/**
+ * @file ThreadNameSnapshotTest.cpp
+ * @brief Frames keep the thread names they were recorded with.
+ *
+ * Thread "Alpha" records a zone in frame 0 and exits; "Beta" starts after
+ * that frame, takes over the recycled ID and records a zone in frame 1.
+ * Checks that:
+ *  - a copy of getThreadNames() taken after frame 0 still names the ID
+ *    "Alpha" once Beta has renamed it;
+ *  - the binary trace written in the background names the ID "Alpha" in
+ *    frame 0 and "Beta" in frame 1, whenever the writer got to each frame.
+ */
+
+#include "ChronoCapture.hpp"
+#include "ChronoProfiler.hpp"
+#include "TestCheck.hpp"
+
+#include <filesystem> ///< Removing the trace
+#include <string>     ///< Thread names
+#include <thread>     ///< Alpha and Beta
+#include <vector>     ///< Copy of frame 0's names
+
+namespace {
+
+const char *const kTracePath = "ThreadNameSnapshotTest.chrono"; ///< Temporary trace
+
+/** @brief Runs a thread that names itself, records one zone and exits. */
+uint32_t recordOn(const std::string &name) {
+  uint32_t threadId = ChronoProfiler::kExitedThreadId;
+  std::thread([&] {
+    ChronoProfiler::setThreadName(name);
+    threadId = ChronoProfiler::currentThreadId();
+    PROFILE_SCOPE("snapshot.zone");
+  }).join();
+  return threadId;
+}
+
+} // namespace
+
+int main() {
+  ChronoProfiler::setCapturePolicy(ChronoProfiler::CapturePolicy::continuous());
+  CHECK(ChronoProfiler::beginTrace(kTracePath));
+
+  ChronoProfiler::beginFrame();
+  const uint32_t alphaId = recordOn("Alpha");
+  ChronoProfiler::endFrame(); // Drains Alpha's ring and recycles it
+  const std::vector<ChronoProfiler::ThreadName> frame0Names(
+      ChronoProfiler::getThreadNames().begin(),
+      ChronoProfiler::getThreadNames().end());
+
+  ChronoProfiler::beginFrame();
+  const uint32_t betaId = recordOn("Beta");
+  ChronoProfiler::endFrame();
+
+  CHECK(betaId == alphaId); // The recycled ring comes with its ID
+  CHECK(ChronoProfiler::findThreadName(frame0Names, alphaId) == "Alpha");
+  CHECK(ChronoProfiler::findThreadName(ChronoProfiler::getThreadNames(),
+                                       betaId) == "Beta");
+  CHECK(ChronoProfiler::findThreadName(frame0Names, alphaId + 1000) ==
+        "<unnamed>");
+
+  ChronoProfiler::endTrace();
+  {
+    chronocap::MappedFile file(kTracePath);
+    chronocap::CaptureReader reader(file.bytes());
+    chronocap::Frame frame;
+    CHECK(reader.readFrame(0, frame));
+    CHECK(reader.getThreadName(alphaId) == "Alpha");
+    CHECK(reader.readFrame(1, frame));
+    CHECK(reader.getThreadName(betaId) == "Beta");
+  }
+
+  std::filesystem::remove(kTracePath);
+  return testcheck::result("ThreadNameSnapshotTest");
+}
@@ -0,0 +1,125 @@
+/**
+ * @file VertexHashTest.cpp
+ * @brief vertexEqual() and vertexHash64() match their scalar references.
+ *
+ * 'make test' builds this file twice: as VertexHashTest with the default
+ * flags (SSE2 path) and as VertexHashTestAvx with -mavx (256-bit path), so
+ * both x86 paths are compared against vertexhash_detail::scalarEqual() and
+ * scalarHash64() on:
+ *  - every pair of vertices that differ from a base vertex in one float,
+ *    set to a special value (+-0, denormals, +-inf, quiet/signalling NaN
+ *    with either sign, extremes);
+ *  - random bit patterns, which include random NaNs and denormals.
+ * vertexEqual() must also agree with Vertex::operator==, and vertices that
+ * compare equal must hash equally.
+ */
+
+#include "TestCheck.hpp"
+#include "VertexHash.hpp"
+
+#include <bit>    ///< std::bit_cast for NaN payloads
+#include <cstdio> ///< std::printf when the CPU cannot run the test
+#include <limits> ///< Special float values
+#include <random> ///< Random bit patterns
+#include <vector> ///< Test vertices
+
+namespace {
+
+/** @brief Float values whose comparison or bits need care. */
+const float kSpecialValues[] = {
+    0.0f,
+    -0.0f,
+    1.0f,
+    -1.0f,
+    std::numeric_limits<float>::denorm_min(),
+    -std::numeric_limits<float>::denorm_min(),
+    std::bit_cast<float>(0x007FFFFFu), // Largest denormal
+    std::numeric_limits<float>::min(),
+    std::numeric_limits<float>::max(),
+    std::numeric_limits<float>::infinity(),
+    -std::numeric_limits<float>::infinity(),
+    std::numeric_limits<float>::quiet_NaN(),
+    -std::numeric_limits<float>::quiet_NaN(),
+    std::numeric_limits<float>::signaling_NaN(),
+    std::bit_cast<float>(0x7FC12345u), // NaN with a payload
+};
+
+/** @brief Vertex whose eight floats are all 'fill'. */
+Vertex uniformVertex(float fill) {
+  Vertex vertex;
+  auto *floats = reinterpret_cast<float *>(&vertex);
+  for (int i = 0; i < 8; ++i)
+    floats[i] = fill;
+  return vertex;
+}
+
+/** @brief Checks one pair against the references. */
+void checkPair(const Vertex &a, const Vertex &b) {
+  const bool equal = vertexhash_detail::scalarEqual(a, b);
+  CHECK(vertexEqual(a, b) == equal);
+  CHECK((a == b) == equal);
+  if (equal)
+    CHECK(vertexHash64(a) == vertexHash64(b));
+}
+
+/** @brief Checks one vertex's hash against the reference. */
+void checkHash(const Vertex &vertex) {
+  CHECK(vertexHash64(vertex) == vertexhash_detail::scalarHash64(vertex));
+  CHECK(std::hash<Vertex>{}(vertex) ==
+        static_cast<size_t>(vertexhash_detail::scalarHash64(vertex)));
+}
+
+} // namespace
+
+int main() {
+#if defined(__AVX__)
+  if (!__builtin_cpu_supports("avx")) {
+    std::printf("VertexHashTest: skipped, the CPU has no AVX\n");
+    return 0;
+  }
+#endif
+
+  // XXH64 of 32 zero bytes with seed 0 (the all-+0.0f vertex)
+  CHECK(vertexHash64(uniformVertex(0.0f)) == 0xF6E9BE5D70632CF5ull);
+  CHECK(vertexHash64(uniformVertex(-0.0f)) == 0xF6E9BE5D70632CF5ull);
+
+  // One float of a base vertex replaced by each special value, at each position
+  std::vector<Vertex> vertices;
+  const Vertex base = uniformVertex(0.5f);
+  vertices.push_back(base);
+  for (int position = 0; position < 8; ++position) {
+    for (float value : kSpecialValues) {
+      Vertex vertex = base;
+      reinterpret_cast<float *>(&vertex)[position] = value;
+      vertices.push_back(vertex);
+    }
+  }
+  for (float value : kSpecialValues)
+    vertices.push_back(uniformVertex(value));
+  const size_t specialCount = vertices.size();
+
+  // Random bit patterns: about 1 in 256 floats is a NaN or infinity and
+  // 1 in 256 a denormal or zero
+  std::mt19937 rng(5990);
+  for (int i = 0; i < 2000; ++i) {
+    Vertex vertex;
+    auto *bits = reinterpret_cast<uint32_t *>(&vertex);
+    for (int k = 0; k < 8; ++k)
+      bits[k] = static_cast<uint32_t>(rng());
+    vertices.push_back(vertex);
+  }
+
+  for (const Vertex &a : vertices) {
+    checkHash(a);
+    for (size_t j = 0; j < specialCount; ++j) // Special ones against everything
+      checkPair(a, vertices[j]);
+  }
+
+  return testcheck::result(
+#if defined(__AVX__)
+      "VertexHashTest (AVX)"
+#else
+      "VertexHashTest"
+#endif
+  );
+}
@@ -0,0 +1,368 @@
+/**
+ * @file ChronoConvert.cpp
+ * @brief 'chrono-convert': offline converter for binary '.chrono' captures.
+ *
+ * Usage:
+ * @code
+ * chrono-convert <capture.chrono> json  [output]   # Chrome Trace Event JSON
+ * chrono-convert <capture.chrono> csv   [output]   # one row per zone or sample
+ * chrono-convert <capture.chrono> stats [output]   # per-zone and per-counter summary
+ * @endcode
+ *
+ * Output goes to stdout when no output path is given. Built with
+ * 'make chrono-convert'; it only depends on ChronoCapture and the standard
+ * library, so it runs on machines without Vulkan. The capture is memory-mapped
+ * and decoded one frame at a time, so memory use does not grow with its size.
+ */
+
+#include "ChronoCapture.hpp"
+
+#include <algorithm>     ///< std::sort for the stats table
+#include <charconv>      ///< std::to_chars for fixed-point numbers
+#include <cmath>         ///< std::isfinite for counter values
+#include <cstdio>        ///< std::FILE output
+#include <cstdlib>       ///< EXIT_SUCCESS / EXIT_FAILURE
+#include <iostream>      ///< Usage and error messages
+#include <stdexcept>     ///< std::runtime_error
+#include <string>        ///< Output buffers
+#include <unordered_map> ///< Per-zone aggregation, thread names written
+#include <vector>        ///< Per-event scratch
+
+namespace {
+
+/** @brief Flush the output buffer once it grows past this many bytes. */
+constexpr size_t kFlushBytes = 256 * 1024;
+
+/** @brief Append a value with a fixed number of decimals. */
+void appendFixed(std::string &out, double value, int decimals) {
+  char digits[32];
+  auto result = std::to_chars(digits, digits + sizeof(digits), value,
+                              std::chars_format::fixed, decimals);
+  out.append(digits, result.ptr);
+}
+
+/** @brief Append a counter or gauge value (non-finite values as 0). */
+void appendValue(std::string &out, double value) {
+  char digits[32];
+  auto result = std::to_chars(digits, digits + sizeof(digits),
+                              std::isfinite(value) ? value : 0.0);
+  out.append(digits, result.ptr);
+}
+
+/** @brief Write and clear 'out' once it is large (or always if 'force'). */
+void flush(std::FILE *file, std::string &out, bool force = false) {
+  if (force || out.size() >= kFlushBytes) {
+    std::fwrite(out.data(), 1, out.size(), file);
+    out.clear();
+  }
+}
+
+/**
+ * @brief Exclusive ticks of each event: inclusive minus direct children.
+ *
+ * Counter and gauge samples have no duration and get 0.
+ */
+void computeSelfTicks(const std::vector<ChronoProfiler::Event> &events,
+                      std::vector<uint64_t> &selfTicks) {
+  selfTicks.resize(events.size());
+  for (size_t i = 0; i < events.size(); ++i)
+    selfTicks[i] =
+        events[i].isValue() ? 0 : events[i].endTicks - events[i].startTicks;
+  for (const auto &evt : events) {
+    if (evt.parentIndex >= 0) {
+      uint64_t &parent = selfTicks[evt.parentIndex];
+      const uint64_t child = evt.endTicks - evt.startTicks;
+      parent = parent > child ? parent - child : 0;
+    }
+  }
+}
+
+// ---------- //
+// Converters //
+// ---------- //
+
+/**
+ * @brief Chrome Trace Event JSON, matching ChronoTraceWriter's JSON mode.
+ *
+ * Like the writer, a thread's 'thread_name' record is repeated whenever the
+ * name behind its ID changes (a renamed thread, or an exited thread's ID
+ * reused by a new one), so each zone is labelled with its own thread.
+ */
+void writeJson(chronocap::CaptureReader &reader, std::FILE *file) {
+  std::string out = "{\"traceEvents\":[\n";
+  std::unordered_map<uint32_t, std::string> writtenNames; ///< Last per thread ID
+  bool first = true;
+
+  chronocap::Frame frame;
+  while (reader.nextFrame(frame)) {
+    for (const auto &evt : frame.events) {
+      if (evt.isValue()) {
+        out += first ? "" : ",\n";
+        first = false;
+        out += "{\"name\":";
+        chronocap::appendJsonString(out, reader.getString(evt.nameId));
+        out += ",\"ph\":\"C\",\"ts\":";
+        appendFixed(out,
+                    reader.ticksToMs(static_cast<int64_t>(
+                        evt.startTicks - reader.getOriginTicks())) * 1000.0,
+                    3);
+        out += ",\"pid\":1,\"args\":{\"value\":";
+        appendValue(out, evt.value());
+        out += "}}";
+        flush(file, out);
+        continue;
+      }
+
+      const std::string_view threadName = reader.getThreadName(evt.threadId);
+      const auto [written, inserted] =
+          writtenNames.try_emplace(evt.threadId, threadName);
+      if (inserted || written->second != threadName) {
+        written->second = threadName;
+        out += first ? "" : ",\n";
+        first = false;
+        out += "{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":1,\"tid\":";
+        out += std::to_string(evt.threadId);
+        out += ",\"args\":{\"name\":";
+        chronocap::appendJsonString(out, threadName);
+        out += "}}";
+      }
+
+      out += first ? "" : ",\n";
+      first = false;
+      out += "{\"name\":";
+      chronocap::appendJsonString(out, reader.getString(evt.nameId));
+      if (evt.categoryId != 0) {
+        out += ",\"cat\":";
+        chronocap::appendJsonString(out, reader.getString(evt.categoryId));
+      }
+      out += ",\"ph\":\"X\",\"ts\":";
+      appendFixed(out,
+                  reader.ticksToMs(static_cast<int64_t>(
+                      evt.startTicks - reader.getOriginTicks())) * 1000.0,
+                  3);
+      out += ",\"dur\":";
+      appendFixed(out,
+                  reader.ticksToMs(static_cast<int64_t>(evt.endTicks -
+                                                        evt.startTicks)) *
+                      1000.0,
+                  3);
+      out += ",\"pid\":1,\"tid\":";
+      out += std::to_string(evt.threadId);
+      out += "}";
+      flush(file, out);
+    }
+  }
+
+  out += "\n],\"displayTimeUnit\":\"ms\"}\n";
+  flush(file, out, true);
+}
+
+/**
+ * @brief One CSV row per zone or sample, times in milliseconds from the trace
+ * origin. 'value' is empty for zones; duration columns are 0 for samples.
+ */
+void writeCsv(chronocap::CaptureReader &reader, std::FILE *file) {
+  std::string out = "frame,thread,name,category,depth,parent,startMs,"
+                    "durationMs,selfMs,value\n";
+  std::vector<uint64_t> selfTicks;
+
+  auto appendField = [&out](std::string_view text) {
+    if (text.find_first_of(",\"\n") == std::string_view::npos) {
+      out += text;
+      return;
+    }
+    out += '"';
+    for (char c : text) {
+      if (c == '"')
+        out += '"';
+      out += c;
+    }
+    out += '"';
+  };
+
+  chronocap::Frame frame;
+  while (reader.nextFrame(frame)) {
+    computeSelfTicks(frame.events, selfTicks);
+    for (size_t i = 0; i < frame.events.size(); ++i) {
+      const auto &evt = frame.events[i];
+      out += std::to_string(frame.index);
+      out += ',';
+      appendField(reader.getThreadName(evt.threadId));
+      out += ',';
+      appendField(reader.getString(evt.nameId));
+      out += ',';
+      appendField(reader.getString(evt.categoryId));
+      out += ',';
+      out += std::to_string(evt.depth);
+      out += ',';
+      out += std::to_string(evt.parentIndex);
+      out += ',';
+      appendFixed(out,
+                  reader.ticksToMs(static_cast<int64_t>(
+                      evt.startTicks - reader.getOriginTicks())),
+                  4);
+      out += ',';
+      appendFixed(out,
+                  evt.isValue() ? 0.0
+                                : reader.ticksToMs(static_cast<int64_t>(
+                                      evt.endTicks - evt.startTicks)),
+                  4);
+      out += ',';
+      appendFixed(out, reader.ticksToMs(static_cast<int64_t>(selfTicks[i])),
+                  4);
+      out += ',';
+      if (evt.isValue())
+        appendValue(out, evt.value());
+      out += '\n';
+      flush(file, out);
+    }
+  }
+  flush(file, out, true);
+}
+
+/**
+ * @brief Capture totals, a per-zone table sorted by total time, then a
+ * per-counter table of sample statistics.
+ */
+void writeStats(chronocap::CaptureReader &reader, std::FILE *file,
+                size_t captureBytes) {
+  struct ZoneTotals {
+    uint64_t count = 0;
+    double totalMs = 0.0;
+    double selfMs = 0.0;
+    double maxMs = 0.0;
+  };
+
+  struct ValueTotals {
+    uint64_t samples = 0;
+    double sum = 0.0;
+    double min = 0.0;
+    double max = 0.0;
+  };
+
+  std::unordered_map<uint16_t, ZoneTotals> zones;
+  std::unordered_map<uint16_t, ValueTotals> values;
+  std::vector<uint64_t> selfTicks;
+  uint64_t frames = 0;
+  uint64_t events = 0;
+  uint64_t missingFrames = 0;
+  uint64_t expectedIndex = 0;
+
+  chronocap::Frame frame;
+  while (reader.nextFrame(frame)) {
+    missingFrames += frame.index - expectedIndex;
+    expectedIndex = frame.index + 1;
+    ++frames;
+    events += frame.events.size();
+
+    computeSelfTicks(frame.events, selfTicks);
+    for (size_t i = 0; i < frame.events.size(); ++i) {
+      const auto &evt = frame.events[i];
+      if (evt.isValue()) {
+        ValueTotals &totals = values[evt.nameId];
+        const double value = evt.value();
+        totals.min = totals.samples ? std::min(totals.min, value) : value;
+        totals.max = totals.samples ? std::max(totals.max, value) : value;
+        totals.samples++;
+        totals.sum += value;
+        continue;
+      }
+      const double ms = reader.ticksToMs(
+          static_cast<int64_t>(evt.endTicks - evt.startTicks));
+      ZoneTotals &zone = zones[evt.nameId];
+      zone.count++;
+      zone.totalMs += ms;
+      zone.selfMs += reader.ticksToMs(static_cast<int64_t>(selfTicks[i]));
+      zone.maxMs = std::max(zone.maxMs, ms);
+    }
+  }
+
+  std::vector<std::pair<uint16_t, ZoneTotals>> sorted(zones.begin(),
+                                                      zones.end());
+  std::sort(sorted.begin(), sorted.end(), [](const auto &a, const auto &b) {
+    return a.second.totalMs > b.second.totalMs;
+  });
+
+  std::fprintf(file, "Frames:        %llu (%llu dropped)\n",
+               static_cast<unsigned long long>(frames),
+               static_cast<unsigned long long>(missingFrames));
+  std::fprintf(file, "Events:        %llu\n",
+               static_cast<unsigned long long>(events));
+  std::fprintf(file, "Capture size:  %zu bytes (%.1f bytes/event)\n",
+               captureBytes,
+               events ? static_cast<double>(captureBytes) / events : 0.0);
+  std::fprintf(file, "Clock:         %s\n\n",
+               reader.usesTsc() ? "TSC" : "steady_clock");
+
+  std::fprintf(file, "%-24s %10s %12s %10s %10s %10s\n", "Zone", "Count",
+               "Total(ms)", "Avg(ms)", "Self(ms)", "Max(ms)");
+  for (const auto &[nameId, zone] : sorted) {
+    const std::string name(reader.getString(nameId));
+    std::fprintf(file, "%-24s %10llu %12.3f %10.4f %10.4f %10.4f\n",
+                 name.c_str(), static_cast<unsigned long long>(zone.count),
+                 zone.totalMs, zone.totalMs / zone.count,
+                 zone.selfMs / zone.count, zone.maxMs);
+  }
+
+  if (values.empty())
+    return;
+
+  std::vector<std::pair<uint16_t, ValueTotals>> counters(values.begin(),
+                                                         values.end());
+  std::sort(counters.begin(), counters.end(), [&reader](const auto &a, const auto &b) {
+    return reader.getString(a.first) < reader.getString(b.first);
+  });
+
+  std::fprintf(file, "\n%-24s %10s %14s %14s %14s\n", "Counter", "Samples",
+               "Avg", "Min", "Max");
+  for (const auto &[nameId, totals] : counters) {
+    const std::string name(reader.getString(nameId));
+    std::fprintf(file, "%-24s %10llu %14.2f %14.2f %14.2f\n", name.c_str(),
+                 static_cast<unsigned long long>(totals.samples),
+                 totals.sum / totals.samples, totals.min, totals.max);
+  }
+}
+
+} // namespace
+
+/**
+ * @brief Entry point for chrono-convert.
+ * @return EXIT_SUCCESS on success, EXIT_FAILURE on bad usage or input.
+ */
+int main(int argc, char **argv) {
+  if (argc < 3 || argc > 4) {
+    std::cerr << "Usage: " << argv[0]
+              << " <capture.chrono> <json|csv|stats> [output]" << std::endl;
+    return EXIT_FAILURE;
+  }
+
+  const std::string mode = argv[2];
+  if (mode != "json" && mode != "csv" && mode != "stats") {
+    std::cerr << "Unknown output format: " << mode << std::endl;
+    return EXIT_FAILURE;
+  }
+
+  try {
+    const chronocap::MappedFile capture(argv[1]);
+    chronocap::CaptureReader reader(capture.bytes());
+
+    std::FILE *file = argc == 4 ? std::fopen(argv[3], "wb") : stdout;
+    if (!file)
+      throw std::runtime_error(std::string("Failed to open file: ") + argv[3]);
+
+    if (mode == "json")
+      writeJson(reader, file);
+    else if (mode == "csv")
+      writeCsv(reader, file);
+    else
+      writeStats(reader, file, capture.bytes().size());
+
+    if (file != stdout)
+      std::fclose(file);
+  } catch (const std::exception &e) {
+    std::cerr << e.what() << std::endl;
+    return EXIT_FAILURE;
+  }
+
+  return EXIT_SUCCESS;
+}